@@ -1,4 +1,5 @@
 #include "info_command.h"
+#include "util/arr.h"
 
 // Type of field returned in INFO
 typedef enum {
@@ -26,6 +27,8 @@ static InfoFieldSpec toplevelSpecs_g[] = {
     {.name = "doc_table_size_mb", .type = InfoField_DoubleSum},
     {.name = "sortable_values_size_mb", .type = InfoField_DoubleSum},
     {.name = "key_table_size_mb", .type = InfoField_DoubleSum},
+    {.name = "terms_snapshot_size_mb", .type = InfoField_DoubleSum},
+    {.name = "suffix_array_size_mb", .type = InfoField_DoubleSum},
     {.name = "records_per_doc_avg", .type = InfoField_DoubleAverage},
     {.name = "bytes_per_record_avg", .type = InfoField_DoubleAverage},
     {.name = "offsets_per_term_avg", .type = InfoField_DoubleAverage},
@@ -47,9 +50,17 @@ static InfoFieldSpec cursorSpecs[] = {
     {.name = "index_total", .type = InfoField_WholeSum},
 };
 
+// Per vector field, summed over the shards. bytes_per_vector_avg is derived from the sums
+static InfoFieldSpec vectorIndexSpecs[] = {
+    {.name = "num_vectors", .type = InfoField_WholeSum},
+    {.name = "memory_sz_mb", .type = InfoField_DoubleSum},
+    {.name = "max_level", .type = InfoField_Max},
+};
+
 #define NUM_FIELDS_SPEC (sizeof(toplevelSpecs_g) / sizeof(InfoFieldSpec))
 #define NUM_GC_FIELDS_SPEC (sizeof(gcSpecs) / sizeof(InfoFieldSpec))
 #define NUM_CURSOR_FIELDS_SPEC (sizeof(cursorSpecs) / sizeof(InfoFieldSpec))
+#define NUM_VECTOR_INDEX_FIELDS_SPEC (sizeof(vectorIndexSpecs) / sizeof(InfoFieldSpec))
 
 // Variant value type
 typedef struct {
@@ -64,6 +75,14 @@ typedef struct {
   } u;
 } InfoValue;
 
+// The vector index stats of a single vector field
+typedef struct {
+  const char *attribute;
+  size_t attributeLen;
+  MRReply *algorithm;
+  InfoValue values[NUM_VECTOR_INDEX_FIELDS_SPEC];
+} VectorIndexInfo;
+
 // State object for parsing and replying INFO
 typedef struct {
   const char *indexName;
@@ -75,6 +94,8 @@ typedef struct {
   InfoValue toplevelValues[NUM_FIELDS_SPEC];
   InfoValue gcValues[NUM_GC_FIELDS_SPEC];
   InfoValue cursorValues[NUM_CURSOR_FIELDS_SPEC];
+  int hasVectorIndexStats;
+  VectorIndexInfo *vectorIndexes;  // array
 } InfoFields;
 
 /**
@@ -119,6 +140,54 @@ static void convertField(InfoValue *dst, MRReply *src, const InfoFieldSpec *spec
   dst->isSet = 1;
 }
 
+// Returns the value of a key in a KV array, or NULL
+static MRReply *kvArrayValue(MRReply *array, const char *key) {
+  if (MRReply_Type(array) != MR_REPLY_ARRAY) {
+    return NULL;
+  }
+  for (size_t ii = 0; ii + 1 < MRReply_Length(array); ii += 2) {
+    if (MRReply_StringEquals(MRReply_ArrayElement(array, ii), key, 1)) {
+      return MRReply_ArrayElement(array, ii + 1);
+    }
+  }
+  return NULL;
+}
+
+// Merge the vector_index_stats of a shard, a KV array for every vector field
+static void processVectorIndexStats(InfoFields *fields, MRReply *array) {
+  if (MRReply_Type(array) != MR_REPLY_ARRAY) {
+    return;
+  }
+  fields->hasVectorIndexStats = 1;
+  for (size_t ii = 0; ii < MRReply_Length(array); ++ii) {
+    MRReply *stats = MRReply_ArrayElement(array, ii);
+    MRReply *attribute = kvArrayValue(stats, "attribute");
+    if (!attribute) {
+      continue;
+    }
+    size_t len;
+    const char *name = MRReply_String(attribute, &len);
+
+    VectorIndexInfo *info = NULL;
+    for (size_t jj = 0; jj < array_len(fields->vectorIndexes); ++jj) {
+      VectorIndexInfo *cur = fields->vectorIndexes + jj;
+      if (cur->attributeLen == len && !strncmp(cur->attribute, name, len)) {
+        info = cur;
+        break;
+      }
+    }
+    if (!info) {
+      VectorIndexInfo newInfo = {.attribute = name, .attributeLen = len};
+      fields->vectorIndexes = array_ensure_append(fields->vectorIndexes, &newInfo, 1, VectorIndexInfo);
+      info = &array_tail(fields->vectorIndexes);
+    }
+    if (!info->algorithm) {
+      info->algorithm = kvArrayValue(stats, "algorithm");
+    }
+    processKvArray(fields, stats, info->values, vectorIndexSpecs, NUM_VECTOR_INDEX_FIELDS_SPEC, 1);
+  }
+}
+
 // Handle fields which aren't InfoValue types
 static void handleSpecialField(InfoFields *fields, const char *name, MRReply *value) {
   if (!strcmp(name, "index_name")) {
@@ -147,6 +216,9 @@ static void handleSpecialField(InfoFields *fields, const char *name, MRReply *va
 
   } else if (!strcmp(name, "cursor_stats")) {
     processKvArray(fields, value, fields->cursorValues, cursorSpecs, NUM_CURSOR_FIELDS_SPEC, 1);
+
+  } else if (!strcmp(name, "vector_index_stats")) {
+    processVectorIndexStats(fields, value);
   }
 }
 
@@ -182,6 +254,7 @@ static void processKvArray(InfoFields *ctx, MRReply *array, InfoValue *dsts, Inf
 
 static void cleanInfoReply(InfoFields *fields) {
   rm_free(fields->errorIndexes);
+  array_free(fields->vectorIndexes);
 }
 
 static size_t replyKvArray(InfoFields *fields, RedisModuleCtx *ctx, InfoValue *values,
@@ -214,6 +287,31 @@ static size_t replyKvArray(InfoFields *fields, RedisModuleCtx *ctx, InfoValue *v
   return n;
 }
 
+static void replyVectorIndexStats(InfoFields *fields, RedisModuleCtx *ctx) {
+  RedisModule_ReplyWithSimpleString(ctx, "vector_index_stats");
+  RedisModule_ReplyWithArray(ctx, array_len(fields->vectorIndexes));
+  for (size_t ii = 0; ii < array_len(fields->vectorIndexes); ++ii) {
+    VectorIndexInfo *info = fields->vectorIndexes + ii;
+    RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
+    size_t n = 2;
+    RedisModule_ReplyWithSimpleString(ctx, "attribute");
+    RedisModule_ReplyWithStringBuffer(ctx, info->attribute, info->attributeLen);
+    if (info->algorithm) {
+      RedisModule_ReplyWithSimpleString(ctx, "algorithm");
+      MR_ReplyWithMRReply(ctx, info->algorithm);
+      n += 2;
+    }
+    n += replyKvArray(fields, ctx, info->values, vectorIndexSpecs, NUM_VECTOR_INDEX_FIELDS_SPEC);
+    // Derived from the totals, averaging the shards' averages would weigh them equally
+    size_t numVectors = info->values[0].u.total_l;
+    double memory = info->values[1].u.total_d * 0x100000;
+    RedisModule_ReplyWithSimpleString(ctx, "bytes_per_vector_avg");
+    RedisModule_ReplyWithDouble(ctx, numVectors ? memory / numVectors : 0);
+    n += 2;
+    RedisModule_ReplySetArrayLength(ctx, n);
+  }
+}
+
 static void generateFieldsReply(InfoFields *fields, RedisModuleCtx *ctx) {
   RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
   size_t n = 0;
@@ -254,6 +352,11 @@ static void generateFieldsReply(InfoFields *fields, RedisModuleCtx *ctx) {
   RedisModule_ReplySetArrayLength(ctx, nCursorStats);
   n += 2;
 
+  if (fields->hasVectorIndexStats) {
+    replyVectorIndexStats(fields, ctx);
+    n += 2;
+  }
+
   n += replyKvArray(fields, ctx, fields->toplevelValues, toplevelSpecs_g, NUM_FIELDS_SPEC);
   RedisModule_ReplySetArrayLength(ctx, n);
 }
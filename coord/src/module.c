@@ -627,7 +627,9 @@ searchRequestCtx *rscParseRequest(RedisModuleString **argv, int argc, QueryError
 
   if(dialect >= 2) {
     // Note: currently there is only one single case. For extending those cases we should use a trie here.
-    if(strcasestr(req->queryString, "KNN")) {
+    // With FUSE the shards rank their results by the fused score, and the default merge by score
+    // keeps that ranking. The KNN case would re-rank them by distance and cut them to K.
+    if(strcasestr(req->queryString, "KNN") && !RMUtil_ArgExists("FUSE", argv, argc, argvOffset)) {
       prepareOptionalTopKCase(req, argv, argc, status);
       if (QueryError_HasError(status)) {
         searchRequestCtx_Free(req);
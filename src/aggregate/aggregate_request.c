@@ -373,6 +373,42 @@ static int parseQueryLegacyArgs(ArgsCursor *ac, RSSearchOptions *options, QueryE
   return ARG_HANDLED;
 }
 
+// FUSE {RRF|LINEAR} [WEIGHT {weight}] [WINDOW {window}]
+static int parseFusion(ArgsCursor *ac, FusionOptions *fusion, QueryError *status) {
+  if (AC_AdvanceIfMatch(ac, "RRF")) {
+    fusion->method = FusionMethod_RRF;
+  } else if (AC_AdvanceIfMatch(ac, "LINEAR")) {
+    fusion->method = FusionMethod_Linear;
+  } else {
+    QERR_MKBADARGS_FMT(status, "FUSE method must be RRF or LINEAR");
+    return REDISMODULE_ERR;
+  }
+  fusion->weight = FUSION_WEIGHT_DEFAULT;
+  fusion->window = 0;
+
+  int rv;
+  while (!AC_IsAtEnd(ac)) {
+    if (AC_AdvanceIfMatch(ac, "WEIGHT")) {
+      if ((rv = AC_GetDouble(ac, &fusion->weight, AC_F_GE0)) != AC_OK) {
+        QERR_MKBADARGS_AC(status, "WEIGHT", rv);
+        return REDISMODULE_ERR;
+      }
+      if (fusion->weight > 1) {
+        QERR_MKBADARGS_FMT(status, "FUSE WEIGHT must be between 0 and 1");
+        return REDISMODULE_ERR;
+      }
+    } else if (AC_AdvanceIfMatch(ac, "WINDOW")) {
+      if ((rv = AC_GetSize(ac, &fusion->window, AC_F_GE1)) != AC_OK) {
+        QERR_MKBADARGS_AC(status, "WINDOW", rv);
+        return REDISMODULE_ERR;
+      }
+    } else {
+      break;
+    }
+  }
+  return REDISMODULE_OK;
+}
+
 static int parseQueryArgs(ArgsCursor *ac, AREQ *req, RSSearchOptions *searchOpts,
                           AggregatePlan *plan, QueryError *status) {
   // Parse query-specific arguments..
@@ -441,6 +477,15 @@ static int parseQueryArgs(ArgsCursor *ac, AREQ *req, RSSearchOptions *searchOpts
       }
       req->reqflags |= QEXEC_F_SEND_HIGHLIGHT;
 
+    } else if (AC_AdvanceIfMatch(ac, "FUSE")) {
+      if(!ensureSimpleMode(req)) {
+        QERR_MKBADARGS_FMT(status, "FUSE is not supported on FT.AGGREGATE");
+        return REDISMODULE_ERR;
+      }
+      if (parseFusion(ac, &searchOpts->fusion, status) != REDISMODULE_OK) {
+        return REDISMODULE_ERR;
+      }
+
     } else if ((req->reqflags & QEXEC_F_IS_SEARCH) &&
                ((rv = parseQueryLegacyArgs(ac, searchOpts, status)) != ARG_UNKNOWN)) {
       if (rv == ARG_ERROR) {
@@ -797,19 +842,22 @@ error:
   return REDISMODULE_ERR;
 }
 
-static void applyGlobalFilters(RSSearchOptions *opts, QueryAST *ast, const RedisSearchCtx *sctx) {
+static int applyGlobalFilters(RSSearchOptions *opts, QueryAST *ast, const RedisSearchCtx *sctx,
+                              QueryError *status) {
   /** The following blocks will set filter options on the entire query */
   if (opts->legacy.filters) {
     for (size_t ii = 0; ii < array_len(opts->legacy.filters); ++ii) {
       QAST_GlobalFilterOptions legacyFilterOpts = {.numeric = opts->legacy.filters[ii]};
-      QAST_SetGlobalFilters(ast, &legacyFilterOpts);
+      QAST_SetGlobalFilters(ast, &legacyFilterOpts, status);
     }
     array_clear(opts->legacy.filters);  // so AREQ_Free() doesn't free the filters themselves, which
                                         // are now owned by the query object
   }
   if (opts->legacy.gf) {
     QAST_GlobalFilterOptions legacyOpts = {.geo = opts->legacy.gf};
-    QAST_SetGlobalFilters(ast, &legacyOpts);
+    if (QAST_SetGlobalFilters(ast, &legacyOpts, status) != REDISMODULE_OK) {
+      return REDISMODULE_ERR;
+    }
   }
 
   if (opts->inkeys) {
@@ -821,8 +869,9 @@ static void applyGlobalFilters(RSSearchOptions *opts, QueryAST *ast, const Redis
       }
     }
     QAST_GlobalFilterOptions filterOpts = {.ids = opts->inids, .nids = opts->nids};
-    QAST_SetGlobalFilters(ast, &filterOpts);
+    QAST_SetGlobalFilters(ast, &filterOpts, status);
   }
+  return REDISMODULE_OK;
 }
 
 int AREQ_ApplyContext(AREQ *req, RedisSearchCtx *sctx, QueryError *status) {
@@ -871,7 +920,9 @@ int AREQ_ApplyContext(AREQ *req, RedisSearchCtx *sctx, QueryError *status) {
   }
 
   QAST_EvalParams(ast, opts, status);
-  applyGlobalFilters(opts, ast, sctx);
+  if (applyGlobalFilters(opts, ast, sctx, status) != REDISMODULE_OK) {
+    return REDISMODULE_ERR;
+  }
   
   if (QAST_CheckIsValid(ast, req->sctx->spec, opts, status) != REDISMODULE_OK) {
     return REDISMODULE_ERR;
@@ -1210,6 +1261,21 @@ int AREQ_BuildPipeline(AREQ *req, int options, QueryError *status) {
     }
   }
 
+  // Fuse the text scores with the vector distances. Both are needed, so the query must have a KNN
+  // clause and must be scored.
+  if (req->searchopts.fusion.method != FusionMethod_None) {
+    if (!req->ast.vecScoreFieldNames) {
+      QueryError_SetError(status, QUERY_EPARSEARGS, "FUSE requires a KNN vector query");
+      goto error;
+    }
+    if (hasQuerySortby(pln)) {
+      QueryError_SetError(status, QUERY_EPARSEARGS, "FUSE cannot be combined with SORTBY");
+      goto error;
+    }
+    rp = RPFusion_New(&req->searchopts.fusion);
+    PUSH_RP();
+  }
+
   // Whether we've applied a SORTBY yet..
   int hasArrange = 0;
 
@@ -3,6 +3,7 @@
 #include <util/block_alloc.h>
 #include <util/khash.h>
 #include "reducer.h"
+#include "tag_index.h"
 
 /**
  * A group represents the allocated context of all reducers in a group, and the
@@ -46,6 +47,13 @@ typedef struct Grouper {
   // Map of group_name => `Group` structure
   khash_t(khid) * groups;
 
+  // Tag index whose column holds the single group key, if any. See getTagValueGroup
+  const TagIndex *tagIdx;
+  bool tagIdxResolved;
+  // Map of dictionary id => `Group` structure, valid for the dictionary revision below
+  arrayof(Group *) tagValueGroups;
+  uint32_t tagDictRevision;
+
   // Backing store for the groups themselves
   BlkAlloc groupsAlloc;
 
@@ -146,6 +154,52 @@ static void invokeReducers(Grouper *g, Group *gr, RLookupRow *srcrow) {
   }
 }
 
+static Group *getGroup(Grouper *g, const RSValue **xarr, size_t xlen, uint64_t hval) {
+  khiter_t k = kh_get(khid, g->groups, hval);  // first have to get ieter
+  if (k != kh_end(g->groups)) {                // k will be equal to kh_end if key not present
+    return kh_value(g->groups, k);
+  }
+  Group *group = createGroup(g, xarr, xlen);
+  kh_set(khid, g->groups, hval, group);
+  return group;
+}
+
+/**
+ * When the single group key is a tag field with a column (see TagIndex_GetDocValue), rows are
+ * matched to their group by the dictionary id recorded for the document, and the value is only
+ * hashed the first time each id is seen.
+ * Returns NULL for rows that can not be matched this way.
+ */
+static Group *getTagValueGroup(Grouper *g, const RSValue *v, t_docId docId) {
+  const TagIndex *idx = g->tagIdx;
+  uint32_t id = TagIndex_GetDocValueId(idx, docId);
+  if (!id) {
+    return NULL;
+  }
+  // the row holds the document's value, unless a step on the way replaced it
+  const RSValue *dv = RSValue_Dereference(v);
+  if (!RSValue_IsString(dv)) {
+    return NULL;
+  }
+  size_t len;
+  const char *str = RSValue_StringPtrLen(dv, &len);
+  const TagDictEntry *e = idx->dict + id;
+  if (len != e->len || memcmp(str, e->value, len)) {
+    return NULL;
+  }
+
+  // ids released by the GC may be reused by other values
+  if (g->tagDictRevision != idx->dictRevision) {
+    array_clear(g->tagValueGroups);
+    g->tagDictRevision = idx->dictRevision;
+  }
+  Group **gp = array_ensure_at(&g->tagValueGroups, id, Group *);
+  if (!*gp) {
+    *gp = getGroup(g, &v, 1, RSValue_Hash(dv, 0));
+  }
+  return *gp;
+}
+
 /**
  * This function recursively descends into each value within a group and invokes
  * Add() for each cartesian product of the current row.
@@ -166,19 +220,8 @@ static void extractGroups(Grouper *g, const RSValue **xarr, size_t xpos, size_t
                           uint64_t hval, RLookupRow *res) {
   // end of the line - create/add to group
   if (xpos == xlen) {
-    Group *group = NULL;
-
-    // Get or create the group
-    khiter_t k = kh_get(khid, g->groups, hval);  // first have to get ieter
-    if (k == kh_end(g->groups)) {                // k will be equal to kh_end if key not present
-      group = createGroup(g, xarr, xlen);
-      kh_set(khid, g->groups, hval, group);
-    } else {
-      group = kh_value(g->groups, k);
-    }
-
-    // send the result to the group and its reducers
-    invokeReducers(g, group, res);
+    // Get or create the group, and send the result to the group and its reducers
+    invokeReducers(g, getGroup(g, xarr, xlen, hval), res);
     return;
   }
 
@@ -215,7 +258,7 @@ static void extractGroups(Grouper *g, const RSValue **xarr, size_t xpos, size_t
   }
 }
 
-static void invokeGroupReducers(Grouper *g, RLookupRow *srcrow) {
+static void invokeGroupReducers(Grouper *g, t_docId docId, RLookupRow *srcrow) {
   uint64_t hval = 0;
   size_t nkeys = GROUPER_NSRCKEYS(g);
   const RSValue *groupvals[nkeys];
@@ -228,6 +271,13 @@ static void invokeGroupReducers(Grouper *g, RLookupRow *srcrow) {
     }
     groupvals[ii] = v;
   }
+  if (g->tagIdx) {
+    Group *group = getTagValueGroup(g, groupvals[0], docId);
+    if (group) {
+      invokeReducers(g, group, srcrow);
+      return;
+    }
+  }
   extractGroups(g, groupvals, 0, nkeys, 0, 0, srcrow);
 }
 
@@ -236,8 +286,16 @@ static int Grouper_rpAccum(ResultProcessor *base, SearchResult *res) {
 
   int rc;
 
+  if (!g->tagIdxResolved) {
+    g->tagIdxResolved = true;
+    RedisSearchCtx *sctx = base->parent ? base->parent->sctx : NULL;
+    if (g->nkeys == 1 && sctx && sctx->spec) {
+      g->tagIdx = TagIndex_OpenColumn(sctx, g->srckeys[0]->path);
+    }
+  }
+
   while ((rc = base->upstream->Next(base->upstream, res)) == RS_RESULT_OK) {
-    invokeGroupReducers(g, &res->rowdata);
+    invokeGroupReducers(g, res->docId, &res->rowdata);
     SearchResult_Clear(res);
   }
   if (rc == RS_RESULT_EOF) {
@@ -272,6 +330,7 @@ static void Grouper_rpFree(ResultProcessor *grrp) {
     RLookupRow_Cleanup(&gr->rowdata);
   }
   kh_destroy(khid, g->groups);
+  array_free(g->tagValueGroups);
   BlkAlloc_FreeAll(&g->groupsAlloc, cleanCallback, g, GROUP_BYTESIZE(g));
 
   for (size_t i = 0; i < GROUPER_NREDUCERS(g); i++) {
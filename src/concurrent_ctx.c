@@ -8,6 +8,7 @@ static threadpool *threadpools_g = NULL;
 
 int CONCURRENT_POOL_INDEX = -1;
 int CONCURRENT_POOL_SEARCH = -1;
+int CONCURRENT_POOL_SCAN = -1;
 
 int ConcurrentSearch_CreatePool(int numThreads) {
   if (!threadpools_g) {
@@ -33,6 +34,9 @@ void ConcurrentSearch_ThreadPoolStart() {
       numProcs = RSGlobalConfig.indexPoolSize;
     }
     CONCURRENT_POOL_INDEX = ConcurrentSearch_CreatePool(numProcs);
+    // The background scanner waits for its jobs while holding the GIL, so they must not queue
+    // behind indexing jobs that may be waiting for the GIL themselves
+    CONCURRENT_POOL_SCAN = ConcurrentSearch_CreatePool(numProcs);
   }
 }
 
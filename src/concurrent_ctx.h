@@ -113,6 +113,7 @@ int ConcurrentSearch_CreatePool(int numThreads);
 
 extern int CONCURRENT_POOL_INDEX;
 extern int CONCURRENT_POOL_SEARCH;
+extern int CONCURRENT_POOL_SCAN;
 
 /* Run a function on the concurrent thread pool */
 void ConcurrentSearch_ThreadPoolRun(void (*func)(void *), void *arg, int type);
@@ -321,6 +321,14 @@ CONFIG_BOOLEAN_GETTER(getForkGCCleanNumericEmptyNodes, forkGCCleanNumericEmptyNo
 CONFIG_BOOLEAN_SETTER(set_ForkGCCleanNumericEmptyNodes, forkGCCleanNumericEmptyNodes)
 CONFIG_BOOLEAN_GETTER(get_ForkGCCleanNumericEmptyNodes, forkGCCleanNumericEmptyNodes, 0)
 
+// SUFFIX_ARRAY
+CONFIG_BOOLEAN_SETTER(setSuffixArray, suffixArray)
+CONFIG_BOOLEAN_GETTER(getSuffixArray, suffixArray, 0)
+
+// TERMS_SNAPSHOT
+CONFIG_BOOLEAN_SETTER(setTermsSnapshot, termsSnapshot)
+CONFIG_BOOLEAN_GETTER(getTermsSnapshot, termsSnapshot, 0)
+
 CONFIG_GETTER(getMaxResultsToUnsortedMode) {
   sds ss = sdsempty();
   return sdscatprintf(ss, "%lld", config->maxResultsToUnsortedMode);
@@ -684,6 +692,18 @@ RSConfigOptions RSGlobalConfigOptions = {
          .helpText = "clean empty nodes from numeric tree",
          .setValue = set_ForkGCCleanNumericEmptyNodes,
          .getValue = get_ForkGCCleanNumericEmptyNodes},
+        {.name = "SUFFIX_ARRAY",
+         .helpText = "use a suffix array rebuilt by the gc instead of a suffix trie for "
+                     "WITHSUFFIXTRIE text fields",
+         .setValue = setSuffixArray,
+         .getValue = getSuffixArray,
+         .flags = RSCONFIGVAR_F_IMMUTABLE},
+        {.name = "TERMS_SNAPSHOT",
+         .helpText = "keep a read-optimized copy of the terms, rebuilt by the gc, for prefix and "
+                     "fuzzy queries. It is kept in addition to the terms trie",
+         .setValue = setTermsSnapshot,
+         .getValue = getTermsSnapshot,
+         .flags = RSCONFIGVAR_F_IMMUTABLE},
         {.name = "_MAX_RESULTS_TO_UNSORTED_MODE",
          .helpText = "max results for union interator in which the interator will switch to "
                      "unsorted mode, should be used for debug only.",
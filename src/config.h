@@ -81,6 +81,11 @@ typedef struct {
   size_t forkGcSleepBeforeExit;
   int forkGCCleanNumericEmptyNodes;
 
+  // Serve WITHSUFFIXTRIE text fields from a suffix array rebuilt by the GC
+  int suffixArray;
+  // Keep a read-optimized copy of the terms, rebuilt by the GC, for prefix and fuzzy queries
+  int termsSnapshot;
+
   FieldsGlobalStats fieldsStats;
 
   // Chained configuration data
@@ -24,6 +24,7 @@ extern RedisModuleCtx *RSDummyContext;
 static void *allocDocumentContext(void) {
   // See if there's one in the pool?
   RSAddDocumentCtx *aCtx = rm_calloc(1, sizeof(*aCtx));
+  BlkAlloc_Init(&aCtx->arena);
   return aCtx;
 }
 
@@ -32,6 +33,7 @@ static void freeDocumentContext(void *p) {
   if (aCtx->fwIdx) {
     ForwardIndexFree(aCtx->fwIdx);
   }
+  BlkAlloc_FreeAll(&aCtx->arena, NULL, NULL, 0);
 
   rm_free(aCtx->fspecs);
   rm_free(aCtx->fdatas);
@@ -391,6 +393,7 @@ void AddDocumentCtx_Free(RSAddDocumentCtx *aCtx) {
 
   ByteOffsetWriter_Cleanup(&aCtx->offsetsWriter);
   QueryError_ClearError(&aCtx->status);
+  BlkAlloc_Clear(&aCtx->arena, NULL, NULL, 0);
 
   mempool_release(actxPool_g, aCtx);
 }
@@ -651,7 +654,7 @@ FIELD_PREPROCESSOR(geoPreprocessor) {
 }
 
 FIELD_PREPROCESSOR(tagPreprocessor) {
-  fdata->tags = TagIndex_Preprocess(fs->tagOpts.tagSep, fs->tagOpts.tagFlags, field);
+  fdata->tags = TagIndex_Preprocess(fs->tagOpts.tagSep, fs->tagOpts.tagFlags, field, &aCtx->arena);
 
   if (fdata->tags == NULL) {
     return 0;
@@ -682,6 +685,16 @@ FIELD_BULK_INDEXER(tagIndexer) {
   ctx->spec->stats.invertedSize +=
       TagIndex_Index(tidx, (const char **)fdata->tags, array_len(fdata->tags), aCtx->doc->docId);
   ctx->spec->stats.numRecords++;
+
+  // Record the value in the tag column only if loading the field would return the same string
+  if (array_len(fdata->tags) == 1 && isSpecHash(ctx->spec)) {
+    size_t fl;
+    const char *str = DocumentField_GetValueCStr(field, &fl);
+    size_t tl = strlen(fdata->tags[0]);
+    if (str && fl == tl && !memcmp(str, fdata->tags[0], tl)) {
+      TagIndex_SetDocValue(tidx, aCtx->doc->docId, fdata->tags[0], tl);
+    }
+  }
   return 0;
 }
 
@@ -732,9 +745,10 @@ void IndexerBulkCleanup(IndexBulkData *cur, RedisSearchCtx *sctx) {
   }
 }
 
-int Document_AddToIndexes(RSAddDocumentCtx *aCtx) {
+// Run the field preprocessors (tokenizing, tag splitting, numeric parsing...) of a document.
+// This needs no locks, so it may run on any thread
+static int Document_Preprocess(RSAddDocumentCtx *aCtx) {
   Document *doc = aCtx->doc;
-  int ourRv = REDISMODULE_OK;
 
   for (size_t i = 0; i < doc->numFields; i++) {
     const FieldSpec *fs = aCtx->fspecs + i;
@@ -748,21 +762,31 @@ int Document_AddToIndexes(RSAddDocumentCtx *aCtx) {
 
       PreprocessorFunc pp = preprocessorMap[ii];
       if (pp(aCtx, &doc->fields[i], fs, fdata, &aCtx->status) != 0) {
-        if (!AddDocumentCtx_IsBlockable(aCtx)) {
-          ++aCtx->spec->stats.indexingFailures;
-        } else {
-          RedisModule_ThreadSafeContextLock(RSDummyContext);
-          IndexSpec *spec = IndexSpec_Load(RSDummyContext, aCtx->specName, 0);
-          if (spec && aCtx->specId == spec->uniqueId) {
-            ++spec->stats.indexingFailures;
-          }
-          RedisModule_ThreadSafeContextUnlock(RSDummyContext);
-        }
-        ourRv = REDISMODULE_ERR;
-        goto cleanup;
+        return REDISMODULE_ERR;
       }
     }
   }
+  return REDISMODULE_OK;
+}
+
+// Write a preprocessed document to the index, or clean up after a failed preprocessing
+static int Document_AddPreprocessed(RSAddDocumentCtx *aCtx, int preprocessRv) {
+  Document *doc = aCtx->doc;
+  int ourRv = preprocessRv;
+
+  if (ourRv != REDISMODULE_OK) {
+    if (!AddDocumentCtx_IsBlockable(aCtx)) {
+      ++aCtx->spec->stats.indexingFailures;
+    } else {
+      RedisModule_ThreadSafeContextLock(RSDummyContext);
+      IndexSpec *spec = IndexSpec_Load(RSDummyContext, aCtx->specName, 0);
+      if (spec && aCtx->specId == spec->uniqueId) {
+        ++spec->stats.indexingFailures;
+      }
+      RedisModule_ThreadSafeContextUnlock(RSDummyContext);
+    }
+    goto cleanup;
+  }
 
   if (Indexer_Add(aCtx->indexer, aCtx) != 0) {
     ourRv = REDISMODULE_ERR;
@@ -781,6 +805,72 @@ cleanup:
   return ourRv;
 }
 
+int Document_AddToIndexes(RSAddDocumentCtx *aCtx) {
+  return Document_AddPreprocessed(aCtx, Document_Preprocess(aCtx));
+}
+
+// A batch of documents being preprocessed on the index thread pool
+typedef struct {
+  RSAddDocumentCtx *aCtx;
+  int rv;
+  size_t *pending;
+  pthread_mutex_t *lock;
+  pthread_cond_t *cond;
+} preprocessJob;
+
+static void preprocessCallback(void *p) {
+  preprocessJob *job = p;
+  job->rv = Document_Preprocess(job->aCtx);
+
+  pthread_mutex_lock(job->lock);
+  if (--*job->pending == 0) {
+    pthread_cond_signal(job->cond);
+  }
+  pthread_mutex_unlock(job->lock);
+}
+
+void AddDocumentCtx_SubmitBatch(RSAddDocumentCtx **aCtxs, size_t n, RedisSearchCtx *sctx,
+                                uint32_t options) {
+  if (CONCURRENT_POOL_SCAN == -1 || n < 2) {
+    // no worker threads (CONCURRENT_WRITE_MODE is off) - index the documents one by one
+    for (size_t ii = 0; ii < n; ++ii) {
+      AddDocumentCtx_Submit(aCtxs[ii], sctx, options);
+    }
+    return;
+  }
+
+  RS_LOG_ASSERT(!(options & DOCUMENT_ADD_PARTIAL), "partial updates cannot be batched");
+  preprocessJob jobs[n];
+  size_t pending = n;
+  pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+  for (size_t ii = 0; ii < n; ++ii) {
+    RSAddDocumentCtx *aCtx = aCtxs[ii];
+    RS_LOG_ASSERT(!AddDocumentCtx_IsBlockable(aCtx), "batched documents must not block");
+    aCtx->options = options;
+    aCtx->client.sctx = sctx;
+    // We actually modify (!) the strings in the document, so we always require
+    // ownership
+    Document_MakeStringsOwner(aCtx->doc);
+
+    jobs[ii] = (preprocessJob){.aCtx = aCtx, .pending = &pending, .lock = &lock, .cond = &cond};
+    ConcurrentSearch_ThreadPoolRun(preprocessCallback, jobs + ii, CONCURRENT_POOL_SCAN);
+  }
+
+  pthread_mutex_lock(&lock);
+  while (pending) {
+    pthread_cond_wait(&cond, &lock);
+  }
+  pthread_mutex_unlock(&lock);
+  pthread_cond_destroy(&cond);
+  pthread_mutex_destroy(&lock);
+
+  // Document IDs are assigned and postings written in the batch's order
+  for (size_t ii = 0; ii < n; ++ii) {
+    Document_AddPreprocessed(aCtxs[ii], jobs[ii].rv);
+  }
+}
+
 /* Evaluate an IF expression (e.g. IF "@foo == 'bar'") against a document, by getting the properties
  * from the sorting table or from the hash representation of the document.
  *
@@ -7,6 +7,7 @@
 #include "tokenize.h"
 #include "concurrent_ctx.h"
 #include "byte_offsets.h"
+#include "util/block_alloc.h"
 #include "rmutil/args.h"
 #include "query_error.h"
 #include "json.h"
@@ -292,6 +293,9 @@ typedef struct RSAddDocumentCtx {
 
   // Scratch space used by per-type field preprocessors (see the source)
   struct FieldIndexerData *fdatas;
+  // Owns the preprocessors' temporary allocations (e.g. split tags). It is cleared at once when
+  // the document is done, and its blocks are kept for the next document of the pooled context
+  BlkAlloc arena;
   QueryError status;     // Error message is placed here if there is an error during processing
   uint32_t totalTokens;  // Number of tokens, used for offset vector
   uint32_t specFlags;    // Cached index flags
@@ -325,6 +329,16 @@ RSAddDocumentCtx *NewAddDocumentCtx(IndexSpec *sp, Document *base, QueryError *s
  */
 void AddDocumentCtx_Submit(RSAddDocumentCtx *aCtx, RedisSearchCtx *sctx, uint32_t options);
 
+/**
+ * Submit a batch of non-blocking contexts of the same index. The documents are preprocessed
+ * (tokenized, tags split, numbers parsed...) in parallel on the scan thread pool, and then
+ * given document IDs and written to the index one by one, in order, on the calling thread.
+ * Without the thread pool (CONCURRENT_WRITE_MODE off) this is the same as submitting each
+ * context in turn. Partial updates are not supported.
+ */
+void AddDocumentCtx_SubmitBatch(RSAddDocumentCtx **aCtxs, size_t n, RedisSearchCtx *sctx,
+                                uint32_t options);
+
 /**
  * Indicate that processing is finished on the current document
  */
@@ -500,17 +500,13 @@ static void FGC_childCollectTags(ForkGC *gc, RedisSearchCtx *sctx) {
                              .field = tagFields[i]->name,
                              .uniqueId = tagIdx->uniqueId};
 
-      TrieMapIterator *iter = TrieMap_Iterate(tagIdx->values, "", 0);
-      char *ptr;
-      tm_len_t len;
-      InvertedIndex *value;
-      while (TrieMapIterator_Next(iter, &ptr, &len, (void **)&value)) {
-        header.curPtr = value;
-        header.tagValue = ptr;
-        header.tagLen = len;
+      TAGINDEX_FOREACH_VALUE(tagIdx, e, {
+        header.curPtr = e->iv;
+        header.tagValue = (char *)e->value;
+        header.tagLen = e->len;
         // send repaired data
-        FGC_childRepairInvidx(gc, sctx, value, sendNumericTagHeader, &header, NULL);
-      }
+        FGC_childRepairInvidx(gc, sctx, e->iv, sendNumericTagHeader, &header, NULL);
+      });
 
       // we are done with the current field
       if (header.sentFieldName) {
@@ -527,6 +523,76 @@ static void FGC_childCollectTags(ForkGC *gc, RedisSearchCtx *sctx) {
   FGC_sendTerminator(gc);
 }
 
+static void FGC_childCollectTagColumns(ForkGC *gc, RedisSearchCtx *sctx) {
+  RedisModuleKey *idxKey = NULL;
+  FieldSpec **tagFields = getFieldsByType(sctx->spec, INDEXFLD_T_TAG);
+  for (int i = 0; i < array_len(tagFields); ++i) {
+    RedisModuleString *keyName =
+        IndexSpec_GetFormattedKey(sctx->spec, tagFields[i], INDEXFLD_T_TAG);
+    TagIndex *tagIdx = TagIndex_Open(sctx, keyName, false, &idxKey);
+    if (!tagIdx) {
+      continue;
+    }
+
+    // collect the deleted documents that still have a value in the column
+    arrayof(t_docId) deleted = NULL;
+    for (size_t ii = 0; ii < array_len(tagIdx->docValues); ++ii) {
+      const TagDocValuesPage *page = tagIdx->docValues[ii];
+      if (!page) {
+        continue;
+      }
+      t_docId first = (tagIdx->docValuesBase + ii) * TAG_DOCVALUES_PAGE_SIZE;
+      for (size_t jj = 0; jj < TAG_DOCVALUES_PAGE_SIZE; ++jj) {
+        t_docId docId = first + jj;
+        if (page->ids[jj] && !DocTable_Exists(&sctx->spec->docs, docId)) {
+          deleted = array_ensure_append_1(deleted, docId);
+        }
+      }
+    }
+
+    if (deleted) {
+      uint64_t uniqueId = tagIdx->uniqueId;
+      FGC_sendBuffer(gc, tagFields[i]->name, strlen(tagFields[i]->name));
+      FGC_SEND_VAR(gc, uniqueId);
+      FGC_sendBuffer(gc, deleted, array_len(deleted) * sizeof(*deleted));
+      array_free(deleted);
+    }
+
+    if (idxKey) {
+      RedisModule_CloseKey(idxKey);
+      idxKey = NULL;
+    }
+  }
+  array_free(tagFields);
+  // we are done with the tag columns
+  FGC_sendTerminator(gc);
+}
+
+static void FGC_childBuildTermsSnapshot(ForkGC *gc, RedisSearchCtx *sctx) {
+  // the parent asked for a new snapshot before forking, and tracks the terms added since
+  if (!sctx->spec->termsPending) {
+    FGC_sendTerminator(gc);
+    return;
+  }
+  TermsSnapshot *snap = NewTermsSnapshot(sctx->spec->terms);
+  FGC_sendBuffer(gc, snap->data, snap->dataLen);
+  FGC_sendBuffer(gc, snap->restarts, snap->numRestarts * sizeof(*snap->restarts));
+  FGC_SEND_VAR(gc, snap->numTerms);
+  FGC_SEND_VAR(gc, snap->maxTermLen);
+
+  // with SUFFIX_ARRAY, contains queries are served from the snapshot's suffix array
+  if ((sctx->spec->flags & Index_HasSuffixTrie) && RSGlobalConfig.suffixArray) {
+    SuffixArray *sa = NewSuffixArray(snap);
+    FGC_sendBuffer(gc, sa->text, sa->textLen);
+    FGC_sendBuffer(gc, sa->suffixes, sa->numSuffixes * sizeof(*sa->suffixes));
+    SuffixArray_Free(sa);
+  } else {
+    FGC_sendBuffer(gc, NULL, 0);
+    FGC_sendBuffer(gc, NULL, 0);
+  }
+  TermsSnapshot_Free(snap);
+}
+
 static void FGC_childScanIndexes(ForkGC *gc) {
   RedisSearchCtx *sctx = FGC_getSctx(gc, gc->ctx);
   if (!sctx || sctx->spec->uniqueId != gc->specUniqueId) {
@@ -535,8 +601,10 @@ static void FGC_childScanIndexes(ForkGC *gc) {
   }
 
   FGC_childCollectTerms(gc, sctx);
+  FGC_childBuildTermsSnapshot(gc, sctx);
   FGC_childCollectNumeric(gc, sctx);
   FGC_childCollectTags(gc, sctx);
+  FGC_childCollectTagColumns(gc, sctx);
 
   SearchCtx_Free(sctx);
 }
@@ -785,13 +853,15 @@ static FGCError FGC_parentHandleTerms(ForkGC *gc, RedisModuleCtx *rctx) {
     if (sctx->spec->keysDict) {
       dictDelete(sctx->spec->keysDict, termKey);
     }
-    Trie_Delete(sctx->spec->terms, term, len);
+    IndexSpec_DeleteTerm(sctx->spec, term, len);
     sctx->spec->stats.numTerms--;
     sctx->spec->stats.termsSize -= len;
     RedisModule_FreeString(sctx->redisCtx, termKey);
     if (sctx->spec->suffix) {
       deleteSuffixTrie(sctx->spec->suffix, term, len);
     }
+  } else {
+    IndexSpec_SetTermFrequency(sctx->spec, term, len, idx->numDocs);
   }
 
 cleanup:
@@ -852,6 +922,66 @@ static int recvCardvals(ForkGC *fgc, CardinalityValue **tgt, size_t *len,
   return REDISMODULE_OK;
 }
 
+static FGCError FGC_parentHandleTermsSnapshot(ForkGC *gc, RedisModuleCtx *rctx) {
+  TermsSnapshot *snap = rm_calloc(1, sizeof(*snap));
+  size_t restartsLen;
+  if (FGC_recvBuffer(gc, (void **)&snap->data, &snap->dataLen) != REDISMODULE_OK) {
+    rm_free(snap);
+    return FGC_CHILD_ERROR;
+  }
+  if (snap->data == RECV_BUFFER_EMPTY) {
+    // no snapshot was requested
+    rm_free(snap);
+    return FGC_DONE;
+  }
+  if (FGC_recvBuffer(gc, (void **)&snap->restarts, &restartsLen) != REDISMODULE_OK ||
+      FGC_recvFixed(gc, &snap->numTerms, sizeof(snap->numTerms)) != REDISMODULE_OK ||
+      FGC_recvFixed(gc, &snap->maxTermLen, sizeof(snap->maxTermLen)) != REDISMODULE_OK) {
+    TermsSnapshot_Free(snap);
+    return FGC_CHILD_ERROR;
+  }
+  snap->numRestarts = restartsLen / sizeof(*snap->restarts);
+
+  SuffixArray *sa = rm_calloc(1, sizeof(*sa));
+  size_t suffixesLen;
+  if (FGC_recvBuffer(gc, (void **)&sa->text, &sa->textLen) != REDISMODULE_OK ||
+      FGC_recvBuffer(gc, (void **)&sa->suffixes, &suffixesLen) != REDISMODULE_OK) {
+    TermsSnapshot_Free(snap);
+    SuffixArray_Free(sa);
+    return FGC_CHILD_ERROR;
+  }
+  sa->numSuffixes = suffixesLen / sizeof(*sa->suffixes);
+  if (!sa->text) {
+    // the index has a suffix trie
+    SuffixArray_Free(sa);
+    sa = NULL;
+  }
+
+  if (!FGC_lock(gc, rctx)) {
+    TermsSnapshot_Free(snap);
+    if (sa) {
+      SuffixArray_Free(sa);
+    }
+    return FGC_PARENT_ERROR;
+  }
+  FGCError status = FGC_DONE;
+  RedisSearchCtx *sctx = FGC_getSctx(gc, rctx);
+  if (sctx && sctx->spec->uniqueId == gc->specUniqueId) {
+    IndexSpec_SetTermsSnapshot(sctx->spec, snap, sa);
+  } else {
+    TermsSnapshot_Free(snap);
+    if (sa) {
+      SuffixArray_Free(sa);
+    }
+    status = FGC_PARENT_ERROR;
+  }
+  if (sctx) {
+    SearchCtx_Free(sctx);
+  }
+  FGC_unlock(gc, rctx);
+  return status;
+}
+
 static FGCError recvNumIdx(ForkGC *gc, NumGcInfo *ninfo) {
   if (FGC_recvFixed(gc, &ninfo->node, sizeof(ninfo->node)) != REDISMODULE_OK) {
     goto error;
@@ -1073,11 +1203,7 @@ static FGCError FGC_parentHandleTags(ForkGC *gc, RedisModuleCtx *rctx) {
 
     // if tag value is empty, let's remove it.
     if (idx->numDocs == 0) {
-      TrieMap_Delete(tagIdx->values, tagVal, tagValLen, InvertedIndex_Free);
-
-      if (tagIdx->suffix) {
-        deleteSuffixTrieMap(tagIdx->suffix, tagVal, tagValLen);
-      }
+      TagIndex_DeleteValue(tagIdx, tagVal, tagValLen);
     }
 
   loop_cleanup:
@@ -1105,6 +1231,54 @@ static FGCError FGC_parentHandleTags(ForkGC *gc, RedisModuleCtx *rctx) {
   return status;
 }
 
+static FGCError FGC_parentHandleTagColumns(ForkGC *gc, RedisModuleCtx *rctx) {
+  size_t fieldNameLen;
+  char *fieldName;
+  uint64_t tagUniqueId;
+  t_docId *deleted = NULL;
+  size_t deletedLen;
+  FGCError status = recvNumericTagHeader(gc, &fieldName, &fieldNameLen, &tagUniqueId);
+  if (status != FGC_COLLECTED) {
+    return status;
+  }
+
+  if (FGC_recvBuffer(gc, (void **)&deleted, &deletedLen) != REDISMODULE_OK) {
+    rm_free(fieldName);
+    return FGC_CHILD_ERROR;
+  }
+
+  if (!FGC_lock(gc, rctx)) {
+    status = FGC_PARENT_ERROR;
+    goto cleanup;
+  }
+
+  RedisSearchCtx *sctx = FGC_getSctx(gc, rctx);
+  if (!sctx || sctx->spec->uniqueId != gc->specUniqueId) {
+    status = FGC_PARENT_ERROR;
+  } else {
+    RedisModuleKey *idxKey = NULL;
+    RedisModuleString *keyName =
+        IndexSpec_GetFormattedKeyByName(sctx->spec, fieldName, INDEXFLD_T_TAG);
+    TagIndex *tagIdx = TagIndex_Open(sctx, keyName, false, &idxKey);
+    // document ids are never reused, so the deleted documents can be cleared as is
+    if (tagIdx && tagIdx->uniqueId == tagUniqueId) {
+      TagIndex_ClearDocValues(tagIdx, deleted, deletedLen / sizeof(*deleted));
+    }
+    if (idxKey) {
+      RedisModule_CloseKey(idxKey);
+    }
+  }
+  if (sctx) {
+    SearchCtx_Free(sctx);
+  }
+  FGC_unlock(gc, rctx);
+
+cleanup:
+  rm_free(fieldName);
+  rm_free(deleted);
+  return status;
+}
+
 int FGC_parentHandleFromChild(ForkGC *gc) {
   FGCError status = FGC_COLLECTED;
 
@@ -1116,8 +1290,10 @@ int FGC_parentHandleFromChild(ForkGC *gc) {
   }
 
   COLLECT_FROM_CHILD(FGC_parentHandleTerms(gc, gc->ctx));
+  COLLECT_FROM_CHILD(FGC_parentHandleTermsSnapshot(gc, gc->ctx));
   COLLECT_FROM_CHILD(FGC_parentHandleNumeric(gc, gc->ctx));
   COLLECT_FROM_CHILD(FGC_parentHandleTags(gc, gc->ctx));
+  COLLECT_FROM_CHILD(FGC_parentHandleTagColumns(gc, gc->ctx));
   return REDISMODULE_OK;
 }
 
@@ -1138,6 +1314,16 @@ static int FGC_fork(ForkGC *gc, RedisModuleCtx *ctx) {
   }
 }
 
+static void FGC_prepareTermsSnapshot(ForkGC *gc, RedisModuleCtx *ctx) {
+  RedisSearchCtx *sctx = FGC_getSctx(gc, ctx);
+  if (sctx && sctx->spec->uniqueId == gc->specUniqueId) {
+    IndexSpec_PrepareTermsSnapshot(sctx->spec);
+  }
+  if (sctx) {
+    SearchCtx_Free(sctx);
+  }
+}
+
 static int periodicCb(RedisModuleCtx *ctx, void *privdata) {
   ForkGC *gc = privdata;
   if (gc->deleting) {
@@ -1200,6 +1386,9 @@ static int periodicCb(RedisModuleCtx *ctx, void *privdata) {
 
   gc->execState = FGC_STATE_SCANNING;
 
+  // the child builds the terms snapshot from the terms as they are now
+  FGC_prepareTermsSnapshot(gc, ctx);
+
   cpid = FGC_fork(gc, ctx);  // duplicate the current process
 
   if (cpid == -1) {
@@ -154,10 +154,7 @@ void ForwardIndexFree(ForwardIndex *idx) {
 }
 
 static char *copyTempString(ForwardIndex *idx, const char *s, size_t n) {
-  char *dst = BlkAlloc_Alloc(&idx->terms, n + 1, MAX(n + 1, TERM_BLOCK_SIZE));
-  memcpy(dst, s, n);
-  dst[n] = '\0';
-  return dst;
+  return BlkAlloc_Strndup(&idx->terms, s, n, TERM_BLOCK_SIZE);
 }
 
 static khIdxEntry *makeEntry(ForwardIndex *idx, const char *s, size_t n, uint32_t h, int *isNew) {
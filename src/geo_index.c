@@ -6,13 +6,115 @@
 #include "query_node.h"
 #include "query_param.h"
 
+#include <math.h>
+
 static double extractUnitFactor(GeoDistance unit);
 
+static int parseCoord(ArgsCursor *ac, double *lon, double *lat, QueryError *status) {
+  int rv;
+  if ((rv = AC_GetDouble(ac, lon, 0)) != AC_OK) {
+    QERR_MKBADARGS_AC(status, "<lon>", rv);
+    return REDISMODULE_ERR;
+  }
+  if ((rv = AC_GetDouble(ac, lat, 0)) != AC_OK) {
+    QERR_MKBADARGS_AC(status, "<lat>", rv);
+    return REDISMODULE_ERR;
+  }
+  return REDISMODULE_OK;
+}
+
+/* BBOX <min lon> <min lat> <max lon> <max lat> */
+static int parseBBox(GeoFilter *gf, ArgsCursor *ac, QueryError *status) {
+  if (AC_NumRemaining(ac) < 4) {
+    QERR_MKBADARGS_FMT(status, "GEOFILTER BBOX requires 4 arguments");
+    return REDISMODULE_ERR;
+  }
+  gf->type = GEO_FILTER_BBOX;
+  if (parseCoord(ac, &gf->minLon, &gf->minLat, status) != REDISMODULE_OK ||
+      parseCoord(ac, &gf->maxLon, &gf->maxLat, status) != REDISMODULE_OK) {
+    return REDISMODULE_ERR;
+  }
+  return REDISMODULE_OK;
+}
+
+/* POLYGON <num vertices> <lon> <lat> ... */
+static int parsePolygon(GeoFilter *gf, ArgsCursor *ac, QueryError *status) {
+  size_t n;
+  int rv;
+  if ((rv = AC_GetSize(ac, &n, AC_F_GE1)) != AC_OK) {
+    QERR_MKBADARGS_AC(status, "<num vertices>", rv);
+    return REDISMODULE_ERR;
+  }
+  if (n < 3) {
+    QERR_MKBADARGS_FMT(status, "GEOFILTER POLYGON requires at least 3 vertices");
+    return REDISMODULE_ERR;
+  }
+  if (AC_NumRemaining(ac) < n * 2) {
+    QERR_MKBADARGS_FMT(status, "GEOFILTER POLYGON expects %zu coordinates", n * 2);
+    return REDISMODULE_ERR;
+  }
+
+  gf->type = GEO_FILTER_POLYGON;
+  gf->numVertices = n;
+  gf->polyLon = rm_malloc(3 * (n + 1) * sizeof(double));
+  gf->polyLat = gf->polyLon + n + 1;
+  gf->polySlope = gf->polyLat + n + 1;
+  for (size_t ii = 0; ii < n; ++ii) {
+    if (parseCoord(ac, gf->polyLon + ii, gf->polyLat + ii, status) != REDISMODULE_OK) {
+      return REDISMODULE_ERR;
+    }
+  }
+  gf->polyLon[n] = gf->polyLon[0];
+  gf->polyLat[n] = gf->polyLat[0];
+
+  gf->minLon = gf->maxLon = gf->polyLon[0];
+  gf->minLat = gf->maxLat = gf->polyLat[0];
+  for (size_t ii = 0; ii < n; ++ii) {
+    const double *x = gf->polyLon, *y = gf->polyLat;
+    gf->minLon = MIN(gf->minLon, x[ii]);
+    gf->maxLon = MAX(gf->maxLon, x[ii]);
+    gf->minLat = MIN(gf->minLat, y[ii]);
+    gf->maxLat = MAX(gf->maxLat, y[ii]);
+    // Horizontal edges get an infinite slope, they are never crossed anyway
+    gf->polySlope[ii] = (x[ii + 1] - x[ii]) / (y[ii + 1] - y[ii]);
+  }
+  return REDISMODULE_OK;
+}
+
+/* NEAREST <k> <lon> <lat> [AS <distance field>] */
+static int parseNearest(GeoFilter *gf, ArgsCursor *ac, QueryError *status) {
+  int rv;
+  if ((rv = AC_GetSize(ac, &gf->k, AC_F_GE1)) != AC_OK) {
+    QERR_MKBADARGS_AC(status, "<k>", rv);
+    return REDISMODULE_ERR;
+  }
+  gf->type = GEO_FILTER_NEAREST;
+  if (parseCoord(ac, &gf->lon, &gf->lat, status) != REDISMODULE_OK) {
+    return REDISMODULE_ERR;
+  }
+
+  if (AC_AdvanceIfMatch(ac, "AS")) {
+    const char *name;
+    if ((rv = AC_GetString(ac, &name, NULL, 0)) != AC_OK) {
+      QERR_MKBADARGS_AC(status, "<distance field>", rv);
+      return REDISMODULE_ERR;
+    }
+    gf->distField = rm_strdup(name);
+  } else {
+    rm_asprintf(&gf->distField, "__%s_distance", gf->property);
+  }
+  return REDISMODULE_OK;
+}
+
 /* Parse a geo filter from redis arguments. We assume the filter args start at argv[0], and FILTER
  * is not passed to us.
  * The GEO filter syntax is (FILTER) <property> LONG LAT DIST m|km|ft|mi
+ * or (FILTER) <property> BBOX MINLONG MINLAT MAXLONG MAXLAT
+ * or (FILTER) <property> POLYGON NUM LONG LAT [LONG LAT ...]
+ * or (FILTER) <property> NEAREST K LONG LAT [AS NAME]
  * Returns REDISMODUEL_OK or ERR  */
 int GeoFilter_Parse(GeoFilter *gf, ArgsCursor *ac, QueryError *status) {
+  gf->type = GEO_FILTER_RADIUS;
   gf->lat = 0;
   gf->lon = 0;
   gf->radius = 0;
@@ -30,6 +132,15 @@ int GeoFilter_Parse(GeoFilter *gf, ArgsCursor *ac, QueryError *status) {
   } else {
     gf->property = rm_strdup(gf->property);
   }
+
+  if (AC_AdvanceIfMatch(ac, "BBOX")) {
+    return parseBBox(gf, ac, status);
+  } else if (AC_AdvanceIfMatch(ac, "POLYGON")) {
+    return parsePolygon(gf, ac, status);
+  } else if (AC_AdvanceIfMatch(ac, "NEAREST")) {
+    return parseNearest(gf, ac, status);
+  }
+
   if ((rv = AC_GetDouble(ac, &gf->lon, 0) != AC_OK)) {
     QERR_MKBADARGS_AC(status, "<lon>", rv);
     return REDISMODULE_ERR;
@@ -63,59 +174,31 @@ void GeoFilter_Free(GeoFilter *gf) {
     }
     rm_free(gf->numericFilters);
   }
+  if (gf->polyLon) rm_free(gf->polyLon);
+  if (gf->distField) rm_free(gf->distField);
   rm_free(gf);
 }
 
-static t_docId *geoRangeLoad(const GeoIndex *gi, const GeoFilter *gf, size_t *num) {
-  *num = 0;
-  t_docId *docIds = NULL;
-  RedisModuleString *s = IndexSpec_GetFormattedKey(gi->ctx->spec, gi->sp, INDEXFLD_T_GEO);
-  RS_LOG_ASSERT(s, "failed to retrive key");
-  /*GEORADIUS key longitude latitude radius m|km|ft|mi */
-  RedisModuleCtx *ctx = gi->ctx->redisCtx;
-  RedisModuleString *slon = RedisModule_CreateStringPrintf(ctx, "%f", gf->lon);
-  RedisModuleString *slat = RedisModule_CreateStringPrintf(ctx, "%f", gf->lat);
-  RedisModuleString *srad = RedisModule_CreateStringPrintf(ctx, "%f", gf->radius);
-  const char *unitstr = GeoDistance_ToString(gf->unitType);
-  RedisModuleCallReply *rep =
-      RedisModule_Call(ctx, "GEORADIUS", "ssssc", s, slon, slat, srad, unitstr);
-  if (rep == NULL || RedisModule_CallReplyType(rep) != REDISMODULE_REPLY_ARRAY) {
-    goto done;
-  }
-
-  size_t sz = RedisModule_CallReplyLength(rep);
-  docIds = rm_calloc(sz, sizeof(t_docId));
-  for (size_t i = 0; i < sz; i++) {
-    const char *s = RedisModule_CallReplyStringPtr(RedisModule_CallReplyArrayElement(rep, i), NULL);
-    if (!s) continue;
-
-    docIds[i] = (t_docId)atol(s);
-  }
-
-  *num = sz;
-
-done:
-  RedisModule_FreeString(ctx, slon);
-  RedisModule_FreeString(ctx, slat);
-  RedisModule_FreeString(ctx, srad);
-  if (rep) {
-    RedisModule_FreeCallReply(rep);
-  }
-
-  return docIds;
-}
-
 IndexIterator *NewGeoRangeIterator(RedisSearchCtx *ctx, const GeoFilter *gf) {
-  // check input parameters are valid
-  if (gf->radius <= 0 ||
-      gf->lon > GEO_LONG_MAX || gf->lon < GEO_LONG_MIN ||
-      gf->lat > GEO_LAT_MAX || gf->lat < GEO_LAT_MIN) {
-    return NULL;
-  }
-
   GeoHashRange ranges[GEO_RANGE_COUNT] = {{0}};
-  double radius_meter = gf->radius * extractUnitFactor(gf->unitType);
-  calcRanges(gf->lon, gf->lat, radius_meter, ranges);
+  if (gf->type == GEO_FILTER_RADIUS) {
+    // check input parameters are valid
+    if (gf->radius <= 0 ||
+        gf->lon > GEO_LONG_MAX || gf->lon < GEO_LONG_MIN ||
+        gf->lat > GEO_LAT_MAX || gf->lat < GEO_LAT_MIN) {
+      return NULL;
+    }
+    double radius_meter = gf->radius * extractUnitFactor(gf->unitType);
+    calcRanges(gf->lon, gf->lat, radius_meter, ranges);
+  } else {
+    // points outside the geohash latitude limits cannot be indexed
+    double minLat = MAX(gf->minLat, GEO_LAT_MIN);
+    double maxLat = MIN(gf->maxLat, GEO_LAT_MAX);
+    if (minLat > maxLat) {
+      return NULL;
+    }
+    calcBoxRanges(gf->minLon, minLat, gf->maxLon, maxLat, ranges);
+  }
 
   IndexIterator **iters = rm_calloc(GEO_RANGE_COUNT, sizeof(*iters));
   ((GeoFilter *)gf)->numericFilters = rm_calloc(GEO_RANGE_COUNT, sizeof(*gf->numericFilters));
@@ -148,6 +231,214 @@ IndexIterator *NewGeoRangeIterator(RedisSearchCtx *ctx, const GeoFilter *gf) {
   return it;
 }
 
+/*****************************************************************************
+ * Nearest documents iterator
+ *****************************************************************************/
+
+// The first radius scanned, in meters. Following radiuses grow by the density seen so far.
+#define GEO_NEAREST_INITIAL_RADIUS 1000
+// Half of the earth's circumference, in meters. A radius this large covers every point.
+#define GEO_NEAREST_MAX_RADIUS 20037600
+
+// The geohash of a result of the geo range iterator is in its (first) numeric record
+static const RSIndexResult *geoRecord(const RSIndexResult *r) {
+  while ((r->type & RS_RESULT_AGGREGATE) && r->agg.numChildren) {
+    r = r->agg.children[0];
+  }
+  return r->type == RSResultType_Numeric ? r : NULL;
+}
+
+/* Scan all the documents within a radius (in meters), keeping the k nearest ones.
+ * Returns the number of documents found within the radius */
+static size_t gniScanRadius(GeoNearestIterator *it, double radius) {
+  const GeoFilter *gf = it->gf;
+  DistHeap_Clear(&it->results);
+  it->numRounds++;
+
+  GeoFilter *rf = rm_calloc(1, sizeof(*rf));
+  rf->property = rm_strdup(gf->property);
+  rf->type = GEO_FILTER_RADIUS;
+  rf->lon = gf->lon;
+  rf->lat = gf->lat;
+  rf->radius = radius;
+  rf->unitType = GEO_DISTANCE_M;
+
+  size_t found = 0;
+  IndexIterator *ri = NewGeoRangeIterator(it->sctx, rf);
+  if (ri) {
+    IndexIterator *child = it->child;
+    if (child) {
+      child->Rewind(child->ctx);
+    }
+
+    RSIndexResult *r, *hit;
+    while (ri->Read(ri->ctx, &r) == INDEXREAD_OK) {
+      if (TimedOut_WithCtx(&it->timeoutCtx)) {
+        it->timedOut = 1;
+        break;
+      }
+      if (child) {
+        if (child->LastDocId(child->ctx) < r->docId &&
+            child->SkipTo(child->ctx, r->docId, &hit) == INDEXREAD_EOF) {
+          break;
+        }
+        if (child->LastDocId(child->ctx) != r->docId) {
+          continue;
+        }
+      }
+
+      const RSIndexResult *rec = geoRecord(r);
+      if (!rec) continue;
+      double xy[2];
+      decodeGeo(rec->num.value, xy);
+      double distance = geohashGetDistance(gf->lon, gf->lat, xy[0], xy[1]);
+      DistHeap_Offer(&it->results, r->docId, round(distance * 100) / 100);
+      found++;
+    }
+    ri->Free(ri);
+  }
+  GeoFilter_Free(rf);
+  return found;
+}
+
+static void gniPrepare(GeoNearestIterator *it) {
+  size_t k = it->gf->k;
+  double radius = GEO_NEAREST_INITIAL_RADIUS;
+  for (;;) {
+    size_t found = gniScanRadius(it, radius);
+    // Every document nearer than the k'th one is within the radius, so the heap holds the answer
+    if (it->timedOut || found >= k || radius >= GEO_NEAREST_MAX_RADIUS) {
+      break;
+    }
+    // Each round rescans the whole disc, so do not start another one past the deadline
+    if (!RS_IsMock && TimedOut(&it->timeoutCtx.timeout) == TIMED_OUT) {
+      it->timedOut = 1;
+      break;
+    }
+    // Grow the covered area by the ratio of documents still missing, with some slack
+    double factor = found ? sqrt((double)k / found) * 1.25 : 4;
+    radius = MIN(radius * MAX(factor, 2), GEO_NEAREST_MAX_RADIUS);
+  }
+  DistHeap_SortById(&it->results);
+  it->resultsPrepared = 1;
+}
+
+static inline void gniSetCurrent(GeoNearestIterator *it, RSIndexResult **hit) {
+  const DistHeapEntry *res = it->results.entries + it->offset++;
+  it->lastDocId = res->id;
+  it->base.current->docId = res->id;
+  it->base.current->dist.distance = res->distance;
+  it->base.current->dist.scoreField = it->gf->distField;
+  *hit = it->base.current;
+}
+
+static int GNI_Read(void *ctx, RSIndexResult **hit) {
+  GeoNearestIterator *it = ctx;
+  if (!it->resultsPrepared) {
+    gniPrepare(it);
+    if (it->timedOut) {
+      return INDEXREAD_TIMEOUT;
+    }
+  }
+  if (!it->base.isValid || it->offset >= it->results.size) {
+    it->base.isValid = 0;
+    return INDEXREAD_EOF;
+  }
+  gniSetCurrent(it, hit);
+  return INDEXREAD_OK;
+}
+
+static int GNI_SkipTo(void *ctx, t_docId docId, RSIndexResult **hit) {
+  GeoNearestIterator *it = ctx;
+  if (!it->resultsPrepared) {
+    gniPrepare(it);
+    // Parents skipping into this iterator do not handle timeouts, so just end it early. The
+    // result processor notices the deadline on its own.
+    if (it->timedOut) {
+      it->base.isValid = 0;
+    }
+  }
+  if (!it->base.isValid) {
+    return INDEXREAD_EOF;
+  }
+  // Find the first result not below docId
+  size_t lo = it->offset, hi = it->results.size;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (it->results.entries[mid].id < docId) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  it->offset = lo;
+  if (it->offset >= it->results.size) {
+    it->base.isValid = 0;
+    return INDEXREAD_EOF;
+  }
+  gniSetCurrent(it, hit);
+  return it->lastDocId == docId ? INDEXREAD_OK : INDEXREAD_NOTFOUND;
+}
+
+static t_docId GNI_LastDocId(void *ctx) {
+  return ((GeoNearestIterator *)ctx)->lastDocId;
+}
+
+static size_t GNI_NumEstimated(void *ctx) {
+  GeoNearestIterator *it = ctx;
+  return it->resultsPrepared ? it->results.size : it->gf->k;
+}
+
+static void GNI_Abort(void *ctx) {
+  ((GeoNearestIterator *)ctx)->base.isValid = 0;
+}
+
+static void GNI_Rewind(void *ctx) {
+  GeoNearestIterator *it = ctx;
+  it->base.isValid = 1;
+  it->offset = 0;
+  it->lastDocId = 0;
+  it->base.current->docId = 0;
+}
+
+static void GNI_Free(IndexIterator *self) {
+  GeoNearestIterator *it = self->ctx;
+  if (it->child) {
+    it->child->Free(it->child);
+  }
+  IndexResult_Free(it->base.current);
+  DistHeap_Free(&it->results);
+  rm_free(it);
+}
+
+IndexIterator *NewGeoNearestIterator(RedisSearchCtx *ctx, const GeoFilter *gf,
+                                     IndexIterator *child) {
+  GeoNearestIterator *it = rm_calloc(1, sizeof(*it));
+  it->child = child;
+  it->sctx = ctx;
+  it->gf = gf;
+  it->timeoutCtx = (TimeoutCtx){.timeout = ctx->timeout, .counter = 0};
+  DistHeap_Init(&it->results, gf->k);
+
+  IndexIterator *ret = &it->base;
+  ret->ctx = it;
+  ret->isValid = 1;
+  ret->current = NewDistanceResult();
+  ret->type = GEO_NEAREST_ITERATOR;
+  ret->mode = MODE_SORTED;
+  ret->NumEstimated = GNI_NumEstimated;
+  ret->GetCriteriaTester = NULL;
+  ret->Read = GNI_Read;
+  ret->SkipTo = GNI_SkipTo;
+  ret->LastDocId = GNI_LastDocId;
+  ret->HasNext = NULL;
+  ret->Free = GNI_Free;
+  ret->Len = GNI_NumEstimated;
+  ret->Abort = GNI_Abort;
+  ret->Rewind = GNI_Rewind;
+  return ret;
+}
+
 GeoDistance GeoDistance_Parse(const char *s) {
 #define X(c, val)            \
   if (!strcasecmp(val, s)) { \
@@ -213,6 +504,18 @@ int GeoFilter_Validate(const GeoFilter *gf, QueryError *status) {
     return 0;
   }
 
+  if (gf->type == GEO_FILTER_BBOX || gf->type == GEO_FILTER_POLYGON) {
+    if (gf->minLat < -90 || gf->maxLat > 90 || gf->minLon < -180 || gf->maxLon > 180) {
+      QERR_MKSYNTAXERR(status, "Invalid GeoFilter lat/lon");
+      return 0;
+    }
+    if (gf->minLon > gf->maxLon || gf->minLat > gf->maxLat) {
+      QERR_MKSYNTAXERR(status, "Invalid GeoFilter bounding box");
+      return 0;
+    }
+    return 1;
+  }
+
   // validate lat/lon
   if (gf->lat > 90 || gf->lat < -90 || gf->lon > 180 || gf->lon < -180) {
     QERR_MKSYNTAXERR(status, "Invalid GeoFilter lat/lon");
@@ -220,7 +523,7 @@ int GeoFilter_Validate(const GeoFilter *gf, QueryError *status) {
   }
 
   // validate radius
-  if (gf->radius <= 0) {
+  if (gf->type == GEO_FILTER_RADIUS && gf->radius <= 0) {
     QERR_MKSYNTAXERR(status, "Invalid GeoFilter radius");
     return 0;
   }
@@ -266,21 +569,6 @@ static double extractUnitFactor(GeoDistance unit) {
   return rv;
 }
 
-/**
- * Populates the numeric range to search for within a given square direction
- * specified by `dir`
- */
-static int populateRange(const GeoFilter *gf, GeoHashRange *ranges) {
-  double xy[2] = {gf->lon, gf->lat};
-
-  double radius_meters = gf->radius * extractUnitFactor(gf->unitType);
-  if (radius_meters < 0) {
-    return -1;
-  }
-  calcRanges(gf->lon, gf->lat, radius_meters, ranges);
-  return 0;
-}
-
 /**
  * Checks if the given coordinate d is within the radius gf
  */
@@ -292,15 +580,28 @@ int isWithinRadius(const GeoFilter *gf, double d, double *distance) {
   return rv;
 }
 
-static int checkResult(const GeoFilter *gf, const RSIndexResult *cur) {
-  double distance;
-  if (cur->type == RSResultType_Numeric) {
-    return isWithinRadius(gf, cur->num.value, &distance);
+/**
+ * Point in polygon test by ray casting: count the edges crossed by a ray going east from the
+ * point. The loop is branch free over the polygon's coordinate arrays, so it vectorizes.
+ */
+static int isWithinPolygon(const GeoFilter *gf, double lon, double lat) {
+  const double *x = gf->polyLon, *y = gf->polyLat, *slope = gf->polySlope;
+  int crossings = 0;
+  for (size_t ii = 0; ii < gf->numVertices; ++ii) {
+    crossings += ((y[ii] > lat) != (y[ii + 1] > lat)) & (lon < x[ii] + slope[ii] * (lat - y[ii]));
+  }
+  return crossings & 1;
+}
+
+int GeoFilter_Match(const GeoFilter *gf, double d) {
+  if (gf->type == GEO_FILTER_RADIUS) {
+    return isWithinRadius(gf, d, NULL);
   }
-  for (size_t ii = 0; ii < cur->agg.numChildren; ++ii) {
-    if (checkResult(gf, cur->agg.children[ii])) {
-      return 1;
-    }
+
+  double xy[2];
+  decodeGeo(d, xy);
+  if (xy[0] < gf->minLon || xy[0] > gf->maxLon || xy[1] < gf->minLat || xy[1] > gf->maxLat) {
+    return 0;
   }
-  return 0;
+  return gf->type == GEO_FILTER_BBOX || isWithinPolygon(gf, xy[0], xy[1]);
 }
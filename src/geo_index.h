@@ -10,13 +10,8 @@
 #include "rs_geo.h"
 #include "numeric_index.h"
 #include "query_node.h"
-
-typedef struct geoIndex {
-  RedisSearchCtx *ctx;
-  const FieldSpec *sp;
-} GeoIndex;
-
-#define GEOINDEX_KEY_FMT "geo:%s/%s"
+#include "util/dist_heap.h"
+#include "util/timeout.h"
 
 typedef enum {  // Placeholder for bad/invalid unit
   GEO_DISTANCE_INVALID = -1,
@@ -31,15 +26,63 @@ typedef enum {  // Placeholder for bad/invalid unit
 #undef X
 } GeoDistance;
 
+typedef enum {
+  GEO_FILTER_RADIUS = 0,
+  GEO_FILTER_BBOX,
+  GEO_FILTER_POLYGON,
+  GEO_FILTER_NEAREST,
+} GeoFilterType;
+
 typedef struct GeoFilter {
   const char *property;
+  GeoFilterType type;
+
+  // GEO_FILTER_RADIUS and GEO_FILTER_NEAREST
   double lat;
   double lon;
   double radius;
   GeoDistance unitType;
+
+  // GEO_FILTER_BBOX and GEO_FILTER_POLYGON: the bounding box of the shape
+  double minLon;
+  double minLat;
+  double maxLon;
+  double maxLat;
+
+  // GEO_FILTER_POLYGON: the vertices, closed (the first vertex is repeated at numVertices), and
+  // the lon/lat slope of each edge. All three arrays share the allocation of polyLon.
+  double *polyLon;
+  double *polyLat;
+  double *polySlope;
+  size_t numVertices;
+
+  // GEO_FILTER_NEAREST: the number of documents to return, and the field their distance (in
+  // meters) is yielded as
+  size_t k;
+  char *distField;
+
   NumericFilter **numericFilters;
 } GeoFilter;
 
+/* Returns the k documents nearest to a point, in docId order, as distance results.
+ * The documents are collected on the first read by scanning growing radiuses around the point,
+ * until the k nearest ones are known to be found. When a child iterator is given, only its
+ * documents are considered. The first read returns INDEXREAD_TIMEOUT if the query times out
+ * while scanning. */
+typedef struct {
+  IndexIterator base;
+  IndexIterator *child;
+  RedisSearchCtx *sctx;
+  const GeoFilter *gf;
+  int resultsPrepared;
+  DistHeap results;           // sorted by docId once prepared
+  size_t offset;
+  t_docId lastDocId;
+  size_t numRounds;           // the number of radiuses scanned
+  TimeoutCtx timeoutCtx;
+  int timedOut;
+} GeoNearestIterator;
+
 /* Create a geo filter from parsed strings and numbers */
 GeoFilter *NewGeoFilter(double lon, double lat, double radius, const char *unit, size_t unit_len);
 
@@ -66,9 +109,14 @@ int GeoFilter_Validate(const GeoFilter *gf, QueryError *status);
 int GeoFilter_Parse(GeoFilter *gf, ArgsCursor *ac, QueryError *status);
 void GeoFilter_Free(GeoFilter *gf);
 IndexIterator *NewGeoRangeIterator(RedisSearchCtx *ctx, const GeoFilter *gf);
+IndexIterator *NewGeoNearestIterator(RedisSearchCtx *ctx, const GeoFilter *gf,
+                                     IndexIterator *child);
 
 /*****************************************************************************/
 
 #define INVALID_GEOHASH -1.0
 double calcGeoHash(double lon, double lat);
 int isWithinRadius(const GeoFilter *gf, double d, double *distance);
+
+/* Check if the geohash encoded point d lies within the filter's shape */
+int GeoFilter_Match(const GeoFilter *gf, double d);
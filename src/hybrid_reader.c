@@ -2,6 +2,7 @@
 #include "hybrid_reader.h"
 #include "VecSim/vec_sim.h"
 #include "VecSim/query_results.h"
+#include "rmutil/cxx/chrono-clock.h"
 
 #define VECTOR_RESULT(p) (p->type == RSResultType_Distance ? p : p->agg.children[0])
 
@@ -63,6 +64,23 @@ static int HR_ReadInBatch(void *ctx, RSIndexResult **hit) {
   return INDEXREAD_OK;
 }
 
+static void rewindChild(HybridIterator *hr) {
+  hr->child->Rewind(hr->child->ctx);
+  hr->stats.numChildRewinds++;
+}
+
+// Replace the current list of vector results with the next one from the vector index.
+static void setResultsList(HybridIterator *hr, VecSimQueryResult_List list) {
+  VecSimQueryResult_Free(hr->list);
+  if (hr->iter) {
+    VecSimQueryResult_IteratorFree(hr->iter);
+    hr->iter = NULL;
+  }
+  hr->list = list;
+  hr->iter = VecSimQueryResult_List_GetIterator(hr->list);
+  hr->stats.numVectorsFetched += VecSimQueryResult_Len(hr->list);
+}
+
 static void insertResultToHeap(HybridIterator *hr, RSIndexResult *res, RSIndexResult *child_res,
                                RSIndexResult *vec_res, double *upper_bound) {
 
@@ -89,6 +107,7 @@ static void insertResultToHeap(HybridIterator *hr, RSIndexResult *res, RSIndexRe
   }
   // Insert to heap, update the distance upper bound.
   heap_offerx(hr->topResults, hit);
+  hr->stats.numHeapInsertions++;
   RSIndexResult *top = heap_peek(hr->topResults);
   *upper_bound = VECTOR_RESULT(top)->dist.distance;
   // Reset the current result.
@@ -136,41 +155,73 @@ static void alternatingIterate(HybridIterator *hr, VecSimQueryResult_Iterator *v
   IndexResult_Free(cur_vec_res);
 }
 
-void computeDistances(HybridIterator *hr) {
+// Build the heavyweight results of the k nearest ids kept by computeDistances.
+static void materializeTopResults(HybridIterator *hr, DistHeap *top) {
   double upper_bound = INFINITY;
   RSIndexResult *cur_res = hr->base.current;
-  RSIndexResult *cur_child_res;  // This will use the memory of hr->child->current.
+  RSIndexResult *cur_child_res = NULL;
   RSIndexResult *cur_vec_res = NewDistanceResult();
-  void *qvector = hr->query.vector;
+  cur_vec_res->dist.scoreField = hr->scoreField;
 
-  if (hr->indexMetric == VecSimMetric_Cosine) {
-    qvector = rm_malloc(hr->dimension * VecSimType_sizeof(hr->vecType));
-    memcpy(qvector, hr->query.vector, hr->dimension * VecSimType_sizeof(hr->vecType));
-    VecSim_Normalize(qvector, hr->dimension, hr->vecType);
+  // When the document score is needed, the child results of the winners are read again, so only
+  // k subtrees are ever copied.
+  DistHeap_SortById(top);
+  if (!hr->ignoreScores) {
+    rewindChild(hr);
+  }
+  for (size_t i = 0; i < top->size; i++) {
+    cur_vec_res->docId = top->entries[i].id;
+    cur_vec_res->dist.distance = top->entries[i].distance;
+    if (!hr->ignoreScores &&
+        hr->child->SkipTo(hr->child->ctx, cur_vec_res->docId, &cur_child_res) != INDEXREAD_OK) {
+      continue;
+    }
+    insertResultToHeap(hr, cur_res, cur_child_res, cur_vec_res, &upper_bound);
   }
+  IndexResult_Free(cur_vec_res);
+}
+
+// The query vector in the form the stored vectors are kept in, for computing distances directly
+// against them. Cosine indexes store normalized vectors, so the query is normalized once and the
+// copy is reused by every ad-hoc pass over the lifetime of the iterator, including rewinds.
+static const void *getPreparedQueryVector(HybridIterator *hr) {
+  if (!hr->preparedVector) {
+    if (hr->indexMetric == VecSimMetric_Cosine) {
+      size_t len = hr->dimension * VecSimType_sizeof(hr->vecType);
+      hr->preparedVector = rm_malloc(len);
+      memcpy(hr->preparedVector, hr->query.vector, len);
+      VecSim_Normalize(hr->preparedVector, hr->dimension, hr->vecType);
+    } else {
+      hr->preparedVector = hr->query.vector;
+    }
+  }
+  return hr->preparedVector;
+}
 
+void computeDistances(HybridIterator *hr) {
+  hires_clock_t t0;
+  hires_clock_get(&t0);
+  RSIndexResult *cur_child_res;  // This will use the memory of hr->child->current.
+  const void *qvector = getPreparedQueryVector(hr);
+  DistHeap top;
+  DistHeap_Init(&top, hr->query.k);
+
+  // Keep only (distance, id) pairs until the k nearest are known.
   while (hr->child->Read(hr->child->ctx, &cur_child_res) != INDEXREAD_EOF) {
-    if(TimedOut_WithCtx(&hr->timeoutCtx)) {
+    if (TimedOut_WithCtx(&hr->timeoutCtx)) {
       hr->list.code = VecSim_QueryResult_TimedOut;
       break;
     }
     double dist = VecSimIndex_GetDistanceFrom(hr->index, cur_child_res->docId, qvector);
+    hr->stats.numDistances++;
     // If this id is not in the vector index (since it was deleted), dist will return as NaN.
-    if (isnan(dist)) {
-      continue;
-    }
-    if (heap_count(hr->topResults) < hr->query.k || dist < upper_bound) {
-      // Populate the vector result.
-      cur_vec_res->docId = cur_child_res->docId;
-      cur_vec_res->dist.distance = dist;
-      cur_vec_res->dist.scoreField = hr->scoreField;
-      insertResultToHeap(hr, cur_res, cur_child_res, cur_vec_res, &upper_bound);
+    if (!isnan(dist)) {
+      DistHeap_Offer(&top, cur_child_res->docId, dist);
     }
   }
-  if (qvector != hr->query.vector) {
-    rm_free(qvector);
-  }
-  IndexResult_Free(cur_vec_res);
+  materializeTopResults(hr, &top);
+  DistHeap_Free(&top);
+  hr->stats.adhocTime += hires_clock_since_msec(&t0);
 }
 
 // Review the estimated child results num, and returns true if hybrid policy should change.
@@ -204,18 +255,46 @@ static bool reviewHybridSearchPolicy(HybridIterator *hr, size_t n_res_left, size
     while (heap_count(hr->topResults) > 0) {
       IndexResult_Free(heap_poll(hr->topResults));
     }
-    hr->child->Rewind(hr->child->ctx);
+    rewindChild(hr);
     computeDistances(hr);
     return true;
   }
   return false;
 }
 
-static void prepareResults(HybridIterator *hr) {
-    if (hr->searchMode == VECSIM_STANDARD_KNN) {
-      hr->list =
-          VecSimIndex_TopKQuery(hr->index, hr->query.vector, hr->query.k, &(hr->runtimeParams), hr->query.order);
-      hr->iter = VecSimQueryResult_List_GetIterator(hr->list);
+// Go over the vector results in batches by score, keeping the first k that pass the child's
+// criteria tester. Since the batches come in ascending distance, these are the k nearest.
+static void filteredBatchesIterate(HybridIterator *hr, VecSimBatchIterator *batch_it,
+                                   IndexCriteriaTester *ct, size_t child_num_estimated) {
+  DistHeap top;
+  DistHeap_Init(&top, hr->query.k);
+  while (top.size < hr->query.k && VecSimBatchIterator_HasNext(batch_it)) {
+    hr->numIterations++;
+    size_t n_res_left = hr->query.k - top.size;
+    size_t batch_size = hr->runtimeParams.batchSize;
+    if (batch_size == 0) {
+      batch_size = n_res_left * ((float)VecSimIndex_IndexSize(hr->index) / child_num_estimated) + 1;
+    }
+    setResultsList(hr, VecSimBatchIterator_Next(batch_it, batch_size, BY_SCORE));
+    if (hr->list.code == VecSim_QueryResult_TimedOut) {
+      break;
+    }
+    while (top.size < hr->query.k && VecSimQueryResult_IteratorHasNext(hr->iter)) {
+      VecSimQueryResult *res = VecSimQueryResult_IteratorNext(hr->iter);
+      t_docId id = VecSimQueryResult_GetId(res);
+      if (ct->Test(ct, id)) {
+        DistHeap_Offer(&top, id, VecSimQueryResult_GetScore(res));
+      }
+    }
+  }
+  materializeTopResults(hr, &top);
+  DistHeap_Free(&top);
+}
+
+static void prepareResultsByMode(HybridIterator *hr) {
+  if (hr->searchMode == VECSIM_STANDARD_KNN) {
+    setResultsList(hr, VecSimIndex_TopKQuery(hr->index, hr->query.vector, hr->query.k,
+                                             &(hr->runtimeParams), hr->query.order));
     return;
   }
 
@@ -236,6 +315,18 @@ static void prepareResults(HybridIterator *hr) {
     child_num_estimated = VecSimIndex_IndexSize(hr->index);
   }
   size_t child_upper_bound = child_num_estimated;
+
+  // If the child can test ids on its own, filter the batches in a single pass instead of
+  // rewinding and intersecting with the child for every batch.
+  IndexCriteriaTester *ct = IITER_GET_CRITERIA_TESTER(hr->child);
+  if (ct) {
+    hr->searchMode = VECSIM_HYBRID_BATCHES_FILTERED;
+    filteredBatchesIterate(hr, batch_it, ct, child_num_estimated);
+    ct->Free(ct);
+    VecSimBatchIterator_Free(batch_it);
+    return;
+  }
+
   while (VecSimBatchIterator_HasNext(batch_it)) {
     hr->numIterations++;
     size_t vec_index_size = VecSimIndex_IndexSize(hr->index);
@@ -246,18 +337,12 @@ static void prepareResults(HybridIterator *hr) {
     if (batch_size == 0) {
       batch_size = n_res_left * ((float)vec_index_size / child_num_estimated) + 1;
     }
-    VecSimQueryResult_Free(hr->list);
-    if (hr->iter) {
-      VecSimQueryResult_IteratorFree(hr->iter);
-      hr->iter = NULL;
-    }
     // Get the next batch.
-    hr->list = VecSimBatchIterator_Next(batch_it, batch_size, BY_ID);
+    setResultsList(hr, VecSimBatchIterator_Next(batch_it, batch_size, BY_ID));
     if (hr->list.code == VecSim_QueryResult_TimedOut) {
       break;
     }
-    hr->iter = VecSimQueryResult_List_GetIterator(hr->list);
-    hr->child->Rewind(hr->child->ctx);
+    rewindChild(hr);
 
     // Go over both iterators and save mutual results in the heap.
     alternatingIterate(hr, hr->iter, &upper_bound);
@@ -273,6 +358,13 @@ static void prepareResults(HybridIterator *hr) {
   VecSimBatchIterator_Free(batch_it);
 }
 
+static void prepareResults(HybridIterator *hr) {
+  hires_clock_t t0;
+  hires_clock_get(&t0);
+  prepareResultsByMode(hr);
+  hr->stats.prepareTime += hires_clock_since_msec(&t0);
+}
+
 static int HR_HasNext(void *ctx) {
   HybridIterator *hr = ctx;
   return hr->base.isValid;
@@ -357,7 +449,8 @@ static void HR_Rewind(void *ctx) {
   hr->lastDocId = 0;
   hr->base.isValid = 1;
 
-  if (hr->searchMode == VECSIM_HYBRID_ADHOC_BF || hr->searchMode == VECSIM_HYBRID_BATCHES) {
+  if (hr->searchMode == VECSIM_HYBRID_ADHOC_BF || hr->searchMode == VECSIM_HYBRID_BATCHES ||
+      hr->searchMode == VECSIM_HYBRID_BATCHES_FILTERED) {
     // Clean the saved and returned results (in case of HYBRID mode).
     while (heap_count(hr->topResults) > 0) {
       IndexResult_Free(heap_poll(hr->topResults));
@@ -366,7 +459,7 @@ static void HR_Rewind(void *ctx) {
       IndexResult_Free(hr->returnedResults[i]);
     }
     array_clear(hr->returnedResults);
-    hr->child->Rewind(hr->child->ctx);
+    rewindChild(hr);
   }
 }
 
@@ -390,6 +483,9 @@ void HybridIterator_Free(struct indexIterator *self) {
   IndexResult_Free(it->base.current);
   VecSimQueryResult_Free(it->list);
   if (it->iter) VecSimQueryResult_IteratorFree(it->iter);
+  if (it->preparedVector != it->query.vector) {
+    rm_free(it->preparedVector);
+  }
   if (it->child) {
     it->child->Free(it->child);
   }
@@ -401,6 +497,7 @@ IndexIterator *NewHybridVectorIterator(HybridIteratorParams hParams) {
   hi->lastDocId = 0;
   hi->child = hParams.childIt;
   hi->resultsPrepared = false;
+  hi->preparedVector = NULL;
   hi->index = hParams.index;
   hi->dimension = hParams.dim;
   hi->vecType = hParams.elementType;
@@ -414,6 +511,7 @@ IndexIterator *NewHybridVectorIterator(HybridIteratorParams hParams) {
   hi->topResults = NULL;
   hi->returnedResults = NULL;
   hi->numIterations = 0;
+  memset(&hi->stats, 0, sizeof(hi->stats));
   hi->ignoreScores = hParams.ignoreDocScore;
   hi->timeoutCtx = (TimeoutCtx){ .timeout = hParams.timeout, .counter = 0 };
   hi->runtimeParams.timeoutCtx = &hi->timeoutCtx;
@@ -477,3 +575,21 @@ IndexIterator *NewHybridVectorIterator(HybridIteratorParams hParams) {
   }
   return ri;
 }
+
+const char *VecSimSearchMode_ToString(VecSimSearchMode mode) {
+  switch (mode) {
+    case VECSIM_STANDARD_KNN:
+      return "STANDARD_KNN";
+    case VECSIM_HYBRID_ADHOC_BF:
+      return "HYBRID_ADHOC_BF";
+    case VECSIM_HYBRID_BATCHES:
+      return "HYBRID_BATCHES";
+    case VECSIM_HYBRID_BATCHES_TO_ADHOC_BF:
+      return "HYBRID_BATCHES_TO_ADHOC_BF";
+    case VECSIM_HYBRID_BATCHES_FILTERED:
+      return "HYBRID_BATCHES_FILTERED";
+    case VECSIM_EMPTY_MODE:
+      break;
+  }
+  return "EMPTY_MODE";
+}
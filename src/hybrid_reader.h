@@ -5,6 +5,7 @@
 #include "redisearch.h"
 #include "spec.h"
 #include "util/heap.h"
+#include "util/dist_heap.h"
 #include "util/timeout.h"
 
 // This enum should match the VecSearchMode enum in VecSim
@@ -15,8 +16,11 @@ typedef enum {
                                      // and take the top k results.
   VECSIM_HYBRID_BATCHES,             // Get the top vector results in batches upon demand, and keep the results that
                                      // passes the filters until we reach k results.
-  VECSIM_HYBRID_BATCHES_TO_ADHOC_BF  // Start with batches and dynamically switched to ad-hoc BF.
+  VECSIM_HYBRID_BATCHES_TO_ADHOC_BF, // Start with batches and dynamically switched to ad-hoc BF.
 
+  // Not a VecSim mode - chosen by the hybrid iterator itself when the child can test ids directly:
+  VECSIM_HYBRID_BATCHES_FILTERED     // Get the top vector results in batches by score, and keep the first k
+                                     // that pass the child's criteria tester, without iterating the child.
 } VecSimSearchMode;
 
 typedef struct {
@@ -32,6 +36,16 @@ typedef struct {
   struct timespec timeout;
 } HybridIteratorParams;
 
+// Counters collected for FT.PROFILE
+typedef struct {
+  size_t numVectorsFetched;        // Results returned by the vector index, in KNN and batches modes
+  size_t numDistances;             // Distances computed by the iterator itself, in ad-hoc BF mode
+  size_t numHeapInsertions;        // Insertions to the top results heap
+  size_t numChildRewinds;
+  double prepareTime;              // Milliseconds spent preparing the results
+  double adhocTime;                // Milliseconds of prepareTime spent computing distances ad-hoc
+} HybridIteratorStats;
+
 typedef struct {
   IndexIterator base;
   VecSimIndex *index;
@@ -39,6 +53,8 @@ typedef struct {
   VecSimType vecType;              // index data type
   VecSimMetric indexMetric;        // index distance metric
   KNNVectorQuery query;
+  void *preparedVector;            // The query vector as stored vectors are kept (normalized for
+                                   // cosine), created on first use. May alias query.vector.
   VecSimQueryParams runtimeParams; // Evaluated runtime params.
   IndexIterator *child;
   VecSimSearchMode searchMode;
@@ -54,6 +70,7 @@ typedef struct {
   size_t numIterations;
   bool ignoreScores;               // Ignore the document scores, only vector score matters.
   TimeoutCtx timeoutCtx;           // Timeout parameters
+  HybridIteratorStats stats;
 } HybridIterator;
 
 #ifdef __cplusplus
@@ -62,6 +79,8 @@ extern "C" {
 
 IndexIterator *NewHybridVectorIterator(HybridIteratorParams hParams);
 
+const char *VecSimSearchMode_ToString(VecSimSearchMode mode);
+
 #ifdef __cplusplus
 }
 #endif
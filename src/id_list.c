@@ -28,7 +28,7 @@ static int cmp_docids(const void *p1, const void *p2);
 
 static int IL_Test(struct IndexCriteriaTester *ct, t_docId id) {
   ILCriteriaTester *lct = (ILCriteriaTester *)ct;
-  return bsearch((void *)id, lct->docIds, (size_t)lct->size, sizeof(t_docId), cmp_docids) != NULL;
+  return bsearch(&id, lct->docIds, (size_t)lct->size, sizeof(t_docId), cmp_docids) != NULL;
 }
 
 static void IL_TesterFree(struct IndexCriteriaTester *ct) {
@@ -41,7 +41,7 @@ IndexCriteriaTester *IL_GetCriteriaTester(void *ctx) {
   IdListIterator *it = ctx;
   ILCriteriaTester *ct = rm_malloc(sizeof(*ct));
   ct->docIds = rm_malloc(sizeof(t_docId) * it->size);
-  memcpy(ct->docIds, it->docIds, it->size);
+  memcpy(ct->docIds, it->docIds, sizeof(t_docId) * it->size);
   ct->size = it->size;
   ct->base.Test = IL_Test;
   ct->base.Free = IL_TesterFree;
@@ -12,6 +12,7 @@
 #include "util/heap.h"
 #include "profile.h"
 #include "hybrid_reader.h"
+#include "geo_index.h"
 
 static int UI_SkipTo(void *ctx, t_docId docId, RSIndexResult **hit);
 static int UI_SkipToHigh(void *ctx, t_docId docId, RSIndexResult **hit);
@@ -1910,15 +1911,6 @@ PRINT_PROFILE_FUNC(name) {
   }                                                                                 \
   printProfileCounter(counter);                                                     \
   nlen += 2;                                                                        \
-  if (root->type == HYBRID_ITERATOR) {                                              \
-    HybridIterator *hi = root->ctx;                                                 \
-    if (hi->searchMode == VECSIM_HYBRID_BATCHES ||                                  \
-          hi->searchMode == VECSIM_HYBRID_BATCHES_TO_ADHOC_BF) {                    \
-        printProfileNumBatches(hi);                                                 \
-        nlen += 2;                                                                  \
-    }                                                                               \
-  }                                                                                 \
-                                                                                    \
   if (addChild) {                                                                   \
     RedisModule_ReplyWithSimpleString(ctx, "Child iterator");                       \
     printIteratorProfile(ctx, ((iterType *)root)->child, 0, 0, depth + 1, limited); \
@@ -1927,6 +1919,74 @@ PRINT_PROFILE_FUNC(name) {
   RedisModule_ReplySetArrayLength(ctx, nlen);                                       \
 }
 
+PRINT_PROFILE_FUNC(printHybridIt) {
+  HybridIterator *hi = (HybridIterator *)root;
+  const HybridIteratorStats *stats = &hi->stats;
+  int batches = hi->searchMode == VECSIM_HYBRID_BATCHES ||
+                hi->searchMode == VECSIM_HYBRID_BATCHES_TO_ADHOC_BF ||
+                hi->searchMode == VECSIM_HYBRID_BATCHES_FILTERED;
+  int adhoc = hi->searchMode == VECSIM_HYBRID_ADHOC_BF ||
+              hi->searchMode == VECSIM_HYBRID_BATCHES_TO_ADHOC_BF;
+
+  size_t nlen = 0;
+  RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
+
+  printProfileType("VECTOR");
+  nlen += 2;
+
+  if (PROFILE_VERBOSE) {
+    printProfileTime(cpuTime);
+    nlen += 2;
+  }
+
+  printProfileCounter(counter);
+  nlen += 2;
+
+  if (batches) {
+    printProfileNumBatches(hi);
+    nlen += 2;
+  }
+
+  // The search internals are only printed along with the times, to tune the hybrid policy
+  if (PROFILE_VERBOSE) {
+    RedisModule_ReplyWithSimpleString(ctx, "Search mode");
+    RedisModule_ReplyWithSimpleString(ctx, VecSimSearchMode_ToString(hi->searchMode));
+    RedisModule_ReplyWithSimpleString(ctx, "Vectors fetched");
+    RedisModule_ReplyWithLongLong(ctx, stats->numVectorsFetched);
+    nlen += 4;
+    if (adhoc) {
+      RedisModule_ReplyWithSimpleString(ctx, "Distance computations");
+      RedisModule_ReplyWithLongLong(ctx, stats->numDistances);
+      nlen += 2;
+    }
+    if (hi->child) {
+      RedisModule_ReplyWithSimpleString(ctx, "Heap insertions");
+      RedisModule_ReplyWithLongLong(ctx, stats->numHeapInsertions);
+      RedisModule_ReplyWithSimpleString(ctx, "Child rewinds");
+      RedisModule_ReplyWithLongLong(ctx, stats->numChildRewinds);
+      nlen += 4;
+    }
+    if (batches) {
+      RedisModule_ReplyWithSimpleString(ctx, "Batches time");
+      RedisModule_ReplyWithDouble(ctx, stats->prepareTime - stats->adhocTime);
+      nlen += 2;
+    }
+    if (adhoc) {
+      RedisModule_ReplyWithSimpleString(ctx, "Ad-hoc BF time");
+      RedisModule_ReplyWithDouble(ctx, stats->adhocTime);
+      nlen += 2;
+    }
+  }
+
+  if (hi->child) {
+    RedisModule_ReplyWithSimpleString(ctx, "Child iterator");
+    printIteratorProfile(ctx, hi->child, 0, 0, depth + 1, limited);
+    nlen += 2;
+  }
+
+  RedisModule_ReplySetArrayLength(ctx, nlen);
+}
+
 typedef struct {
   IndexIterator base;
   IndexIterator *child;
@@ -1937,7 +1997,9 @@ PRINT_PROFILE_SINGLE(printOptionalIt, OptionalIterator, "OPTIONAL", 1);
 PRINT_PROFILE_SINGLE(printWildcardIt, DummyIterator, "WILDCARD", 0);
 PRINT_PROFILE_SINGLE(printIdListIt, DummyIterator, "ID-LIST", 0);
 PRINT_PROFILE_SINGLE(printEmptyIt, DummyIterator, "EMPTY", 0);
-PRINT_PROFILE_SINGLE(printHybridIt, HybridIterator, "VECTOR", 1);
+PRINT_PROFILE_SINGLE(printGeoNearestIt, GeoNearestIterator, "GEO-NEAREST", 1);
+PRINT_PROFILE_SINGLE(printVectorRangeIt, DummyIterator, "VECTOR-RANGE", 0);
+PRINT_PROFILE_SINGLE(printVectorTopKIt, DummyIterator, "VECTOR-TOPK", 0);
 
 PRINT_PROFILE_FUNC(printProfileIt) {
   ProfileIterator *pi = (ProfileIterator *)root;
@@ -1968,6 +2030,9 @@ void printIteratorProfile(RedisModuleCtx *ctx, IndexIterator *root, size_t count
     case ID_LIST_ITERATOR:    { printIdListIt(ctx, root, counter, cpuTime, depth, limited);     break; }
     case PROFILE_ITERATOR:    { printProfileIt(ctx, root, 0, 0, depth, limited);                break; }
     case HYBRID_ITERATOR:     { printHybridIt(ctx, root, counter, cpuTime, depth, limited);     break; }
+    case GEO_NEAREST_ITERATOR:{ printGeoNearestIt(ctx, root, counter, cpuTime, depth, limited); break; }
+    case VECTOR_RANGE_ITERATOR:{ printVectorRangeIt(ctx, root, counter, cpuTime, depth, limited); break; }
+    case VECTOR_TOPK_ITERATOR: { printVectorTopKIt(ctx, root, counter, cpuTime, depth, limited); break; }
     case MAX_ITERATOR:        { RS_LOG_ASSERT(0, "nope");   break; }
   }
 }
@@ -1990,6 +2055,9 @@ void Profile_AddIters(IndexIterator **root) {
     case HYBRID_ITERATOR:
       Profile_AddIters(&((HybridIterator *)((*root)->ctx))->child);
       break;
+    case GEO_NEAREST_ITERATOR:
+      Profile_AddIters(&((GeoNearestIterator *)((*root)->ctx))->child);
+      break;
     case UNION_ITERATOR:
       ui = (*root)->ctx;
       for (int i = 0; i < ui->norig; i++) {
@@ -2007,6 +2075,8 @@ void Profile_AddIters(IndexIterator **root) {
     case READ_ITERATOR:
     case EMPTY_ITERATOR:
     case ID_LIST_ITERATOR:
+    case VECTOR_RANGE_ITERATOR:
+    case VECTOR_TOPK_ITERATOR:
       break;
     case PROFILE_ITERATOR:
     case MAX_ITERATOR:
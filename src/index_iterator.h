@@ -24,6 +24,9 @@ enum iteratorType {
   EMPTY_ITERATOR,
   ID_LIST_ITERATOR,
   PROFILE_ITERATOR,
+  GEO_NEAREST_ITERATOR,
+  VECTOR_RANGE_ITERATOR,
+  VECTOR_TOPK_ITERATOR,
   MAX_ITERATOR,
 };
 
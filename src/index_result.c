@@ -456,7 +456,8 @@ int __indexResult_withinRangeUnordered(RSOffsetIterator *iters, uint32_t *positi
 int IndexResult_IsWithinRange(RSIndexResult *ir, int maxSlop, int inOrder) {
 
   // check if calculation is even relevant here...
-  if ((ir->type & (RSResultType_Term | RSResultType_Virtual | RSResultType_Numeric)) ||
+  if ((ir->type & (RSResultType_Term | RSResultType_Virtual | RSResultType_Numeric |
+                   RSResultType_Distance)) ||
       ir->agg.numChildren <= 1) {
     return 1;
   }
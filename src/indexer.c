@@ -31,6 +31,12 @@ static void writeIndexEntry(IndexSpec *spec, InvertedIndex *idx, IndexEncoder en
     spec->stats.offsetVecsSize += VVW_GetByteLength(entry->vw);
     spec->stats.offsetVecRecords += VVW_GetCount(entry->vw);
   }
+
+  // Keep the term's score close to its document frequency. It is only updated when the frequency
+  // doubles, the GC sets the exact value when it repairs the index
+  if (idx->numDocs > 1 && !(idx->numDocs & (idx->numDocs - 1))) {
+    IndexSpec_SetTermFrequency(spec, entry->term, entry->len, idx->numDocs);
+  }
 }
 
 // Number of terms for each block-allocator block
@@ -236,7 +242,7 @@ static void writeCurEntries(DocumentIndexer *indexer, RSAddDocumentCtx *aCtx, Re
       }
     }
     
-    if (spec->suffixMask & entry->fieldMask && entry->term[0] != STEM_PREFIX
+    if (spec->suffix && spec->suffixMask & entry->fieldMask && entry->term[0] != STEM_PREFIX
                                             && entry->term[0] != PHONETIC_PREFIX
                                             && entry->term[0] != SYNONYM_PREFIX_CHAR) {
       addSuffixTrie(spec->suffix, entry->term, entry->len);
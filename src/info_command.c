@@ -95,6 +95,52 @@ static int renderIndexDefinitions(RedisModuleCtx *ctx, IndexSpec *sp) {
   return 2;
 }
 
+static void renderVectorIndexStats(RedisModuleCtx *ctx, IndexSpec *sp) {
+  RedisModule_ReplyWithSimpleString(ctx, "vector_index_stats");
+  RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
+  size_t nfields = 0;
+  for (int i = 0; i < sp->numFields; i++) {
+    const FieldSpec *fs = sp->fields + i;
+    if (!FIELD_IS(fs, INDEXFLD_T_VECTOR)) {
+      continue;
+    }
+    // The vector index is only created with the first vector
+    RedisModuleString *key = RedisModule_CreateString(ctx, fs->name, strlen(fs->name));
+    KeysDictValue *kdv = dictFetchValue(sp->keysDict, key);
+    RedisModule_FreeString(ctx, key);
+    if (!kdv) {
+      continue;
+    }
+
+    VecSimIndexInfo info = VecSimIndex_Info(kdv->p);
+    size_t numVectors = 0, memory = 0;
+    RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
+    int n = 0;
+    REPLY_KVSTR(n, "attribute", fs->name);
+    switch (info.algo) {
+      case VecSimAlgo_BF:
+        REPLY_KVSTR(n, "algorithm", VECSIM_ALGORITHM_BF);
+        numVectors = info.bfInfo.indexSize;
+        memory = info.bfInfo.memory;
+        break;
+      case VecSimAlgo_HNSWLIB:
+        REPLY_KVSTR(n, "algorithm", VECSIM_ALGORITHM_HNSW);
+        numVectors = info.hnswInfo.indexSize;
+        memory = info.hnswInfo.memory;
+        break;
+    }
+    REPLY_KVINT(n, "num_vectors", numVectors);
+    REPLY_KVNUM(n, "memory_sz_mb", memory / (float)0x100000);
+    REPLY_KVNUM(n, "bytes_per_vector_avg", numVectors ? (float)memory / numVectors : 0);
+    if (info.algo == VecSimAlgo_HNSWLIB) {
+      REPLY_KVINT(n, "max_level", (long long)info.hnswInfo.max_level);
+    }
+    RedisModule_ReplySetArrayLength(ctx, n);
+    nfields++;
+  }
+  RedisModule_ReplySetArrayLength(ctx, nfields);
+}
+
 /* FT.INFO {index}
  *  Provide info and stats about an index
  */
@@ -198,6 +244,10 @@ int IndexInfoCommand(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
   REPLY_KVNUM(n, "sortable_values_size_mb", sp->docs.sortablesSize / (float)0x100000);
 
   REPLY_KVNUM(n, "key_table_size_mb", TrieMap_MemUsage(sp->docs.dim.tm) / (float)0x100000);
+  REPLY_KVNUM(n, "terms_snapshot_size_mb",
+              sp->termsSnapshot ? TermsSnapshot_MemUsage(sp->termsSnapshot) / (float)0x100000 : 0);
+  REPLY_KVNUM(n, "suffix_array_size_mb",
+              sp->suffixArray ? SuffixArray_MemUsage(sp->suffixArray) / (float)0x100000 : 0);
   REPLY_KVNUM(n, "records_per_doc_avg",
               (float)sp->stats.numRecords / (float)sp->stats.numDocuments);
   REPLY_KVNUM(n, "bytes_per_record_avg",
@@ -216,6 +266,11 @@ int IndexInfoCommand(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 
   REPLY_KVINT(n, "number_of_uses", sp->counter);
 
+  if (sp->flags & Index_HasVecSim) {
+    renderVectorIndexStats(ctx, sp);
+    n += 2;
+  }
+
   if (sp->gc) {
     RedisModule_ReplyWithSimpleString(ctx, "gc_stats");
     GCContext_RenderStats(sp->gc, ctx);
@@ -20,6 +20,8 @@
 #include "ext/default.h"
 #include "rwlock.h"
 #include "json.h"
+#include "stemmer.h"
+#include "trie/levenshtein.h"
 #include "VecSim/vec_sim.h"
 
 #ifndef RS_NO_ONLOAD
@@ -123,6 +125,26 @@ void RS_moduleInfoFunc(RedisModuleInfoCtx *ctx, int for_crash_report) {
   // Fields statistics
   FieldsGlobalStats_AddToInfo(ctx);
 
+  // Stemmer cache statistics
+  StemmerCacheStats stemStats;
+  Stemmer_GetCacheStats(&stemStats);
+  RedisModule_InfoAddSection(ctx, "stemmer_cache");
+  RedisModule_InfoAddFieldULongLong(ctx, "lookups", stemStats.lookups);
+  RedisModule_InfoAddFieldULongLong(ctx, "hits", stemStats.hits);
+  RedisModule_InfoAddFieldULongLong(ctx, "skipped", stemStats.skipped);
+  RedisModule_InfoAddFieldDouble(ctx, "hit_rate",
+                                 stemStats.lookups ? (double)stemStats.hits / stemStats.lookups : 0);
+
+  // Fuzzy matching DFA cache statistics
+  LevenshteinDFACacheStats dfaStats;
+  LevenshteinDFA_GetCacheStats(&dfaStats);
+  RedisModule_InfoAddSection(ctx, "fuzzy_dfa_cache");
+  RedisModule_InfoAddFieldULongLong(ctx, "lookups", dfaStats.lookups);
+  RedisModule_InfoAddFieldULongLong(ctx, "hits", dfaStats.hits);
+  RedisModule_InfoAddFieldULongLong(ctx, "cached_dfas", dfaStats.size);
+  RedisModule_InfoAddFieldDouble(ctx, "hit_rate",
+                                 dfaStats.lookups ? (double)dfaStats.hits / dfaStats.lookups : 0);
+
   // Run time configuration
   RSConfig_AddToInfo(ctx);
 
@@ -24,7 +24,9 @@
 #include "debug_commads.h"
 #include "spell_check.h"
 #include "dictionary.h"
+#include "trie/levenshtein.h"
 #include "suggest.h"
+#include "stemmer.h"
 #include "numeric_index.h"
 #include "redisearch_api.h"
 #include "alias.h"
@@ -1094,8 +1096,10 @@ void RediSearch_CleanupModule(void) {
   ConcurrentSearch_ThreadPoolDestroy();
 
   // free global structures
+  Stemmer_FreeThreadLocal();
   Extensions_Free();
   StopWordList_FreeGlobals();
+  LevenshteinDFA_ClearCache();
   FunctionRegistry_Free();
   mempool_free_global();
   IndexAlias_DestroyGlobal(&AliasTable_g);
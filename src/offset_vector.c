@@ -130,9 +130,10 @@ RSOffsetIterator RSIndexResult_IterateOffsets(const RSIndexResult *res) {
     case RSResultType_Term:
       return RSOffsetVector_Iterate(&res->term.offsets, res->term.term);
 
-    // virtual and numeric entries have no offsets and cannot participate
+    // virtual, numeric and distance entries have no offsets and cannot participate
     case RSResultType_Virtual:
     case RSResultType_Numeric:
+    case RSResultType_Distance:
       return _emptyIterator();
 
     case RSResultType_Intersection:
@@ -63,6 +63,7 @@ static double _recursiveProfilePrint(RedisModuleCtx *ctx, ResultProcessor *rp, s
     switch (rp->type) {
       case RP_INDEX:
       case RP_VECSIM:
+      case RP_FUSION:
       case RP_LOADER:
       case RP_SCORER:
       case RP_SORTER:
@@ -303,6 +303,11 @@ QueryNode *NewVectorNode_WithParams(struct QueryParseCtx *q, VectorQueryType typ
       QueryNode_SetParam(q, &ret->params[0], &vq->knn.vector, &vq->knn.vecLen, vec);
       QueryNode_SetParam(q, &ret->params[1], &vq->knn.k, NULL, value);
       break;
+    case VECSIM_QT_RANGE:
+      QueryNode_InitParams(ret, 2);
+      QueryNode_SetParam(q, &ret->params[0], &vq->range.vector, &vq->range.vecLen, vec);
+      QueryNode_SetParam(q, &ret->params[1], &vq->range.radius, NULL, value);
+      break;
     default:
       QueryNode_Free(ret);
       return NULL;
@@ -318,8 +323,9 @@ static void setFilterNode(QueryAST *q, QueryNode *n) {
     // we usually want the numeric range as the "leader" iterator.
     q->root->children = array_ensure_prepend(q->root->children, &n, 1, QueryNode *);
     q->numTokens++;
-  // vector node should always be in the root, so we have a special case here.
-  } else if (q->root->type == QN_VECTOR) {
+  // KNN vector and nearest geo nodes should always be in the root, so we have a special case here.
+  } else if ((q->root->type == QN_VECTOR && q->root->vn.vq->type == VECSIM_QT_KNN) ||
+             (q->root->type == QN_GEO && q->root->gn.gf->type == GEO_FILTER_NEAREST)) {
     // for non-hybrid - add the filter node as the child of the vector node.
     if (QueryNode_NumChildren(q->root) == 0) {
       QueryNode_AddChild(q->root, n);
@@ -341,7 +347,8 @@ static void setFilterNode(QueryAST *q, QueryNode *n) {
   }
 }
 
-void QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *options) {
+int QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *options,
+                          QueryError *status) {
   if (options->numeric) {
     QueryNode *n = NewQueryNode(QN_NUMERIC);
     n->nn.nf = (NumericFilter *)options->numeric;
@@ -350,7 +357,29 @@ void QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *option
   if (options->geo) {
     QueryNode *n = NewQueryNode(QN_GEO);
     n->gn.gf = options->geo;
-    setFilterNode(ast, n);
+    if (options->geo->type == GEO_FILTER_NEAREST) {
+      // The nearest documents are searched among the query's results, so the node becomes the
+      // root, with the query as its child (unless it matches everything anyway). A KNN query
+      // must stay the root to keep its ordering, so the two cannot be combined.
+      if (ast->root && ast->root->type == QN_VECTOR && ast->root->vn.vq->type == VECSIM_QT_KNN) {
+        QueryNode_Free(n);
+        QueryError_SetError(status, QUERY_EGENERIC,
+                            "GEOFILTER NEAREST cannot be combined with a KNN query");
+        return REDISMODULE_ERR;
+      }
+      if (!ast->root) {
+        QueryNode_Free(n);
+      } else {
+        if (ast->root->type == QN_WILDCARD) {
+          QueryNode_Free(ast->root);
+        } else {
+          QueryNode_AddChild(n, ast->root);
+        }
+        ast->root = n;
+      }
+    } else {
+      setFilterNode(ast, n);
+    }
   }
   if (options->ids) {
     QueryNode *n = NewQueryNode(QN_IDS);
@@ -358,6 +387,7 @@ void QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *option
     n->fn.len = options->nids;
     setFilterNode(ast, n);
   }
+  return REDISMODULE_OK;
 }
 
 static void QueryNode_Expand(RSQueryTokenExpander expander, RSQueryExpanderCtx *expCtx,
@@ -409,14 +439,105 @@ IndexIterator *Query_EvalTokenNode(QueryEvalCtx *q, QueryNode *qn) {
   return NewReadIterator(ir);
 }
 
+typedef struct {
+  IndexIterator **its;
+  size_t nits;
+  size_t cap;
+  QueryEvalCtx *q;
+  QueryNodeOptions *opts;
+  double weight;
+} ContainsCtx;
+
+static int runeIterCb(const rune *r, size_t n, void *p, void *payload);
+static int charIterCb(const char *s, size_t n, void *p, void *payload);
+
+/* Open a reader for a term of the terms delta trie, unless the snapshot has already yielded it */
+static int deltaIterCb(const char *s, size_t n, void *p, void *payload) {
+  ContainsCtx *ctx = p;
+  if (TermsSnapshot_Contains(ctx->q->sctx->spec->termsSnapshot, s, n)) {
+    return REDISEARCH_OK;
+  }
+  return charIterCb(s, n, p, payload);
+}
+
+static int deltaRuneIterCb(const rune *r, size_t n, void *p, void *payload) {
+  size_t len;
+  char *s = runesToStr(r, n, &len);
+  int rc = deltaIterCb(s, len, p, payload);
+  rm_free(s);
+  return rc;
+}
+
+static void iterateSnapshotTerms(TermsSnapshot *snap, const char *str, int maxDist,
+                                 int prefixMode, ContainsCtx *ctx) {
+  size_t rlen;
+  rune *runes = strToFoldedRunes(str, &rlen);
+  // the same limit Trie_Iterate puts on fuzzy terms
+  if (!runes || (!prefixMode && rlen > TRIE_MAX_PREFIX)) {
+    rm_free(runes);
+    return;
+  }
+  if (prefixMode) {
+    size_t plen;
+    char *prefix = runesToStr(runes, rlen, &plen);
+    TermsSnapshot_IteratePrefix(snap, prefix, plen, charIterCb, ctx);
+    rm_free(prefix);
+  } else {
+    TermsSnapshot_IterateFuzzy(snap, runes, rlen, maxDist, charIterCb, ctx);
+  }
+  rm_free(runes);
+}
+
+/* Expand a contains or suffix pattern from the suffix array and the terms added since it was
+ * built. Returns 0 if the pattern could not be looked up, and the terms should be scanned */
+static int iterateSuffixArray(IndexSpec *spec, const rune *str, size_t nstr, SuffixType type,
+                              ContainsCtx *ctx, struct timespec *timeout) {
+  if (!spec->suffixArray || !str) {
+    return 0;
+  }
+  size_t len;
+  char *s = runesToStr(str, nstr, &len);
+  int rc = SuffixArray_IterateContains(spec->suffixArray, s, len, type == SUFFIX_TYPE_SUFFIX,
+                                       charIterCb, ctx, timeout);
+  if (rc) {
+    TrieNode_IterateContains(spec->termsDelta->root, str, nstr, type == SUFFIX_TYPE_CONTAINS, 1,
+                             deltaRuneIterCb, ctx, timeout);
+  }
+  rm_free(s);
+  return rc;
+}
+
+/* Same for a wildcard pattern. The array takes the folded pattern with its escapes, the terms
+ * added since it was built are matched against the unescaped runes */
+static int iterateSuffixArrayWildcard(IndexSpec *spec, const char *pattern, size_t plen,
+                                      const rune *str, size_t nstr, ContainsCtx *ctx,
+                                      struct timespec *timeout) {
+  if (!spec->suffixArray || !pattern) {
+    return 0;
+  }
+  int rc = SuffixArray_IterateWildcard(spec->suffixArray, pattern, plen, charIterCb, ctx, timeout);
+  if (rc) {
+    TrieNode_IterateWildcard(spec->termsDelta->root, str, nstr, deltaRuneIterCb, ctx, timeout);
+  }
+  return rc;
+}
+
 static IndexIterator *iterateExpandedTerms(QueryEvalCtx *q, Trie *terms, const char *str,
                                            size_t len, int maxDist, int prefixMode,
                                            QueryNodeOptions *opts) {
-  TrieIterator *it = Trie_Iterate(terms, str, len, maxDist, prefixMode);
-  if (!it) return NULL;
+  IndexSpec *spec = q->sctx->spec;
+  ContainsCtx ctx = {.q = q, .opts = opts};
+  ctx.cap = 8;
+  ctx.its = rm_malloc(sizeof(*ctx.its) * ctx.cap);
+  ctx.nits = 0;
 
-  size_t itsSz = 0, itsCap = 8;
-  IndexIterator **its = rm_calloc(itsCap, sizeof(*its));
+  // expand the snapshot first, then only the terms added since it was built
+  if (spec->termsSnapshot) {
+    iterateSnapshotTerms(spec->termsSnapshot, str, maxDist, prefixMode, &ctx);
+    terms = spec->termsDelta;
+  }
+
+  TrieIterator *it = Trie_Iterate(terms, str, len, maxDist, prefixMode);
 
   rune *rstr = NULL;
   t_len slen = 0;
@@ -424,61 +545,33 @@ static IndexIterator *iterateExpandedTerms(QueryEvalCtx *q, Trie *terms, const c
   int dist = 0;
 
   // an upper limit on the number of expansions is enforced to avoid stuff like "*"
-  while (TrieIterator_Next(it, &rstr, &slen, NULL, &score, &dist) &&
-         (itsSz < RSGlobalConfig.maxPrefixExpansions)) {
-
-    // Create a token for the reader
-    RSToken tok = (RSToken){
-        .expanded = 0,
-        .flags = 0,
-        .len = 0,
-    };
-    tok.str = runesToStr(rstr, slen, &tok.len);
+  while (it && ctx.nits < RSGlobalConfig.maxPrefixExpansions &&
+         TrieIterator_Next(it, &rstr, &slen, NULL, &score, &dist)) {
+    size_t tlen;
+    char *tstr = runesToStr(rstr, slen, &tlen);
     if (q->sctx && q->sctx->redisCtx) {
-      RedisModule_Log(q->sctx->redisCtx, "debug", "Found fuzzy expansion: %s %f", tok.str, score);
+      RedisModule_Log(q->sctx->redisCtx, "debug", "Found fuzzy expansion: %s %f", tstr, score);
     }
-
-    RSQueryTerm *term = NewQueryTerm(&tok, q->tokenId++);
-
-    // Open an index reader
-    IndexReader *ir = Redis_OpenReader(q->sctx, term, &q->sctx->spec->docs, 0,
-                                       q->opts->fieldmask & opts->fieldMask, q->conc, 1);
-
-    rm_free(tok.str);
-    if (!ir) {
-      Term_Free(term);
-      continue;
-    }
-
-    // Add the reader to the iterator array
-    its[itsSz++] = NewReadIterator(ir);
-    if (itsSz == itsCap) {
-      itsCap *= 2;
-      its = rm_realloc(its, itsCap * sizeof(*its));
+    int rc = spec->termsSnapshot ? deltaIterCb(tstr, tlen, &ctx, NULL)
+                                 : charIterCb(tstr, tlen, &ctx, NULL);
+    rm_free(tstr);
+    if (rc == REDISEARCH_ERR) {
+      break;
     }
   }
 
-  TrieIterator_Free(it);
+  if (it) {
+    TrieIterator_Free(it);
+  }
   // printf("Expanded %d terms!\n", itsSz);
-  if (itsSz == 0) {
-    rm_free(its);
+  if (ctx.nits == 0) {
+    rm_free(ctx.its);
     return NULL;
   }
   QueryNodeType type = prefixMode ? QN_PREFIX : QN_FUZZY;
-  return NewUnionIterator(its, itsSz, q->docTable, 1, opts->weight, type, str);
+  return NewUnionIterator(ctx.its, ctx.nits, q->docTable, 1, opts->weight, type, str);
 }
 
-typedef struct {
-  IndexIterator **its;
-  size_t nits;
-  size_t cap;
-  QueryEvalCtx *q;
-  QueryNodeOptions *opts;
-  double weight;
-} ContainsCtx;
-
-static int runeIterCb(const rune *r, size_t n, void *p, void *payload);
-static int charIterCb(const char *s, size_t n, void *p, void *payload);
 
 /* Ealuate a prefix node by expanding all its possible matches and creating one big UNION on all
  * of them.
@@ -511,23 +604,35 @@ static IndexIterator *Query_EvalPrefixNode(QueryEvalCtx *q, QueryNode *qn) {
   ctx.nits = 0;
 
   // spec support contains queries
-  if (spec->suffix && qn->pfx.suffix) {
+  if ((spec->flags & Index_HasSuffixTrie) && qn->pfx.suffix) {
+    SuffixType type = qn->pfx.prefix ? SUFFIX_TYPE_CONTAINS : SUFFIX_TYPE_SUFFIX;
     // all modifier fields are supported
     if (qn->opts.fieldMask == RS_FIELDMASK_ALL ||
        (spec->suffixMask & qn->opts.fieldMask) == qn->opts.fieldMask) {
-      SuffixCtx sufCtx = {
-        .root = spec->suffix->root,
-        .rune = str,
-        .runelen = nstr,
-        .type = qn->pfx.prefix ? SUFFIX_TYPE_CONTAINS : SUFFIX_TYPE_SUFFIX,
-        .callback = charIterCb,
-        .cbCtx = &ctx,
-
-      };
-      Suffix_IterateContains(&sufCtx);
+      if (spec->suffix) {
+        SuffixCtx sufCtx = {
+          .root = spec->suffix->root,
+          .rune = str,
+          .runelen = nstr,
+          .type = type,
+          .callback = charIterCb,
+          .cbCtx = &ctx,
+
+        };
+        Suffix_IterateContains(&sufCtx);
+      } else if (!iterateSuffixArray(spec, str, nstr, type, &ctx, &q->sctx->timeout)) {
+        // the suffix array is not built yet, or the pattern is too short for it
+        TrieNode_IterateContains(t->root, str, nstr, qn->pfx.prefix, qn->pfx.suffix,
+                                 runeIterCb, &ctx, &q->sctx->timeout);
+      }
     } else {
       QueryError_SetErrorFmt(q->status, QUERY_EGENERIC, "Contains query on fields without WITHSUFFIXTRIE support");
     }
+  } else if (str && qn->pfx.prefix && !qn->pfx.suffix) {
+    // plain prefix: a single walk expands every term, or only the most frequent ones when the
+    // expansion cap would drop some
+    Trie_IterateTopPrefix(t, str, nstr, RSGlobalConfig.maxPrefixExpansions, runeIterCb, &ctx,
+                          &q->sctx->timeout);
   } else {
 
     TrieNode_IterateContains(t->root, str, nstr, qn->pfx.prefix, qn->pfx.suffix,
@@ -560,6 +665,15 @@ static IndexIterator *Query_EvalWildcardQueryNode(QueryEvalCtx *q, QueryNode *qn
     return NULL;
   }
 
+  // the suffix array handles the escapes itself, the tries take the unescaped pattern
+  char *escaped = NULL;
+  size_t nescaped = 0;
+  if (spec->suffixArray) {
+    rune *runes = strToFoldedRunes(token->str, &nescaped);
+    escaped = runes ? runesToStr(runes, nescaped, &nescaped) : NULL;
+    rm_free(runes);
+  }
+
   token->len = Wildcard_RemoveEscape(token->str, token->len);
   size_t nstr;
   rune *str = strToFoldedRunes(token->str, &nstr);
@@ -570,10 +684,15 @@ static IndexIterator *Query_EvalWildcardQueryNode(QueryEvalCtx *q, QueryNode *qn
 
   bool fallbackBruteForce = false;
   // spec support using suffix trie
-  if (spec->suffix) {
+  if (spec->flags & Index_HasSuffixTrie) {
     // all modifier fields are supported
     if (qn->opts.fieldMask == RS_FIELDMASK_ALL ||
        (spec->suffixMask & qn->opts.fieldMask) == qn->opts.fieldMask) {
+      if (!spec->suffix) {
+        fallbackBruteForce = !iterateSuffixArrayWildcard(spec, escaped, nescaped, str, nstr, &ctx,
+                                                         &q->sctx->timeout);
+        goto bruteForce;
+      }
       SuffixCtx sufCtx = {
         .root = spec->suffix->root,
         .rune = str,
@@ -594,10 +713,12 @@ static IndexIterator *Query_EvalWildcardQueryNode(QueryEvalCtx *q, QueryNode *qn
     }
   }
 
-  if (!spec->suffix || fallbackBruteForce) {
+bruteForce:
+  if (!(spec->flags & Index_HasSuffixTrie) || fallbackBruteForce) {
     TrieNode_IterateWildcard(t->root, str, nstr, runeIterCb, &ctx, &q->sctx->timeout);
   }
 
+  rm_free(escaped);
   rm_free(str);
   if (!ctx.its || ctx.nits == 0) {
     rm_free(ctx.its);
@@ -819,7 +940,28 @@ static IndexIterator *Query_EvalGeofilterNode(QueryEvalCtx *q, QueryNode *node,
   if (!fs || !FIELD_IS(fs, INDEXFLD_T_GEO)) {
     return NULL;
   }
-  return NewGeoRangeIterator(q->sctx, node->gn.gf);
+  if (node->gn.gf->type != GEO_FILTER_NEAREST) {
+    return NewGeoRangeIterator(q->sctx, node->gn.gf);
+  }
+
+  IndexIterator *child_it = NULL;
+  if (QueryNode_NumChildren(node) > 0) {
+    RedisModule_Assert(QueryNode_NumChildren(node) == 1);
+    child_it = Query_EvalNode(q, node->children[0]);
+    if (child_it == NULL) {
+      return NULL;
+    }
+  }
+  // The distance is yielded through the same result processor as vector scores, which handles a
+  // single field.
+  if (array_len(*q->vecScoreFieldNamesP)) {
+    QueryError_SetErrorFmt(q->status, QUERY_EGENERIC,
+                           "GEOFILTER NEAREST cannot be combined with a vector query");
+    if (child_it) child_it->Free(child_it);
+    return NULL;
+  }
+  array_ensure_append_1(*q->vecScoreFieldNamesP, node->gn.gf->distField);
+  return NewGeoNearestIterator(q->sctx, node->gn.gf, child_it);
 }
 
 static IndexIterator *Query_EvalVectorNode(QueryEvalCtx *q, QueryNode *qn) {
@@ -839,23 +981,34 @@ static IndexIterator *Query_EvalVectorNode(QueryEvalCtx *q, QueryNode *qn) {
   if (qn->opts.distField) {
     // Since the KNN syntax allows specifying the distance field in two ways (...=>[KNN ... AS <dist_field>] and
     // ...=>[KNN ...]=>{$YIELD_DISTANCE_AS:<dist_field>), we validate that we got it only once.
-    char default_score_field[strlen(qn->vn.vq->property) + 9]; // buffer for __<field>_score
-    sprintf(default_score_field, "__%s_score", qn->vn.vq->property);
-    // If the saved score field is NOT the default one, we return an error, otherwise, just override it.
-    if (strcasecmp(qn->vn.vq->scoreField, default_score_field) != 0) {
-      QueryError_SetErrorFmt(q->status, QUERY_EDUPFIELD, "Distance field was specified twice for vector query: %s and %s",
-                             qn->vn.vq->scoreField, qn->opts.distField);
-      return NULL;
+    // Range queries have no default distance field, so this can only be a KNN field.
+    if (qn->vn.vq->scoreField) {
+      char default_score_field[strlen(qn->vn.vq->property) + 9]; // buffer for __<field>_score
+      sprintf(default_score_field, "__%s_score", qn->vn.vq->property);
+      // If the saved score field is NOT the default one, we return an error, otherwise, just override it.
+      if (strcasecmp(qn->vn.vq->scoreField, default_score_field) != 0) {
+        QueryError_SetErrorFmt(q->status, QUERY_EDUPFIELD, "Distance field was specified twice for vector query: %s and %s",
+                               qn->vn.vq->scoreField, qn->opts.distField);
+        return NULL;
+      }
+      rm_free(qn->vn.vq->scoreField);
     }
-    rm_free(qn->vn.vq->scoreField);
     qn->vn.vq->scoreField = qn->opts.distField; // move ownership
     qn->opts.distField = NULL;
   }
-  // Todo: for range queries, recall that score field may still be NULL, need to handle it also.
 
-  // Add the score field name to the ast score field names array.
-  // This macro creates the array if it's the first name, and ensure its size is sufficient.
-  array_ensure_append_1(*q->vecScoreFieldNamesP, qn->vn.vq->scoreField);
+  // A range query only yields its distance when asked to.
+  if (qn->vn.vq->scoreField) {
+    // The distance is loaded by a single processor, which can only serve one vector node.
+    if (array_len(*q->vecScoreFieldNamesP)) {
+      QueryError_SetError(q->status, QUERY_EGENERIC,
+                          "Only one vector distance field can be yielded per query");
+      return NULL;
+    }
+    // Add the score field name to the ast score field names array.
+    // This macro creates the array if it's the first name, and ensure its size is sufficient.
+    array_ensure_append_1(*q->vecScoreFieldNamesP, qn->vn.vq->scoreField);
+  }
   IndexIterator *child_it = NULL;
   if (QueryNode_NumChildren(qn) > 0) {
     RedisModule_Assert(QueryNode_NumChildren(qn) == 1);
@@ -915,7 +1068,7 @@ typedef IndexIterator **IndexIteratorArray;
 
 static IndexIterator *Query_EvalTagLexRangeNode(QueryEvalCtx *q, TagIndex *idx, QueryNode *qn,
                                                 IndexIteratorArray *iterout, double weight) {
-  TrieMap *t = idx->values;
+  TrieMap *t = TagIndex_GetSortedValues(idx);
   LexRangeCtx ctx = {.q = q, .opts = &qn->opts, .weight = weight};
 
   if (!t) {
@@ -952,13 +1105,13 @@ static IndexIterator *Query_EvalTagPrefixNode(QueryEvalCtx *q, TagIndex *idx, Qu
   if (tok->len < RSGlobalConfig.minTermPrefix) {
     return NULL;
   }
-  if (!idx || !idx->values) return NULL;
+  if (!idx) return NULL;
 
   size_t itsSz = 0, itsCap = 8;
   IndexIterator **its = rm_calloc(itsCap, sizeof(*its));
 
   if (!qn->pfx.suffix || !withSuffixTrie) {    // prefix query or no suffix triemap, use bruteforce
-    TrieMapIterator *it = TrieMap_Iterate(idx->values, tok->str, tok->len);
+    TrieMapIterator *it = TrieMap_Iterate(TagIndex_GetSortedValues(idx), tok->str, tok->len);
     if (!it) return NULL;
     TrieMapIterator_SetTimeout(it, q->sctx->timeout);
     TrieMapIterator_NextFunc nextFunc = TrieMapIterator_Next;
@@ -1039,7 +1192,7 @@ static IndexIterator *Query_EvalTagWildcardNode(QueryEvalCtx *q, TagIndex *idx,
   if (qn->type != QN_WILDCARD_QUERY) {
     return NULL;
   }
-  if (!idx || !idx->values) return NULL;
+  if (!idx) return NULL;
 
   RSToken *tok = &qn->verb.tok;
   tok->len = Wildcard_RemoveEscape(tok->str, tok->len);
@@ -1080,7 +1233,7 @@ static IndexIterator *Query_EvalTagWildcardNode(QueryEvalCtx *q, TagIndex *idx,
 
   if (!idx->suffix || fallbackBruteForce) {
     // brute force wildcard query 
-    TrieMapIterator *it = TrieMap_Iterate(idx->values, tok->str, tok->len);
+    TrieMapIterator *it = TrieMap_Iterate(TagIndex_GetSortedValues(idx), tok->str, tok->len);
     TrieMapIterator_SetTimeout(it, q->sctx->timeout);
     // If there is no '*`, the length is known which can be used for optimization
     it->mode = strchr(tok->str, '*') ? TM_WILDCARD_MODE : TM_WILDCARD_FIXED_LEN_MODE;
@@ -1650,9 +1803,24 @@ static sds QueryNode_DumpSds(sds s, const IndexSpec *spec, const QueryNode *qs,
       break;
     case QN_GEO:
 
-      s = sdscatprintf(s, "GEO %s:{%f,%f --> %f %s", qs->gn.gf->property, qs->gn.gf->lon,
-                       qs->gn.gf->lat, qs->gn.gf->radius,
-                       GeoDistance_ToString(qs->gn.gf->unitType));
+      if (qs->gn.gf->type == GEO_FILTER_RADIUS) {
+        s = sdscatprintf(s, "GEO %s:{%f,%f --> %f %s", qs->gn.gf->property, qs->gn.gf->lon,
+                         qs->gn.gf->lat, qs->gn.gf->radius,
+                         GeoDistance_ToString(qs->gn.gf->unitType));
+      } else if (qs->gn.gf->type == GEO_FILTER_NEAREST) {
+        s = sdscatprintf(s, "GEO %s:{K=%zu nearest to %f,%f, AS `%s`", qs->gn.gf->property,
+                         qs->gn.gf->k, qs->gn.gf->lon, qs->gn.gf->lat, qs->gn.gf->distField);
+        if (QueryNode_NumChildren(qs) > 0) {
+          s = sdscat(s, "\n");
+          s = QueryNode_DumpChildren(s, spec, qs, depth + 1);
+          s = doPad(s, depth);
+        }
+      } else {
+        s = sdscatprintf(s, "GEO %s:{%s %f,%f - %f,%f", qs->gn.gf->property,
+                         qs->gn.gf->type == GEO_FILTER_BBOX ? "BBOX" : "POLYGON",
+                         qs->gn.gf->minLon, qs->gn.gf->minLat, qs->gn.gf->maxLon,
+                         qs->gn.gf->maxLat);
+      }
       break;
     case QN_IDS:
 
@@ -1689,6 +1857,24 @@ static sds QueryNode_DumpSds(sds s, const IndexSpec *spec, const QueryNode *qs,
           }
           break;
         }
+        case VECSIM_QT_RANGE: {
+          s = sdscatprintf(s, "Vectors in range %g of ", qs->vn.vq->range.radius);
+          for (size_t i = 0; i < array_len(qs->params); i++) {
+            if (qs->params[i].type != PARAM_NONE && qs->params[i].target == &qs->vn.vq->range.vector) {
+              s = sdscatprintf(s, "`$%s` ", qs->params[i].name);
+              break;
+            }
+          }
+          s = sdscatprintf(s, "in @%s", qs->vn.vq->property);
+          for (size_t i = 0; i < array_len(qs->vn.vq->params.params); i++) {
+            s = sdscatprintf(s, ", %s = ", qs->vn.vq->params.params[i].name);
+            s = sdscatlen(s, qs->vn.vq->params.params[i].value, qs->vn.vq->params.params[i].valLen);
+          }
+          if (qs->vn.vq->scoreField) {
+            s = sdscatprintf(s, ", AS `%s`", qs->vn.vq->scoreField);
+          }
+          break;
+        }
       }
       break;
     case QN_WILDCARD:
@@ -1781,7 +1967,8 @@ int QueryNode_ForEach(QueryNode *q, QueryNode_ForEachCallback callback, void *ct
 static int QueryVectorNode_ApplyAttribute(VectorQuery *vq, QueryAttribute *attr) {
   if (STR_EQCASE(attr->name, attr->namelen, VECSIM_EFRUNTIME) ||
       STR_EQCASE(attr->name, attr->namelen, VECSIM_HYBRID_POLICY) ||
-      STR_EQCASE(attr->name, attr->namelen, VECSIM_BATCH_SIZE)) {
+      STR_EQCASE(attr->name, attr->namelen, VECSIM_BATCH_SIZE) ||
+      STR_EQCASE(attr->name, attr->namelen, VECSIM_EPSILON)) {
     // Move ownership on the value string, so it won't get freed when releasing the QueryAttribute.
     // The name string was not copied by the parser (unlike the value) - so we copy and save it.
     VecSimRawParam param = (VecSimRawParam){ .name = rm_strndup(attr->name, attr->namelen),
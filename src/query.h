@@ -75,8 +75,10 @@ typedef struct {
   size_t nids;
 } QAST_GlobalFilterOptions;
 
-/** Set global filters on the AST */
-void QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *options);
+/** Set global filters on the AST. Returns REDISMODULE_ERR and sets the status if the filters
+ * cannot be applied to the query */
+int QAST_SetGlobalFilters(QueryAST *ast, const QAST_GlobalFilterOptions *options,
+                          QueryError *status);
 
 /**
  * Open the result iterator on the filters. Returns the iterator for the root node.
@@ -187,20 +187,20 @@ static void reportSyntaxError(QueryError *status, QueryToken* tok, const char *m
 #endif
 /************* Begin control #defines *****************************************/
 #define YYCODETYPE unsigned char
-#define YYNOCODE 63
+#define YYNOCODE 64
 #define YYACTIONTYPE unsigned short int
 #define RSQueryParser_v2_TOKENTYPE QueryToken
 typedef union {
   int yyinit;
   RSQueryParser_v2_TOKENTYPE yy0;
-  SingleVectorQueryParam yy5;
-  QueryAttribute * yy27;
-  VectorQueryParams yy32;
-  QueryNode * yy35;
-  QueryParam * yy50;
-  QueryAttribute yy55;
-  RangeNumber yy83;
-  Vector* yy120;
+  QueryAttribute yy7;
+  VectorQueryParams yy10;
+  SingleVectorQueryParam yy29;
+  QueryParam * yy30;
+  QueryAttribute * yy33;
+  QueryNode * yy51;
+  Vector* yy114;
+  RangeNumber yy127;
 } YYMINORTYPE;
 #ifndef YYSTACKDEPTH
 #define YYSTACKDEPTH 256
@@ -216,18 +216,18 @@ typedef union {
 #define RSQueryParser_v2_CTX_FETCH
 #define RSQueryParser_v2_CTX_STORE
 #define YYFALLBACK 1
-#define YYNSTATE             118
-#define YYNRULE              94
-#define YYNRULE_WITH_ACTION  91
+#define YYNSTATE             121
+#define YYNRULE              96
+#define YYNRULE_WITH_ACTION  93
 #define YYNTOKEN             33
-#define YY_MAX_SHIFT         117
-#define YY_MIN_SHIFTREDUCE   176
-#define YY_MAX_SHIFTREDUCE   269
-#define YY_ERROR_ACTION      270
-#define YY_ACCEPT_ACTION     271
-#define YY_NO_ACTION         272
-#define YY_MIN_REDUCE        273
-#define YY_MAX_REDUCE        366
+#define YY_MAX_SHIFT         120
+#define YY_MIN_SHIFTREDUCE   181
+#define YY_MAX_SHIFTREDUCE   276
+#define YY_ERROR_ACTION      277
+#define YY_ACCEPT_ACTION     278
+#define YY_NO_ACTION         279
+#define YY_MIN_REDUCE        280
+#define YY_MAX_REDUCE        375
 /************* End control #defines *******************************************/
 #define YY_NLOOKAHEAD ((int)(sizeof(yy_lookahead)/sizeof(yy_lookahead[0])))
 
@@ -294,216 +294,220 @@ typedef union {
 **  yy_default[]       Default action for each state.
 **
 *********** Begin parsing tables **********************************************/
-#define YY_ACTTAB_COUNT (790)
+#define YY_ACTTAB_COUNT (798)
 static const YYACTIONTYPE yy_action[] = {
- /*     0 */   362,  349,   45,  352,   12,  222,  194,   54,  353,  257,
- /*    10 */    44,   15,  339,   53,   13,   14,   75,  104,  328,  258,
- /*    20 */   259,  329,   55,  348,  215,  216,  217,   50,  261,   73,
- /*    30 */   218,   16,  222,  195,  338,   53,  257,   44,   15,   56,
- /*    40 */   357,   13,   14,   30,  115,   51,  258,  259,  257,   92,
- /*    50 */    52,  215,  216,  217,   50,  261,  273,  218,  258,  259,
- /*    60 */    12,  222,   60,  113,  114,  257,   44,   15,  110,  357,
- /*    70 */    13,   14,  269,   86,   77,  258,  259,  111,  357,  262,
- /*    80 */   215,  216,  217,   50,  261,  274,  218,  263,  307,  357,
- /*    90 */   222,  347,  357,   96,  257,   44,    1,   76,  324,   13,
- /*   100 */    14,  325,   57,  321,  258,  259,  267,   89,  320,  215,
- /*   110 */   216,  217,   50,  261,  257,  218,   16,  222,   77,   58,
- /*   120 */   357,  257,   44,   15,  258,  259,   13,   14,  362,   80,
- /*   130 */   222,  258,  259,  112,  100,   46,  215,  216,  217,   50,
- /*   140 */   261,  257,  218,   12,  222,  295,  342,  357,  257,   44,
- /*   150 */    15,  258,  259,   13,   14,  362,  104,  336,  258,  259,
- /*   160 */   261,  344,   47,  215,  216,  217,   50,  261,   79,  218,
- /*   170 */    16,  222,  105,  357,   93,  257,   44,   15,  306,  357,
- /*   180 */    13,   14,  101,  115,  201,  258,  259,  108,  357,  268,
- /*   190 */   215,  216,  217,   50,  261,   34,  218,  195,  293,  357,
- /*   200 */   257,   44,   33,   94,   43,   31,   32,   77,  115,   77,
- /*   210 */   258,  259,  294,   78,   62,  215,  216,  217,   50,  261,
- /*   220 */   345,  218,  222,  294,   81,   64,  257,   44,    1,   98,
- /*   230 */    43,   13,   14,  294,   84,   82,  258,  259,  267,  103,
- /*   240 */    43,  215,  216,  217,   50,  261,   65,  218,  222,  337,
- /*   250 */   294,   87,  257,   44,   15,  275,   42,   13,   14,  225,
- /*   260 */   104,  343,  258,  259,  294,   91,   97,  215,  216,  217,
- /*   270 */    50,  261,   99,  218,  222,   69,   63,   66,  257,   44,
- /*   280 */    15,  257,  203,   13,   14,  335,  115,   74,  258,  259,
- /*   290 */    85,  258,  259,  215,  216,  217,   50,  261,  249,  218,
- /*   300 */   261,   26,  102,  257,   44,   33,   40,   48,   31,   32,
- /*   310 */    68,   67,  202,  258,  259,   68,  237,  221,  215,  216,
- /*   320 */   217,   50,  261,   34,  218,  205,  106,  107,  257,   44,
- /*   330 */    33,  220,  204,   31,   32,   61,  115,   77,  258,  259,
- /*   340 */   109,  219,   69,  215,  216,  217,   50,  261,   35,  218,
- /*   350 */   222,  272,   17,  272,  257,   44,   15,  272,   72,   13,
- /*   360 */    14,  272,   71,  272,  258,  259,  254,  253,  272,  215,
- /*   370 */   216,  217,   50,  261,  272,  218,  272,  272,  272,  257,
- /*   380 */    44,   33,  272,  272,   31,   32,  272,  115,  272,  258,
- /*   390 */   259,  272,  272,  272,  215,  216,  217,   50,  261,   70,
- /*   400 */   218,  272,  272,   71,  257,   44,   33,  254,  253,   31,
- /*   410 */    32,  272,  272,  272,  258,  259,  264,  272,  257,  215,
- /*   420 */   216,  217,   50,  261,    4,  218,  272,  304,  258,  259,
- /*   430 */   305,  272,  117,  116,    5,   72,   59,  261,  272,   71,
- /*   440 */   272,  272,   88,  254,  253,  271,   83,   90,  303,  357,
- /*   450 */   272,  272,  266,    2,  272,  272,  304,  272,  272,  305,
- /*   460 */   272,  117,  116,    3,   22,  272,  272,  304,  272,  272,
- /*   470 */   305,   88,  117,  116,   25,   95,   90,  303,  357,  272,
- /*   480 */   272,  272,   88,  272,  257,  272,  272,   90,  303,  357,
- /*   490 */    23,  272,  272,  304,  258,  259,  305,  272,  117,  116,
- /*   500 */    24,    9,   49,  261,  304,  272,  272,  305,   88,  117,
- /*   510 */   116,   10,  272,   90,  303,  357,  272,  272,  272,   88,
- /*   520 */   272,  272,  272,  272,   90,  303,  357,   19,  272,  272,
- /*   530 */   304,  272,  272,  305,  272,  117,  116,   20,   18,  272,
- /*   540 */   272,  304,  272,  272,  305,   88,  117,  116,   21,  272,
- /*   550 */    90,  303,  357,  272,  272,  272,   88,  272,  272,  272,
- /*   560 */   272,   90,  303,  357,    2,  272,  272,  304,  272,  272,
- /*   570 */   305,  272,  117,  116,    3,    8,  272,  272,  304,  272,
- /*   580 */   272,  305,   88,  117,  116,   11,  272,   90,  303,  357,
- /*   590 */   272,  272,  272,   88,  272,  272,  272,  272,   90,  303,
- /*   600 */   357,    6,  272,  272,  304,  272,  272,  305,  272,  117,
- /*   610 */   116,    7,  272,  272,  272,  272,  272,  272,  272,   88,
- /*   620 */   272,  272,  272,  272,   90,  303,  357,  104,  272,  258,
- /*   630 */   259,  272,  272,  272,  215,  216,  217,   50,  261,  272,
- /*   640 */   218,  272,  115,  272,  258,  259,  272,  272,  272,  215,
- /*   650 */   216,  217,   50,  261,  272,  218,  304,  272,  272,  305,
- /*   660 */   272,  272,  116,   41,  272,  272,  333,  272,  272,  272,
- /*   670 */   272,  272,  272,  331,  272,  258,  259,  303,  357,  272,
- /*   680 */   215,  216,  217,   50,  261,  257,  218,  304,  272,  272,
- /*   690 */   305,  272,  272,  116,   38,  258,  259,  272,  272,  272,
- /*   700 */   215,  216,  217,  272,  261,  272,  218,  272,  303,  357,
- /*   710 */   304,  272,  272,  305,  272,  304,  116,   39,  305,  272,
- /*   720 */   304,  116,   36,  305,  272,  272,  116,   37,  272,  272,
- /*   730 */   272,  303,  357,  272,  272,  272,  303,  357,  272,  272,
- /*   740 */   272,  303,  357,  304,  272,  304,  305,  272,  305,  116,
- /*   750 */    27,  116,   29,  304,  272,  272,  305,  272,  272,  116,
- /*   760 */    28,  272,  272,  272,  303,  357,  303,  357,  272,  235,
- /*   770 */   272,  272,   70,  272,  303,  357,   71,  272,  272,  272,
- /*   780 */   254,  253,  272,  272,  272,  272,  272,  272,  272,  264,
+ /*     0 */   371,  358,   46,   52,   12,  227,  199,   55,  361,  264,
+ /*    10 */    45,   15,  346,   54,   13,   14,   76,  105,   93,  265,
+ /*    20 */   266,   61,  116,  357,  220,  221,  222,   51,  268,  264,
+ /*    30 */   223,   16,  227,  200,  345,   54,  264,   45,   15,  265,
+ /*    40 */   266,   13,   14,   78,  118,  362,  265,  266,  115,   97,
+ /*    50 */    53,  220,  221,  222,   51,  268,  280,  223,  264,   77,
+ /*    60 */    12,  227,  113,  366,  117,  264,   45,   15,  265,  266,
+ /*    70 */    13,   14,  276,   87,   78,  265,  266,  268,   95,   43,
+ /*    80 */   220,  221,  222,   51,  268,  281,  223,  114,  366,   73,
+ /*    90 */   227,  264,  328,   72,  264,   45,    1,  261,  260,   13,
+ /*   100 */    14,  265,  266,  107,  265,  266,  274,  371,  102,  220,
+ /*   110 */   221,  222,   51,  268,   49,  223,   16,  227,  343,  314,
+ /*   120 */   366,  264,   45,   15,  356,  366,   13,   14,  327,   81,
+ /*   130 */   206,  265,  266,   78,  371,   94,  220,  221,  222,   51,
+ /*   140 */   268,  106,  223,   12,  227,  371,  349,  366,  264,   45,
+ /*   150 */    15,  344,   47,   13,   14,   78,  105,  227,  265,  266,
+ /*   160 */   108,  366,  101,  220,  221,  222,   51,  268,   98,  223,
+ /*   170 */    16,  227,  313,  366,  269,  264,   45,   15,  111,  366,
+ /*   180 */    13,   14,  270,  118,  207,  265,  266,  282,  300,  366,
+ /*   190 */   220,  221,  222,   51,  268,   34,  223,  200,  301,   79,
+ /*   200 */   264,   45,   33,  342,  100,   31,   32,  302,  118,   78,
+ /*   210 */   265,  266,  301,   82,  351,  220,  221,  222,   51,  268,
+ /*   220 */   103,  223,  227,   99,   43,   63,  264,   45,    1,  301,
+ /*   230 */    85,   13,   14,  104,   43,   74,  265,  266,  274,   70,
+ /*   240 */    64,  220,  221,  222,   51,  268,   80,  223,  227,   30,
+ /*   250 */   301,   88,  264,   45,   15,  275,   42,   13,   14,  230,
+ /*   260 */   105,  352,  265,  266,  301,   92,   65,  220,  221,  222,
+ /*   270 */    51,  268,   83,  223,  227,   69,   68,   67,  264,   45,
+ /*   280 */    15,  264,  208,   13,   14,  254,  118,   75,  265,  266,
+ /*   290 */    66,  265,  266,  220,  221,  222,   51,  268,  350,  223,
+ /*   300 */   268,   26,   69,  264,   45,   33,   40,   44,   31,   32,
+ /*   310 */    86,  255,  256,  265,  266,  242,  226,   35,  220,  221,
+ /*   320 */   222,   51,  268,   34,  223,  210,  109,  110,  264,   45,
+ /*   330 */    33,  225,  112,   31,   32,  224,  118,  209,  265,  266,
+ /*   340 */    62,   70,   17,  220,  221,  222,   51,  268,  279,  223,
+ /*   350 */   227,  279,  279,  279,  264,   45,   15,  279,  279,   13,
+ /*   360 */    14,  279,  279,  279,  265,  266,  279,  279,  279,  220,
+ /*   370 */   221,  222,   51,  268,  279,  223,  279,  279,  279,  264,
+ /*   380 */    45,   33,  279,  279,   31,   32,  279,  118,  279,  265,
+ /*   390 */   266,  279,  279,  279,  220,  221,  222,   51,  268,   71,
+ /*   400 */   223,  279,  279,   72,  264,   45,   33,  261,  260,   31,
+ /*   410 */    32,  279,  279,  279,  265,  266,  271,  279,  264,  220,
+ /*   420 */   221,  222,   51,  268,    4,  223,  279,  311,  265,  266,
+ /*   430 */   312,  279,  120,  119,    5,  311,   60,  268,  312,  279,
+ /*   440 */   279,  119,   38,   89,  279,  279,  278,   84,   91,  310,
+ /*   450 */   366,  331,  279,    2,  332,   58,  311,  310,  366,  312,
+ /*   460 */    90,  120,  119,    3,  279,  279,  279,  279,  279,  279,
+ /*   470 */   279,  279,   89,   59,  366,  279,   96,   91,  310,  366,
+ /*   480 */    22,  279,  279,  311,  279,  279,  312,  279,  120,  119,
+ /*   490 */    25,  279,  335,  279,  279,  336,   56,  279,  279,   89,
+ /*   500 */   279,  279,  279,  279,   91,  310,  366,  279,  279,  279,
+ /*   510 */    23,  279,  279,  311,   57,  366,  312,  279,  120,  119,
+ /*   520 */    24,  279,    9,  279,  279,  311,  279,  279,  312,   89,
+ /*   530 */   120,  119,   10,  279,   91,  310,  366,  279,  279,  279,
+ /*   540 */   279,   89,  279,  279,  279,  279,   91,  310,  366,  279,
+ /*   550 */    19,  279,  279,  311,  279,  279,  312,  279,  120,  119,
+ /*   560 */    20,  279,   18,  279,  279,  311,  279,  279,  312,   89,
+ /*   570 */   120,  119,   21,  279,   91,  310,  366,  279,  279,  279,
+ /*   580 */   279,   89,  279,  279,  279,  279,   91,  310,  366,  279,
+ /*   590 */     2,  279,  279,  311,  279,  279,  312,  279,  120,  119,
+ /*   600 */     3,  279,    8,  279,  279,  311,  279,  279,  312,   89,
+ /*   610 */   120,  119,   11,  279,   91,  310,  366,  279,  279,  279,
+ /*   620 */   279,   89,  279,  279,  279,  279,   91,  310,  366,  279,
+ /*   630 */     6,  264,  279,  311,  279,  279,  312,  279,  120,  119,
+ /*   640 */     7,  265,  266,  279,  279,  279,  220,  221,  222,   89,
+ /*   650 */   268,  279,  223,  279,   91,  310,  366,  105,  279,  265,
+ /*   660 */   266,  279,  279,  279,  220,  221,  222,   51,  268,  279,
+ /*   670 */   223,  279,  118,  279,  265,  266,  279,  279,  279,  220,
+ /*   680 */   221,  222,   51,  268,  311,  223,  311,  312,  279,  312,
+ /*   690 */   119,   39,  119,   41,  265,  266,  340,  279,  279,  220,
+ /*   700 */   221,  222,   51,  268,  338,  223,  310,  366,  310,  366,
+ /*   710 */   279,  279,  311,  279,  279,  312,  279,  311,  119,   36,
+ /*   720 */   312,  279,  311,  119,   37,  312,  279,  279,  119,   27,
+ /*   730 */   311,  279,  279,  312,  310,  366,  119,   29,  279,  310,
+ /*   740 */   366,  279,  279,  311,  310,  366,  312,  279,  279,  119,
+ /*   750 */    28,  279,  310,  366,  279,  279,  279,  279,  279,  279,
+ /*   760 */   279,  279,   48,  279,   71,  310,  366,  279,   72,  279,
+ /*   770 */   279,  240,  261,  260,   71,  264,  279,  279,   72,  279,
+ /*   780 */    73,  271,  261,  260,   72,  265,  266,  279,  261,  260,
+ /*   790 */   279,  271,  279,   50,  268,  279,  279,  273,
 };
 static const YYCODETYPE yy_lookahead[] = {
- /*     0 */    52,   49,   50,   52,    4,    5,    6,   59,   52,    9,
- /*    10 */    10,   11,   60,   61,   14,   15,    9,   17,   36,   19,
- /*    20 */    20,   39,   40,   49,   24,   25,   26,   27,   28,    4,
- /*    30 */    30,    4,    5,    6,   60,   61,    9,   10,   11,   57,
- /*    40 */    58,   14,   15,   18,   17,   40,   19,   20,    9,    7,
- /*    50 */     9,   24,   25,   26,   27,   28,    0,   30,   19,   20,
- /*    60 */     4,    5,   57,   58,   28,    9,   10,   11,   57,   58,
- /*    70 */    14,   15,   31,   17,   32,   19,   20,   57,   58,   20,
- /*    80 */    24,   25,   26,   27,   28,    0,   30,   28,   57,   58,
- /*    90 */     5,   57,   58,    7,    9,   10,   11,   62,   36,   14,
- /*   100 */    15,   39,   40,   58,   19,   20,   21,   45,   58,   24,
- /*   110 */    25,   26,   27,   28,    9,   30,    4,    5,   32,   57,
- /*   120 */    58,    9,   10,   11,   19,   20,   14,   15,   52,   17,
- /*   130 */     5,   19,   20,   28,   56,   59,   24,   25,   26,   27,
- /*   140 */    28,    9,   30,    4,    5,   34,   57,   58,    9,   10,
- /*   150 */    11,   19,   20,   14,   15,   52,   17,    0,   19,   20,
- /*   160 */    28,    0,   59,   24,   25,   26,   27,   28,    8,   30,
- /*   170 */     4,    5,   57,   58,   17,    9,   10,   11,   57,   58,
- /*   180 */    14,   15,    7,   17,    7,   19,   20,   57,   58,    6,
- /*   190 */    24,   25,   26,   27,   28,    4,   30,    6,   57,   58,
- /*   200 */     9,   10,   11,   47,   48,   14,   15,   32,   17,   32,
- /*   210 */    19,   20,   34,   35,   12,   24,   25,   26,   27,   28,
- /*   220 */     0,   30,    5,   34,   35,   12,    9,   10,   11,   47,
- /*   230 */    48,   14,   15,   34,   35,    8,   19,   20,   21,   47,
- /*   240 */    48,   24,   25,   26,   27,   28,   13,   30,    5,    0,
- /*   250 */    34,   35,    9,   10,   11,    0,    4,   14,   15,    7,
- /*   260 */    17,    0,   19,   20,   34,   35,   17,   24,   25,   26,
- /*   270 */    27,   28,   17,   30,    5,   12,   13,   12,    9,   10,
- /*   280 */    11,    9,   10,   14,   15,    0,   17,    4,   19,   20,
- /*   290 */     8,   19,   20,   24,   25,   26,   27,   28,   28,   30,
- /*   300 */    28,   18,   17,    9,   10,   11,   12,   13,   14,   15,
- /*   310 */    12,   13,    7,   19,   20,   12,    8,   27,   24,   25,
+ /*     0 */    53,   50,   51,   40,    4,    5,    6,   60,   53,    9,
+ /*    10 */    10,   11,   61,   62,   14,   15,    9,   17,    7,   19,
+ /*    20 */    20,   58,   59,   50,   24,   25,   26,   27,   28,    9,
+ /*    30 */    30,    4,    5,    6,   61,   62,    9,   10,   11,   19,
+ /*    40 */    20,   14,   15,   32,   17,   53,   19,   20,   28,    7,
+ /*    50 */     9,   24,   25,   26,   27,   28,    0,   30,    9,   63,
+ /*    60 */     4,    5,   58,   59,   28,    9,   10,   11,   19,   20,
+ /*    70 */    14,   15,   31,   17,   32,   19,   20,   28,   47,   48,
+ /*    80 */    24,   25,   26,   27,   28,    0,   30,   58,   59,   11,
+ /*    90 */     5,    9,   59,   15,    9,   10,   11,   19,   20,   14,
+ /*   100 */    15,   19,   20,   49,   19,   20,   21,   53,    7,   24,
+ /*   110 */    25,   26,   27,   28,   60,   30,    4,    5,    0,   58,
+ /*   120 */    59,    9,   10,   11,   58,   59,   14,   15,   59,   17,
+ /*   130 */     7,   19,   20,   32,   53,   17,   24,   25,   26,   27,
+ /*   140 */    28,   60,   30,    4,    5,   53,   58,   59,    9,   10,
+ /*   150 */    11,    0,   60,   14,   15,   32,   17,    5,   19,   20,
+ /*   160 */    58,   59,   57,   24,   25,   26,   27,   28,   17,   30,
+ /*   170 */     4,    5,   58,   59,   20,    9,   10,   11,   58,   59,
+ /*   180 */    14,   15,   28,   17,    7,   19,   20,    0,   58,   59,
+ /*   190 */    24,   25,   26,   27,   28,    4,   30,    6,   34,   35,
+ /*   200 */     9,   10,   11,    0,   17,   14,   15,   34,   17,   32,
+ /*   210 */    19,   20,   34,   35,    0,   24,   25,   26,   27,   28,
+ /*   220 */    17,   30,    5,   47,   48,   12,    9,   10,   11,   34,
+ /*   230 */    35,   14,   15,   47,   48,    4,   19,   20,   21,   12,
+ /*   240 */    13,   24,   25,   26,   27,   28,    8,   30,    5,   18,
+ /*   250 */    34,   35,    9,   10,   11,    6,    4,   14,   15,    7,
+ /*   260 */    17,    0,   19,   20,   34,   35,   12,   24,   25,   26,
+ /*   270 */    27,   28,    8,   30,    5,   12,   13,   12,    9,   10,
+ /*   280 */    11,    9,   10,   14,   15,   28,   17,    4,   19,   20,
+ /*   290 */    13,   19,   20,   24,   25,   26,   27,   28,    0,   30,
+ /*   300 */    28,   18,   12,    9,   10,   11,   12,   13,   14,   15,
+ /*   310 */     8,    8,   28,   19,   20,    8,   27,    4,   24,   25,
  /*   320 */    26,   27,   28,    4,   30,   10,   27,   27,    9,   10,
- /*   330 */    11,   27,   10,   14,   15,   18,   17,   32,   19,   20,
- /*   340 */    27,   27,   12,   24,   25,   26,   27,   28,    4,   30,
- /*   350 */     5,   63,    4,   63,    9,   10,   11,   63,   11,   14,
- /*   360 */    15,   63,   15,   63,   19,   20,   19,   20,   63,   24,
- /*   370 */    25,   26,   27,   28,   63,   30,   63,   63,   63,    9,
- /*   380 */    10,   11,   63,   63,   14,   15,   63,   17,   63,   19,
- /*   390 */    20,   63,   63,   63,   24,   25,   26,   27,   28,   11,
- /*   400 */    30,   63,   63,   15,    9,   10,   11,   19,   20,   14,
- /*   410 */    15,   63,   63,   63,   19,   20,   28,   63,    9,   24,
- /*   420 */    25,   26,   27,   28,   33,   30,   63,   36,   19,   20,
- /*   430 */    39,   63,   41,   42,   43,   11,   27,   28,   63,   15,
- /*   440 */    63,   63,   51,   19,   20,   54,   55,   56,   57,   58,
- /*   450 */    63,   63,   28,   33,   63,   63,   36,   63,   63,   39,
- /*   460 */    63,   41,   42,   43,   33,   63,   63,   36,   63,   63,
- /*   470 */    39,   51,   41,   42,   43,   55,   56,   57,   58,   63,
- /*   480 */    63,   63,   51,   63,    9,   63,   63,   56,   57,   58,
- /*   490 */    33,   63,   63,   36,   19,   20,   39,   63,   41,   42,
- /*   500 */    43,   33,   27,   28,   36,   63,   63,   39,   51,   41,
- /*   510 */    42,   43,   63,   56,   57,   58,   63,   63,   63,   51,
- /*   520 */    63,   63,   63,   63,   56,   57,   58,   33,   63,   63,
- /*   530 */    36,   63,   63,   39,   63,   41,   42,   43,   33,   63,
- /*   540 */    63,   36,   63,   63,   39,   51,   41,   42,   43,   63,
- /*   550 */    56,   57,   58,   63,   63,   63,   51,   63,   63,   63,
- /*   560 */    63,   56,   57,   58,   33,   63,   63,   36,   63,   63,
- /*   570 */    39,   63,   41,   42,   43,   33,   63,   63,   36,   63,
- /*   580 */    63,   39,   51,   41,   42,   43,   63,   56,   57,   58,
- /*   590 */    63,   63,   63,   51,   63,   63,   63,   63,   56,   57,
- /*   600 */    58,   33,   63,   63,   36,   63,   63,   39,   63,   41,
- /*   610 */    42,   43,   63,   63,   63,   63,   63,   63,   63,   51,
- /*   620 */    63,   63,   63,   63,   56,   57,   58,   17,   63,   19,
- /*   630 */    20,   63,   63,   63,   24,   25,   26,   27,   28,   63,
- /*   640 */    30,   63,   17,   63,   19,   20,   63,   63,   63,   24,
- /*   650 */    25,   26,   27,   28,   63,   30,   36,   63,   63,   39,
- /*   660 */    63,   63,   42,   43,   63,   63,   46,   63,   63,   63,
- /*   670 */    63,   63,   63,   53,   63,   19,   20,   57,   58,   63,
- /*   680 */    24,   25,   26,   27,   28,    9,   30,   36,   63,   63,
- /*   690 */    39,   63,   63,   42,   43,   19,   20,   63,   63,   63,
- /*   700 */    24,   25,   26,   63,   28,   63,   30,   63,   57,   58,
- /*   710 */    36,   63,   63,   39,   63,   36,   42,   43,   39,   63,
- /*   720 */    36,   42,   43,   39,   63,   63,   42,   43,   63,   63,
- /*   730 */    63,   57,   58,   63,   63,   63,   57,   58,   63,   63,
- /*   740 */    63,   57,   58,   36,   63,   36,   39,   63,   39,   42,
- /*   750 */    43,   42,   43,   36,   63,   63,   39,   63,   63,   42,
- /*   760 */    43,   63,   63,   63,   57,   58,   57,   58,   63,    8,
- /*   770 */    63,   63,   11,   63,   57,   58,   15,   63,   63,   63,
- /*   780 */    19,   20,   63,   63,   63,   63,   63,   63,   63,   28,
- /*   790 */    63,   63,   63,   63,   63,   63,   63,   63,   63,   63,
- /*   800 */    63,   63,   63,   33,   33,   33,   33,   33,   33,   33,
- /*   810 */    33,   33,   33,   33,   33,   33,   33,   33,   33,   33,
- /*   820 */    33,   33,   33,
+ /*   330 */    11,   27,   27,   14,   15,   27,   17,   10,   19,   20,
+ /*   340 */    18,   12,    4,   24,   25,   26,   27,   28,   64,   30,
+ /*   350 */     5,   64,   64,   64,    9,   10,   11,   64,   64,   14,
+ /*   360 */    15,   64,   64,   64,   19,   20,   64,   64,   64,   24,
+ /*   370 */    25,   26,   27,   28,   64,   30,   64,   64,   64,    9,
+ /*   380 */    10,   11,   64,   64,   14,   15,   64,   17,   64,   19,
+ /*   390 */    20,   64,   64,   64,   24,   25,   26,   27,   28,   11,
+ /*   400 */    30,   64,   64,   15,    9,   10,   11,   19,   20,   14,
+ /*   410 */    15,   64,   64,   64,   19,   20,   28,   64,    9,   24,
+ /*   420 */    25,   26,   27,   28,   33,   30,   64,   36,   19,   20,
+ /*   430 */    39,   64,   41,   42,   43,   36,   27,   28,   39,   64,
+ /*   440 */    64,   42,   43,   52,   64,   64,   55,   56,   57,   58,
+ /*   450 */    59,   36,   64,   33,   39,   40,   36,   58,   59,   39,
+ /*   460 */    45,   41,   42,   43,   64,   64,   64,   64,   64,   64,
+ /*   470 */    64,   64,   52,   58,   59,   64,   56,   57,   58,   59,
+ /*   480 */    33,   64,   64,   36,   64,   64,   39,   64,   41,   42,
+ /*   490 */    43,   64,   36,   64,   64,   39,   40,   64,   64,   52,
+ /*   500 */    64,   64,   64,   64,   57,   58,   59,   64,   64,   64,
+ /*   510 */    33,   64,   64,   36,   58,   59,   39,   64,   41,   42,
+ /*   520 */    43,   64,   33,   64,   64,   36,   64,   64,   39,   52,
+ /*   530 */    41,   42,   43,   64,   57,   58,   59,   64,   64,   64,
+ /*   540 */    64,   52,   64,   64,   64,   64,   57,   58,   59,   64,
+ /*   550 */    33,   64,   64,   36,   64,   64,   39,   64,   41,   42,
+ /*   560 */    43,   64,   33,   64,   64,   36,   64,   64,   39,   52,
+ /*   570 */    41,   42,   43,   64,   57,   58,   59,   64,   64,   64,
+ /*   580 */    64,   52,   64,   64,   64,   64,   57,   58,   59,   64,
+ /*   590 */    33,   64,   64,   36,   64,   64,   39,   64,   41,   42,
+ /*   600 */    43,   64,   33,   64,   64,   36,   64,   64,   39,   52,
+ /*   610 */    41,   42,   43,   64,   57,   58,   59,   64,   64,   64,
+ /*   620 */    64,   52,   64,   64,   64,   64,   57,   58,   59,   64,
+ /*   630 */    33,    9,   64,   36,   64,   64,   39,   64,   41,   42,
+ /*   640 */    43,   19,   20,   64,   64,   64,   24,   25,   26,   52,
+ /*   650 */    28,   64,   30,   64,   57,   58,   59,   17,   64,   19,
+ /*   660 */    20,   64,   64,   64,   24,   25,   26,   27,   28,   64,
+ /*   670 */    30,   64,   17,   64,   19,   20,   64,   64,   64,   24,
+ /*   680 */    25,   26,   27,   28,   36,   30,   36,   39,   64,   39,
+ /*   690 */    42,   43,   42,   43,   19,   20,   46,   64,   64,   24,
+ /*   700 */    25,   26,   27,   28,   54,   30,   58,   59,   58,   59,
+ /*   710 */    64,   64,   36,   64,   64,   39,   64,   36,   42,   43,
+ /*   720 */    39,   64,   36,   42,   43,   39,   64,   64,   42,   43,
+ /*   730 */    36,   64,   64,   39,   58,   59,   42,   43,   64,   58,
+ /*   740 */    59,   64,   64,   36,   58,   59,   39,   64,   64,   42,
+ /*   750 */    43,   64,   58,   59,   64,   64,   64,   64,   64,   64,
+ /*   760 */    64,   64,    9,   64,   11,   58,   59,   64,   15,   64,
+ /*   770 */    64,    8,   19,   20,   11,    9,   64,   64,   15,   64,
+ /*   780 */    11,   28,   19,   20,   15,   19,   20,   64,   19,   20,
+ /*   790 */    64,   28,   64,   27,   28,   64,   64,   28,   64,   64,
+ /*   800 */    64,   64,   64,   64,   64,   64,   64,   64,   64,   64,
+ /*   810 */    64,   64,   64,   64,   33,   33,   33,   33,   33,   33,
+ /*   820 */    33,   33,   33,   33,   33,   33,   33,   33,   33,   33,
+ /*   830 */    33,
 };
-#define YY_SHIFT_COUNT    (117)
+#define YY_SHIFT_COUNT    (120)
 #define YY_SHIFT_MIN      (0)
-#define YY_SHIFT_MAX      (761)
+#define YY_SHIFT_MAX      (769)
 static const unsigned short int yy_shift_ofst[] = {
  /*     0 */    85,  217,    0,   27,   56,  112,  139,  166,  243,  243,
- /*    10 */   269,  269,  345,  345,  345,  345,  345,  345,  610,  610,
- /*    20 */   625,  625,  610,  610,  625,  625,  294,  191,  319,  370,
- /*    30 */   395,  395,  395,  395,  395,  395,  625,  625,  625,  656,
- /*    40 */   676,  656,  676,   41,  105,   41,  761,  388,  388,  409,
- /*    50 */   475,  272,  132,  132,  132,  132,  132,  132,  132,  132,
- /*    60 */   132,  132,   36,    7,   36,    7,   36,    7,   36,   36,
- /*    70 */   424,  347,  347,   39,   39,   59,  125,   36,   42,  157,
- /*    80 */   263,   86,  249,  255,  175,  285,  298,  177,   25,  252,
- /*    90 */   283,  305,  161,  202,  160,  183,  220,  213,  227,  233,
- /*   100 */   270,  261,  265,  282,  303,  308,  290,  299,  300,  304,
- /*   110 */   313,  314,  315,  322,  317,  330,  344,  348,
+ /*    10 */   269,  269,  345,  345,  345,  345,  345,  345,  640,  640,
+ /*    20 */   655,  655,  640,  640,  655,  655,  294,  191,  319,  370,
+ /*    30 */   395,  395,  395,  395,  395,  395,  655,  655,  655,  675,
+ /*    40 */   622,  675,  622,   41,  753,   20,   41,  763,  388,  388,
+ /*    50 */   409,  766,  272,   49,   49,   49,   49,   49,   49,   49,
+ /*    60 */    49,   49,   49,   36,    7,   36,    7,   36,    7,   36,
+ /*    70 */    36,  769,   78,   78,   82,   82,  154,  152,   36,   11,
+ /*    80 */   118,  227,   42,  151,  187,  101,  203,  263,  123,  231,
+ /*    90 */   252,  283,  177,  214,  213,  238,  249,  261,  254,  264,
+ /*   100 */   277,  257,  298,  265,  302,  290,  284,  303,  307,  289,
+ /*   110 */   299,  300,  304,  305,  308,  315,  327,  322,  329,  313,
+ /*   120 */   338,
 };
-#define YY_REDUCE_COUNT (77)
-#define YY_REDUCE_MIN   (-52)
-#define YY_REDUCE_MAX   (717)
+#define YY_REDUCE_COUNT (78)
+#define YY_REDUCE_MIN   (-53)
+#define YY_REDUCE_MAX   (707)
 static const short yy_reduce_ofst[] = {
- /*     0 */   391,  420,  431,  457,  431,  457,  431,  457,  431,  431,
- /*    10 */   457,  457,  468,  494,  505,  531,  542,  568,  431,  431,
- /*    20 */   457,  457,  431,  431,  457,  457,  620,  651,  651,  651,
- /*    30 */   674,  679,  684,  707,  709,  717,  651,  651,  651,  651,
- /*    40 */    62,  651,  -18,  -48,    5,  -26,  -52,   76,  103,   11,
- /*    50 */    20,   31,   34,   89,  115,   31,  121,   31,  121,  130,
- /*    60 */   121,  141,  178,  156,  189,  182,  199,  192,  216,  230,
- /*    70 */   -49,  -44,  -49,   45,   50,   35,   78,  111,
+ /*     0 */   391,  420,  447,  477,  447,  477,  447,  477,  447,  447,
+ /*    10 */   477,  477,  489,  517,  529,  557,  569,  597,  447,  447,
+ /*    20 */   477,  477,  447,  447,  477,  477,  650,  399,  399,  399,
+ /*    30 */   648,  676,  681,  686,  694,  707,  399,  399,  399,  399,
+ /*    40 */   415,  399,  456,  -49,   54,  -37,  -27,  -53,   81,   92,
+ /*    50 */     4,   29,   61,   66,   88,  102,   61,  114,   61,  114,
+ /*    60 */   120,  114,  130,  164,   31,  178,  176,  195,  186,  216,
+ /*    70 */   230,  -45,   -8,  -45,   33,   69,   -4,  105,  173,
 };
 static const YYACTIONTYPE yy_default[] = {
- /*     0 */   270,  270,  270,  270,  270,  276,  283,  276,  284,  282,
- /*    10 */   285,  287,  270,  270,  270,  270,  270,  270,  308,  310,
- /*    20 */   311,  309,  277,  278,  280,  279,  270,  270,  288,  287,
- /*    30 */   270,  270,  270,  270,  270,  270,  311,  309,  280,  290,
- /*    40 */   270,  289,  270,  341,  270,  340,  270,  270,  270,  270,
- /*    50 */   270,  270,  270,  270,  270,  330,  327,  326,  323,  270,
- /*    60 */   270,  270,  297,  270,  297,  270,  297,  270,  297,  297,
- /*    70 */   270,  270,  270,  270,  270,  270,  270,  296,  270,  270,
- /*    80 */   270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
- /*    90 */   270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
- /*   100 */   270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
- /*   110 */   270,  270,  358,  357,  270,  270,  286,  281,
+ /*     0 */   277,  277,  277,  277,  277,  283,  290,  283,  291,  289,
+ /*    10 */   292,  294,  277,  277,  277,  277,  277,  277,  315,  317,
+ /*    20 */   318,  316,  284,  285,  287,  286,  277,  277,  295,  294,
+ /*    30 */   277,  277,  277,  277,  277,  277,  318,  316,  287,  297,
+ /*    40 */   277,  296,  277,  348,  277,  277,  347,  277,  277,  277,
+ /*    50 */   277,  277,  277,  277,  277,  277,  337,  334,  333,  330,
+ /*    60 */   277,  277,  277,  304,  277,  304,  277,  304,  277,  304,
+ /*    70 */   304,  277,  277,  277,  277,  277,  277,  277,  303,  277,
+ /*    80 */   277,  277,  277,  277,  277,  277,  277,  277,  277,  277,
+ /*    90 */   277,  277,  277,  277,  277,  277,  277,  277,  277,  277,
+ /*   100 */   277,  277,  277,  277,  277,  277,  277,  277,  277,  277,
+ /*   110 */   277,  277,  277,  277,  277,  367,  366,  277,  277,  293,
+ /*   120 */   288,
 };
 /********** End of lemon-generated parsing tables *****************************/
 
@@ -693,20 +697,21 @@ static const char *const yyTokenName[] = {
   /*   46 */ "geo_filter",
   /*   47 */ "vector_query",
   /*   48 */ "vector_command",
-  /*   49 */ "vector_attribute",
-  /*   50 */ "vector_attribute_list",
-  /*   51 */ "modifierlist",
-  /*   52 */ "num",
-  /*   53 */ "numeric_range",
-  /*   54 */ "query",
-  /*   55 */ "star",
-  /*   56 */ "modifier",
-  /*   57 */ "param_term",
-  /*   58 */ "term",
-  /*   59 */ "param_num",
-  /*   60 */ "vector_score_field",
-  /*   61 */ "as",
-  /*   62 */ "param_size",
+  /*   49 */ "vector_range_command",
+  /*   50 */ "vector_attribute",
+  /*   51 */ "vector_attribute_list",
+  /*   52 */ "modifierlist",
+  /*   53 */ "num",
+  /*   54 */ "numeric_range",
+  /*   55 */ "query",
+  /*   56 */ "star",
+  /*   57 */ "modifier",
+  /*   58 */ "param_term",
+  /*   59 */ "term",
+  /*   60 */ "param_num",
+  /*   61 */ "vector_score_field",
+  /*   62 */ "as",
+  /*   63 */ "param_size",
 };
 #endif /* defined(YYCOVERAGE) || !defined(NDEBUG) */
 
@@ -788,26 +793,28 @@ static const char *const yyRuleName[] = {
  /*  71 */ "query ::= text_expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB",
  /*  72 */ "query ::= star ARROW LSQB vector_query RSQB ARROW LB attribute_list RB",
  /*  73 */ "vector_command ::= TERM param_size modifier ATTRIBUTE",
- /*  74 */ "vector_attribute ::= TERM param_term",
- /*  75 */ "vector_attribute_list ::= vector_attribute_list vector_attribute",
- /*  76 */ "vector_attribute_list ::= vector_attribute",
- /*  77 */ "num ::= SIZE",
- /*  78 */ "num ::= NUMBER",
- /*  79 */ "num ::= LP num",
- /*  80 */ "num ::= MINUS num",
- /*  81 */ "term ::= TERM",
- /*  82 */ "term ::= NUMBER",
- /*  83 */ "term ::= SIZE",
- /*  84 */ "param_term ::= term",
- /*  85 */ "param_term ::= ATTRIBUTE",
- /*  86 */ "param_size ::= SIZE",
- /*  87 */ "param_size ::= ATTRIBUTE",
- /*  88 */ "param_num ::= ATTRIBUTE",
- /*  89 */ "param_num ::= num",
- /*  90 */ "param_num ::= LP ATTRIBUTE",
- /*  91 */ "star ::= STAR",
- /*  92 */ "star ::= LP star RP",
- /*  93 */ "as ::= AS_T",
+ /*  74 */ "expr ::= modifier COLON LSQB vector_range_command RSQB",
+ /*  75 */ "vector_range_command ::= TERM param_num ATTRIBUTE",
+ /*  76 */ "vector_attribute ::= TERM param_term",
+ /*  77 */ "vector_attribute_list ::= vector_attribute_list vector_attribute",
+ /*  78 */ "vector_attribute_list ::= vector_attribute",
+ /*  79 */ "num ::= SIZE",
+ /*  80 */ "num ::= NUMBER",
+ /*  81 */ "num ::= LP num",
+ /*  82 */ "num ::= MINUS num",
+ /*  83 */ "term ::= TERM",
+ /*  84 */ "term ::= NUMBER",
+ /*  85 */ "term ::= SIZE",
+ /*  86 */ "param_term ::= term",
+ /*  87 */ "param_term ::= ATTRIBUTE",
+ /*  88 */ "param_size ::= SIZE",
+ /*  89 */ "param_size ::= ATTRIBUTE",
+ /*  90 */ "param_num ::= ATTRIBUTE",
+ /*  91 */ "param_num ::= num",
+ /*  92 */ "param_num ::= LP ATTRIBUTE",
+ /*  93 */ "star ::= STAR",
+ /*  94 */ "star ::= LP star RP",
+ /*  95 */ "as ::= AS_T",
 };
 #endif /* NDEBUG */
 
@@ -934,17 +941,17 @@ static void yy_destructor(
     */
 /********* Begin destructor definitions ***************************************/
       /* Default NON-TERMINAL Destructor */
-    case 49: /* vector_attribute */
-    case 52: /* num */
-    case 54: /* query */
-    case 55: /* star */
-    case 56: /* modifier */
-    case 57: /* param_term */
-    case 58: /* term */
-    case 59: /* param_num */
-    case 60: /* vector_score_field */
-    case 61: /* as */
-    case 62: /* param_size */
+    case 50: /* vector_attribute */
+    case 53: /* num */
+    case 55: /* query */
+    case 56: /* star */
+    case 57: /* modifier */
+    case 58: /* param_term */
+    case 59: /* term */
+    case 60: /* param_num */
+    case 61: /* vector_score_field */
+    case 62: /* as */
+    case 63: /* param_size */
 {
  
 }
@@ -962,52 +969,53 @@ static void yy_destructor(
     case 45: /* tag_list */
     case 47: /* vector_query */
     case 48: /* vector_command */
+    case 49: /* vector_range_command */
 {
- QueryNode_Free((yypminor->yy35)); 
+ QueryNode_Free((yypminor->yy51)); 
 }
       break;
     case 34: /* attribute */
 {
- rm_free((char*)(yypminor->yy55).value); 
+ rm_free((char*)(yypminor->yy7).value); 
 }
       break;
     case 35: /* attribute_list */
 {
- array_free_ex((yypminor->yy27), rm_free((char*)((QueryAttribute*)ptr )->value)); 
+ array_free_ex((yypminor->yy33), rm_free((char*)((QueryAttribute*)ptr )->value)); 
 }
       break;
     case 46: /* geo_filter */
 {
- QueryParam_Free((yypminor->yy50)); 
+ QueryParam_Free((yypminor->yy30)); 
 }
       break;
-    case 50: /* vector_attribute_list */
+    case 51: /* vector_attribute_list */
 {
 
-  array_free((yypminor->yy32).needResolve);
-  array_free_ex((yypminor->yy32).params, {
+  array_free((yypminor->yy10).needResolve);
+  array_free_ex((yypminor->yy10).params, {
     rm_free((char*)((VecSimRawParam*)ptr)->value);
     rm_free((char*)((VecSimRawParam*)ptr)->name);
   });
 
 }
       break;
-    case 51: /* modifierlist */
+    case 52: /* modifierlist */
 {
 
-    for (size_t i = 0; i < Vector_Size((yypminor->yy120)); i++) {
+    for (size_t i = 0; i < Vector_Size((yypminor->yy114)); i++) {
         char *s;
-        Vector_Get((yypminor->yy120), i, &s);
+        Vector_Get((yypminor->yy114), i, &s);
         rm_free(s);
     }
-    Vector_Free((yypminor->yy120));
+    Vector_Free((yypminor->yy114));
 
 }
       break;
-    case 53: /* numeric_range */
+    case 54: /* numeric_range */
 {
 
-  QueryParam_Free((yypminor->yy50));
+  QueryParam_Free((yypminor->yy30));
 
 }
       break;
@@ -1300,9 +1308,9 @@ static void yy_shift(
 /* For rule J, yyRuleInfoLhs[J] contains the symbol on the left-hand side
 ** of that rule */
 static const YYCODETYPE yyRuleInfoLhs[] = {
-    54,  /* (0) query ::= expr */
-    54,  /* (1) query ::= */
-    54,  /* (2) query ::= star */
+    55,  /* (0) query ::= expr */
+    55,  /* (1) query ::= */
+    55,  /* (2) query ::= star */
     33,  /* (3) expr ::= text_expr */
     33,  /* (4) expr ::= expr expr */
     33,  /* (5) expr ::= text_expr expr */
@@ -1346,9 +1354,9 @@ static const YYCODETYPE yyRuleInfoLhs[] = {
     43,  /* (43) text_expr ::= PERCENT param_term PERCENT */
     43,  /* (44) text_expr ::= PERCENT PERCENT param_term PERCENT PERCENT */
     43,  /* (45) text_expr ::= PERCENT PERCENT PERCENT param_term PERCENT PERCENT PERCENT */
-    56,  /* (46) modifier ::= MODIFIER */
-    51,  /* (47) modifierlist ::= modifier OR term */
-    51,  /* (48) modifierlist ::= modifierlist OR term */
+    57,  /* (46) modifier ::= MODIFIER */
+    52,  /* (47) modifierlist ::= modifier OR term */
+    52,  /* (48) modifierlist ::= modifierlist OR term */
     33,  /* (49) expr ::= modifier COLON LB tag_list RB */
     45,  /* (50) tag_list ::= param_term */
     45,  /* (51) tag_list ::= affix */
@@ -1359,41 +1367,43 @@ static const YYCODETYPE yyRuleInfoLhs[] = {
     45,  /* (56) tag_list ::= tag_list OR verbatim */
     45,  /* (57) tag_list ::= tag_list OR termlist */
     33,  /* (58) expr ::= modifier COLON numeric_range */
-    53,  /* (59) numeric_range ::= LSQB param_num param_num RSQB */
+    54,  /* (59) numeric_range ::= LSQB param_num param_num RSQB */
     33,  /* (60) expr ::= modifier COLON geo_filter */
     46,  /* (61) geo_filter ::= LSQB param_num param_num param_num param_term RSQB */
-    54,  /* (62) query ::= expr ARROW LSQB vector_query RSQB */
-    54,  /* (63) query ::= text_expr ARROW LSQB vector_query RSQB */
-    54,  /* (64) query ::= star ARROW LSQB vector_query RSQB */
+    55,  /* (62) query ::= expr ARROW LSQB vector_query RSQB */
+    55,  /* (63) query ::= text_expr ARROW LSQB vector_query RSQB */
+    55,  /* (64) query ::= star ARROW LSQB vector_query RSQB */
     47,  /* (65) vector_query ::= vector_command vector_attribute_list vector_score_field */
     47,  /* (66) vector_query ::= vector_command vector_score_field */
     47,  /* (67) vector_query ::= vector_command vector_attribute_list */
     47,  /* (68) vector_query ::= vector_command */
-    60,  /* (69) vector_score_field ::= as param_term */
-    54,  /* (70) query ::= expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
-    54,  /* (71) query ::= text_expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
-    54,  /* (72) query ::= star ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
+    61,  /* (69) vector_score_field ::= as param_term */
+    55,  /* (70) query ::= expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
+    55,  /* (71) query ::= text_expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
+    55,  /* (72) query ::= star ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
     48,  /* (73) vector_command ::= TERM param_size modifier ATTRIBUTE */
-    49,  /* (74) vector_attribute ::= TERM param_term */
-    50,  /* (75) vector_attribute_list ::= vector_attribute_list vector_attribute */
-    50,  /* (76) vector_attribute_list ::= vector_attribute */
-    52,  /* (77) num ::= SIZE */
-    52,  /* (78) num ::= NUMBER */
-    52,  /* (79) num ::= LP num */
-    52,  /* (80) num ::= MINUS num */
-    58,  /* (81) term ::= TERM */
-    58,  /* (82) term ::= NUMBER */
-    58,  /* (83) term ::= SIZE */
-    57,  /* (84) param_term ::= term */
-    57,  /* (85) param_term ::= ATTRIBUTE */
-    62,  /* (86) param_size ::= SIZE */
-    62,  /* (87) param_size ::= ATTRIBUTE */
-    59,  /* (88) param_num ::= ATTRIBUTE */
-    59,  /* (89) param_num ::= num */
-    59,  /* (90) param_num ::= LP ATTRIBUTE */
-    55,  /* (91) star ::= STAR */
-    55,  /* (92) star ::= LP star RP */
-    61,  /* (93) as ::= AS_T */
+    33,  /* (74) expr ::= modifier COLON LSQB vector_range_command RSQB */
+    49,  /* (75) vector_range_command ::= TERM param_num ATTRIBUTE */
+    50,  /* (76) vector_attribute ::= TERM param_term */
+    51,  /* (77) vector_attribute_list ::= vector_attribute_list vector_attribute */
+    51,  /* (78) vector_attribute_list ::= vector_attribute */
+    53,  /* (79) num ::= SIZE */
+    53,  /* (80) num ::= NUMBER */
+    53,  /* (81) num ::= LP num */
+    53,  /* (82) num ::= MINUS num */
+    59,  /* (83) term ::= TERM */
+    59,  /* (84) term ::= NUMBER */
+    59,  /* (85) term ::= SIZE */
+    58,  /* (86) param_term ::= term */
+    58,  /* (87) param_term ::= ATTRIBUTE */
+    63,  /* (88) param_size ::= SIZE */
+    63,  /* (89) param_size ::= ATTRIBUTE */
+    60,  /* (90) param_num ::= ATTRIBUTE */
+    60,  /* (91) param_num ::= num */
+    60,  /* (92) param_num ::= LP ATTRIBUTE */
+    56,  /* (93) star ::= STAR */
+    56,  /* (94) star ::= LP star RP */
+    62,  /* (95) as ::= AS_T */
 };
 
 /* For rule J, yyRuleInfoNRhs[J] contains the negative of the number
@@ -1473,26 +1483,28 @@ static const signed char yyRuleInfoNRhs[] = {
    -9,  /* (71) query ::= text_expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
    -9,  /* (72) query ::= star ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
    -4,  /* (73) vector_command ::= TERM param_size modifier ATTRIBUTE */
-   -2,  /* (74) vector_attribute ::= TERM param_term */
-   -2,  /* (75) vector_attribute_list ::= vector_attribute_list vector_attribute */
-   -1,  /* (76) vector_attribute_list ::= vector_attribute */
-   -1,  /* (77) num ::= SIZE */
-   -1,  /* (78) num ::= NUMBER */
-   -2,  /* (79) num ::= LP num */
-   -2,  /* (80) num ::= MINUS num */
-   -1,  /* (81) term ::= TERM */
-   -1,  /* (82) term ::= NUMBER */
-   -1,  /* (83) term ::= SIZE */
-   -1,  /* (84) param_term ::= term */
-   -1,  /* (85) param_term ::= ATTRIBUTE */
-   -1,  /* (86) param_size ::= SIZE */
-   -1,  /* (87) param_size ::= ATTRIBUTE */
-   -1,  /* (88) param_num ::= ATTRIBUTE */
-   -1,  /* (89) param_num ::= num */
-   -2,  /* (90) param_num ::= LP ATTRIBUTE */
-   -1,  /* (91) star ::= STAR */
-   -3,  /* (92) star ::= LP star RP */
-   -1,  /* (93) as ::= AS_T */
+   -5,  /* (74) expr ::= modifier COLON LSQB vector_range_command RSQB */
+   -3,  /* (75) vector_range_command ::= TERM param_num ATTRIBUTE */
+   -2,  /* (76) vector_attribute ::= TERM param_term */
+   -2,  /* (77) vector_attribute_list ::= vector_attribute_list vector_attribute */
+   -1,  /* (78) vector_attribute_list ::= vector_attribute */
+   -1,  /* (79) num ::= SIZE */
+   -1,  /* (80) num ::= NUMBER */
+   -2,  /* (81) num ::= LP num */
+   -2,  /* (82) num ::= MINUS num */
+   -1,  /* (83) term ::= TERM */
+   -1,  /* (84) term ::= NUMBER */
+   -1,  /* (85) term ::= SIZE */
+   -1,  /* (86) param_term ::= term */
+   -1,  /* (87) param_term ::= ATTRIBUTE */
+   -1,  /* (88) param_size ::= SIZE */
+   -1,  /* (89) param_size ::= ATTRIBUTE */
+   -1,  /* (90) param_num ::= ATTRIBUTE */
+   -1,  /* (91) param_num ::= num */
+   -2,  /* (92) param_num ::= LP ATTRIBUTE */
+   -1,  /* (93) star ::= STAR */
+   -3,  /* (94) star ::= LP star RP */
+   -1,  /* (95) as ::= AS_T */
 };
 
 static void yy_accept(yyParser*);  /* Forward Declaration */
@@ -1537,7 +1549,7 @@ static YYACTIONTYPE yy_reduce(
       case 0: /* query ::= expr */
 {
   setup_trace(ctx);
-  ctx->root = yymsp[0].minor.yy35;
+  ctx->root = yymsp[0].minor.yy51;
 }
         break;
       case 1: /* query ::= */
@@ -1546,7 +1558,7 @@ static YYACTIONTYPE yy_reduce(
 }
         break;
       case 2: /* query ::= star */
-{  yy_destructor(yypParser,55,&yymsp[0].minor);
+{  yy_destructor(yypParser,56,&yymsp[0].minor);
 {
   setup_trace(ctx);
   ctx->root = NewWildcardNode();
@@ -1558,117 +1570,117 @@ static YYACTIONTYPE yy_reduce(
       case 13: /* text_expr ::= text_union */ yytestcase(yyruleno==13);
       case 68: /* vector_query ::= vector_command */ yytestcase(yyruleno==68);
 {
-  yylhsminor.yy35 = yymsp[0].minor.yy35;
+  yylhsminor.yy51 = yymsp[0].minor.yy51;
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 4: /* expr ::= expr expr */
       case 5: /* expr ::= text_expr expr */ yytestcase(yyruleno==5);
       case 6: /* expr ::= expr text_expr */ yytestcase(yyruleno==6);
       case 7: /* text_expr ::= text_expr text_expr */ yytestcase(yyruleno==7);
 {
-    int rv = one_not_null(yymsp[-1].minor.yy35, yymsp[0].minor.yy35, (void**)&yylhsminor.yy35);
+    int rv = one_not_null(yymsp[-1].minor.yy51, yymsp[0].minor.yy51, (void**)&yylhsminor.yy51);
     if (rv == NODENN_BOTH_INVALID) {
-        yylhsminor.yy35 = NULL;
+        yylhsminor.yy51 = NULL;
     } else if (rv == NODENN_ONE_NULL) {
         // Nothing- `out` is already assigned
     } else {
-        if (yymsp[-1].minor.yy35 && yymsp[-1].minor.yy35->type == QN_PHRASE && yymsp[-1].minor.yy35->pn.exact == 0 &&
-            yymsp[-1].minor.yy35->opts.fieldMask == RS_FIELDMASK_ALL ) {
-            yylhsminor.yy35 = yymsp[-1].minor.yy35;
+        if (yymsp[-1].minor.yy51 && yymsp[-1].minor.yy51->type == QN_PHRASE && yymsp[-1].minor.yy51->pn.exact == 0 &&
+            yymsp[-1].minor.yy51->opts.fieldMask == RS_FIELDMASK_ALL ) {
+            yylhsminor.yy51 = yymsp[-1].minor.yy51;
         } else {
-            yylhsminor.yy35 = NewPhraseNode(0);
-            QueryNode_AddChild(yylhsminor.yy35, yymsp[-1].minor.yy35);
+            yylhsminor.yy51 = NewPhraseNode(0);
+            QueryNode_AddChild(yylhsminor.yy51, yymsp[-1].minor.yy51);
         }
-        QueryNode_AddChild(yylhsminor.yy35, yymsp[0].minor.yy35);
+        QueryNode_AddChild(yylhsminor.yy51, yymsp[0].minor.yy51);
     }
 }
-  yymsp[-1].minor.yy35 = yylhsminor.yy35;
+  yymsp[-1].minor.yy51 = yylhsminor.yy51;
         break;
       case 9: /* union ::= expr OR expr */
       case 11: /* union ::= text_expr OR expr */ yytestcase(yyruleno==11);
       case 12: /* union ::= expr OR text_expr */ yytestcase(yyruleno==12);
       case 14: /* text_union ::= text_expr OR text_expr */ yytestcase(yyruleno==14);
 {
-    int rv = one_not_null(yymsp[-2].minor.yy35, yymsp[0].minor.yy35, (void**)&yylhsminor.yy35);
+    int rv = one_not_null(yymsp[-2].minor.yy51, yymsp[0].minor.yy51, (void**)&yylhsminor.yy51);
     if (rv == NODENN_BOTH_INVALID) {
-        yylhsminor.yy35 = NULL;
+        yylhsminor.yy51 = NULL;
     } else if (rv == NODENN_ONE_NULL) {
         // Nothing- already assigned
     } else {
-        if (yymsp[-2].minor.yy35->type == QN_UNION && yymsp[-2].minor.yy35->opts.fieldMask == RS_FIELDMASK_ALL) {
-            yylhsminor.yy35 = yymsp[-2].minor.yy35;
+        if (yymsp[-2].minor.yy51->type == QN_UNION && yymsp[-2].minor.yy51->opts.fieldMask == RS_FIELDMASK_ALL) {
+            yylhsminor.yy51 = yymsp[-2].minor.yy51;
         } else {
-            yylhsminor.yy35 = NewUnionNode();
-            QueryNode_AddChild(yylhsminor.yy35, yymsp[-2].minor.yy35);
-            yylhsminor.yy35->opts.fieldMask |= yymsp[-2].minor.yy35->opts.fieldMask;
+            yylhsminor.yy51 = NewUnionNode();
+            QueryNode_AddChild(yylhsminor.yy51, yymsp[-2].minor.yy51);
+            yylhsminor.yy51->opts.fieldMask |= yymsp[-2].minor.yy51->opts.fieldMask;
         }
-        // Handle yymsp[0].minor.yy35
-        QueryNode_AddChild(yylhsminor.yy35, yymsp[0].minor.yy35);
-        yylhsminor.yy35->opts.fieldMask |= yymsp[0].minor.yy35->opts.fieldMask;
-        QueryNode_SetFieldMask(yylhsminor.yy35, yylhsminor.yy35->opts.fieldMask);
+        // Handle yymsp[0].minor.yy51
+        QueryNode_AddChild(yylhsminor.yy51, yymsp[0].minor.yy51);
+        yylhsminor.yy51->opts.fieldMask |= yymsp[0].minor.yy51->opts.fieldMask;
+        QueryNode_SetFieldMask(yylhsminor.yy51, yylhsminor.yy51->opts.fieldMask);
     }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 10: /* union ::= union OR expr */
       case 15: /* text_union ::= text_union OR text_expr */ yytestcase(yyruleno==15);
 {
-    yylhsminor.yy35 = yymsp[-2].minor.yy35;
-    if (yymsp[0].minor.yy35) {
-        QueryNode_AddChild(yylhsminor.yy35, yymsp[0].minor.yy35);
-        yylhsminor.yy35->opts.fieldMask |= yymsp[0].minor.yy35->opts.fieldMask;
-        QueryNode_SetFieldMask(yymsp[0].minor.yy35, yylhsminor.yy35->opts.fieldMask);
+    yylhsminor.yy51 = yymsp[-2].minor.yy51;
+    if (yymsp[0].minor.yy51) {
+        QueryNode_AddChild(yylhsminor.yy51, yymsp[0].minor.yy51);
+        yylhsminor.yy51->opts.fieldMask |= yymsp[0].minor.yy51->opts.fieldMask;
+        QueryNode_SetFieldMask(yymsp[0].minor.yy51, yylhsminor.yy51->opts.fieldMask);
     }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 16: /* expr ::= modifier COLON text_expr */
 {
-    if (yymsp[0].minor.yy35 == NULL) {
-        yylhsminor.yy35 = NULL;
+    if (yymsp[0].minor.yy51 == NULL) {
+        yylhsminor.yy51 = NULL;
     } else {
         if (ctx->sctx->spec) {
-            QueryNode_SetFieldMask(yymsp[0].minor.yy35, IndexSpec_GetFieldBit(ctx->sctx->spec, yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len));
+            QueryNode_SetFieldMask(yymsp[0].minor.yy51, IndexSpec_GetFieldBit(ctx->sctx->spec, yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len));
         }
-        yylhsminor.yy35 = yymsp[0].minor.yy35;
+        yylhsminor.yy51 = yymsp[0].minor.yy51;
     }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 17: /* expr ::= modifierlist COLON text_expr */
 {
 
-    if (yymsp[0].minor.yy35 == NULL) {
-        for (size_t i = 0; i < Vector_Size(yymsp[-2].minor.yy120); i++) {
+    if (yymsp[0].minor.yy51 == NULL) {
+        for (size_t i = 0; i < Vector_Size(yymsp[-2].minor.yy114); i++) {
           char *s;
-          Vector_Get(yymsp[-2].minor.yy120, i, &s);
+          Vector_Get(yymsp[-2].minor.yy114, i, &s);
           rm_free(s);
         }
-        Vector_Free(yymsp[-2].minor.yy120);
-        yylhsminor.yy35 = NULL;
+        Vector_Free(yymsp[-2].minor.yy114);
+        yylhsminor.yy51 = NULL;
     } else {
-        //yymsp[0].minor.yy35->opts.fieldMask = 0;
+        //yymsp[0].minor.yy51->opts.fieldMask = 0;
         t_fieldMask mask = 0;
-        for (int i = 0; i < Vector_Size(yymsp[-2].minor.yy120); i++) {
+        for (int i = 0; i < Vector_Size(yymsp[-2].minor.yy114); i++) {
             char *p;
-            Vector_Get(yymsp[-2].minor.yy120, i, &p);
+            Vector_Get(yymsp[-2].minor.yy114, i, &p);
             if (ctx->sctx->spec) {
               mask |= IndexSpec_GetFieldBit(ctx->sctx->spec, p, strlen(p));
             }
             rm_free(p);
         }
-        Vector_Free(yymsp[-2].minor.yy120);
-        QueryNode_SetFieldMask(yymsp[0].minor.yy35, mask);
-        yylhsminor.yy35=yymsp[0].minor.yy35;
+        Vector_Free(yymsp[-2].minor.yy114);
+        QueryNode_SetFieldMask(yymsp[0].minor.yy51, mask);
+        yylhsminor.yy51=yymsp[0].minor.yy51;
     }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 18: /* expr ::= LP expr RP */
       case 19: /* text_expr ::= LP text_expr RP */ yytestcase(yyruleno==19);
 {
-  yymsp[-2].minor.yy35 = yymsp[-1].minor.yy35;
+  yymsp[-2].minor.yy51 = yymsp[-1].minor.yy51;
 }
         break;
       case 20: /* attribute ::= ATTRIBUTE COLON param_term */
@@ -1684,60 +1696,60 @@ static YYACTIONTYPE yy_reduce(
       value_len = found_value_len;
     }
   }
-  yylhsminor.yy55 = (QueryAttribute){ .name = yymsp[-2].minor.yy0.s, .namelen = yymsp[-2].minor.yy0.len, .value = value, .vallen = value_len };
+  yylhsminor.yy7 = (QueryAttribute){ .name = yymsp[-2].minor.yy0.s, .namelen = yymsp[-2].minor.yy0.len, .value = value, .vallen = value_len };
 }
-  yymsp[-2].minor.yy55 = yylhsminor.yy55;
+  yymsp[-2].minor.yy7 = yylhsminor.yy7;
         break;
       case 21: /* attribute_list ::= attribute */
 {
-  yylhsminor.yy27 = array_new(QueryAttribute, 2);
-  yylhsminor.yy27 = array_append(yylhsminor.yy27, yymsp[0].minor.yy55);
+  yylhsminor.yy33 = array_new(QueryAttribute, 2);
+  yylhsminor.yy33 = array_append(yylhsminor.yy33, yymsp[0].minor.yy7);
 }
-  yymsp[0].minor.yy27 = yylhsminor.yy27;
+  yymsp[0].minor.yy33 = yylhsminor.yy33;
         break;
       case 22: /* attribute_list ::= attribute_list SEMICOLON attribute */
 {
-  yylhsminor.yy27 = array_append(yymsp[-2].minor.yy27, yymsp[0].minor.yy55);
+  yylhsminor.yy33 = array_append(yymsp[-2].minor.yy33, yymsp[0].minor.yy7);
 }
-  yymsp[-2].minor.yy27 = yylhsminor.yy27;
+  yymsp[-2].minor.yy33 = yylhsminor.yy33;
         break;
       case 23: /* attribute_list ::= attribute_list SEMICOLON */
 {
-  yylhsminor.yy27 = yymsp[-1].minor.yy27;
+  yylhsminor.yy33 = yymsp[-1].minor.yy33;
 }
-  yymsp[-1].minor.yy27 = yylhsminor.yy27;
+  yymsp[-1].minor.yy33 = yylhsminor.yy33;
         break;
       case 24: /* attribute_list ::= */
 {
-  yymsp[1].minor.yy27 = NULL;
+  yymsp[1].minor.yy33 = NULL;
 }
         break;
       case 25: /* expr ::= expr ARROW LB attribute_list RB */
       case 26: /* text_expr ::= text_expr ARROW LB attribute_list RB */ yytestcase(yyruleno==26);
 {
 
-    if (yymsp[-4].minor.yy35 && yymsp[-1].minor.yy27) {
-        QueryNode_ApplyAttributes(yymsp[-4].minor.yy35, yymsp[-1].minor.yy27, array_len(yymsp[-1].minor.yy27), ctx->status);
+    if (yymsp[-4].minor.yy51 && yymsp[-1].minor.yy33) {
+        QueryNode_ApplyAttributes(yymsp[-4].minor.yy51, yymsp[-1].minor.yy33, array_len(yymsp[-1].minor.yy33), ctx->status);
     }
-    array_free_ex(yymsp[-1].minor.yy27, rm_free((char*)((QueryAttribute*)ptr )->value));
-    yylhsminor.yy35 = yymsp[-4].minor.yy35;
+    array_free_ex(yymsp[-1].minor.yy33, rm_free((char*)((QueryAttribute*)ptr )->value));
+    yylhsminor.yy51 = yymsp[-4].minor.yy51;
 }
-  yymsp[-4].minor.yy35 = yylhsminor.yy35;
+  yymsp[-4].minor.yy51 = yylhsminor.yy51;
         break;
       case 27: /* text_expr ::= QUOTE termlist QUOTE */
 {
   // TODO: Quoted/verbatim string in termlist should not be handled as parameters
   // Also need to add the leading '$' which was consumed by the lexer
-  yymsp[-1].minor.yy35->pn.exact = 1;
-  yymsp[-1].minor.yy35->opts.flags |= QueryNode_Verbatim;
+  yymsp[-1].minor.yy51->pn.exact = 1;
+  yymsp[-1].minor.yy51->opts.flags |= QueryNode_Verbatim;
 
-  yymsp[-2].minor.yy35 = yymsp[-1].minor.yy35;
+  yymsp[-2].minor.yy51 = yymsp[-1].minor.yy51;
 }
         break;
       case 28: /* text_expr ::= QUOTE term QUOTE */
 {
-  yymsp[-2].minor.yy35 = NewTokenNode(ctx, rm_strdupcase(yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len), -1);
-  yymsp[-2].minor.yy35->opts.flags |= QueryNode_Verbatim;
+  yymsp[-2].minor.yy51 = NewTokenNode(ctx, rm_strdupcase(yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len), -1);
+  yymsp[-2].minor.yy51->opts.flags |= QueryNode_Verbatim;
 }
         break;
       case 29: /* text_expr ::= QUOTE ATTRIBUTE QUOTE */
@@ -1747,102 +1759,102 @@ static YYACTIONTYPE yy_reduce(
   char *s = rm_malloc(yymsp[-1].minor.yy0.len + 1);
   *s = '$';
   memcpy(s + 1, yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len);
-  yymsp[-2].minor.yy35 = NewTokenNode(ctx, rm_strdupcase(s, yymsp[-1].minor.yy0.len + 1), -1);
+  yymsp[-2].minor.yy51 = NewTokenNode(ctx, rm_strdupcase(s, yymsp[-1].minor.yy0.len + 1), -1);
   rm_free(s);
-  yymsp[-2].minor.yy35->opts.flags |= QueryNode_Verbatim;
+  yymsp[-2].minor.yy51->opts.flags |= QueryNode_Verbatim;
 }
         break;
       case 30: /* text_expr ::= param_term */
 {
   if (yymsp[0].minor.yy0.type == QT_TERM && StopWordList_Contains(ctx->opts->stopwords, yymsp[0].minor.yy0.s, yymsp[0].minor.yy0.len)) {
-    yylhsminor.yy35 = NULL;
+    yylhsminor.yy51 = NULL;
   } else {
-    yylhsminor.yy35 = NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0);
+    yylhsminor.yy51 = NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0);
   }
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 31: /* text_expr ::= affix */
       case 32: /* text_expr ::= verbatim */ yytestcase(yyruleno==32);
 {
-yylhsminor.yy35 = yymsp[0].minor.yy35;
+yylhsminor.yy51 = yymsp[0].minor.yy51;
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 33: /* termlist ::= param_term param_term */
 {
-  yylhsminor.yy35 = NewPhraseNode(0);
-  QueryNode_AddChild(yylhsminor.yy35, NewTokenNode_WithParams(ctx, &yymsp[-1].minor.yy0));
-  QueryNode_AddChild(yylhsminor.yy35, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
+  yylhsminor.yy51 = NewPhraseNode(0);
+  QueryNode_AddChild(yylhsminor.yy51, NewTokenNode_WithParams(ctx, &yymsp[-1].minor.yy0));
+  QueryNode_AddChild(yylhsminor.yy51, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
 }
-  yymsp[-1].minor.yy35 = yylhsminor.yy35;
+  yymsp[-1].minor.yy51 = yylhsminor.yy51;
         break;
       case 34: /* termlist ::= termlist param_term */
 {
-    yylhsminor.yy35 = yymsp[-1].minor.yy35;
+    yylhsminor.yy51 = yymsp[-1].minor.yy51;
     if (!(yymsp[0].minor.yy0.type == QT_TERM && StopWordList_Contains(ctx->opts->stopwords, yymsp[0].minor.yy0.s, yymsp[0].minor.yy0.len))) {
-       QueryNode_AddChild(yylhsminor.yy35, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
+       QueryNode_AddChild(yylhsminor.yy51, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
     }
 }
-  yymsp[-1].minor.yy35 = yylhsminor.yy35;
+  yymsp[-1].minor.yy51 = yylhsminor.yy51;
         break;
       case 35: /* expr ::= MINUS expr */
       case 36: /* text_expr ::= MINUS text_expr */ yytestcase(yyruleno==36);
 {
-    if (yymsp[0].minor.yy35) {
-        yymsp[-1].minor.yy35 = NewNotNode(yymsp[0].minor.yy35);
+    if (yymsp[0].minor.yy51) {
+        yymsp[-1].minor.yy51 = NewNotNode(yymsp[0].minor.yy51);
     } else {
-        yymsp[-1].minor.yy35 = NULL;
+        yymsp[-1].minor.yy51 = NULL;
     }
 }
         break;
       case 37: /* expr ::= TILDE expr */
       case 38: /* text_expr ::= TILDE text_expr */ yytestcase(yyruleno==38);
 {
-    if (yymsp[0].minor.yy35) {
-        yymsp[-1].minor.yy35 = NewOptionalNode(yymsp[0].minor.yy35);
+    if (yymsp[0].minor.yy51) {
+        yymsp[-1].minor.yy51 = NewOptionalNode(yymsp[0].minor.yy51);
     } else {
-        yymsp[-1].minor.yy35 = NULL;
+        yymsp[-1].minor.yy51 = NULL;
     }
 }
         break;
       case 39: /* affix ::= PREFIX */
 {
-    yylhsminor.yy35 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, true, false);
+    yylhsminor.yy51 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, true, false);
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 40: /* affix ::= SUFFIX */
 {
-    yylhsminor.yy35 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, false, true);
+    yylhsminor.yy51 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, false, true);
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 41: /* affix ::= CONTAINS */
 {
-    yylhsminor.yy35 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, true, true);
+    yylhsminor.yy51 = NewPrefixNode_WithParams(ctx, &yymsp[0].minor.yy0, true, true);
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 42: /* verbatim ::= WILDCARD */
 {
-    yylhsminor.yy35 = NewWildcardNode_WithParams(ctx, &yymsp[0].minor.yy0);
+    yylhsminor.yy51 = NewWildcardNode_WithParams(ctx, &yymsp[0].minor.yy0);
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 43: /* text_expr ::= PERCENT param_term PERCENT */
 {
-  yymsp[-2].minor.yy35 = NewFuzzyNode_WithParams(ctx, &yymsp[-1].minor.yy0, 1);
+  yymsp[-2].minor.yy51 = NewFuzzyNode_WithParams(ctx, &yymsp[-1].minor.yy0, 1);
 }
         break;
       case 44: /* text_expr ::= PERCENT PERCENT param_term PERCENT PERCENT */
 {
-  yymsp[-4].minor.yy35 = NewFuzzyNode_WithParams(ctx, &yymsp[-2].minor.yy0, 2);
+  yymsp[-4].minor.yy51 = NewFuzzyNode_WithParams(ctx, &yymsp[-2].minor.yy0, 2);
 }
         break;
       case 45: /* text_expr ::= PERCENT PERCENT PERCENT param_term PERCENT PERCENT PERCENT */
 {
-  yymsp[-6].minor.yy35 = NewFuzzyNode_WithParams(ctx, &yymsp[-3].minor.yy0, 3);
+  yymsp[-6].minor.yy51 = NewFuzzyNode_WithParams(ctx, &yymsp[-3].minor.yy0, 3);
 }
         break;
       case 46: /* modifier ::= MODIFIER */
@@ -1854,60 +1866,60 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
         break;
       case 47: /* modifierlist ::= modifier OR term */
 {
-    yylhsminor.yy120 = NewVector(char *, 2);
+    yylhsminor.yy114 = NewVector(char *, 2);
     char *s = rm_strndup(yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len);
-    Vector_Push(yylhsminor.yy120, s);
+    Vector_Push(yylhsminor.yy114, s);
     s = rm_strndup(yymsp[0].minor.yy0.s, yymsp[0].minor.yy0.len);
-    Vector_Push(yylhsminor.yy120, s);
+    Vector_Push(yylhsminor.yy114, s);
 }
-  yymsp[-2].minor.yy120 = yylhsminor.yy120;
+  yymsp[-2].minor.yy114 = yylhsminor.yy114;
         break;
       case 48: /* modifierlist ::= modifierlist OR term */
 {
     char *s = rm_strndup(yymsp[0].minor.yy0.s, yymsp[0].minor.yy0.len);
-    Vector_Push(yymsp[-2].minor.yy120, s);
-    yylhsminor.yy120 = yymsp[-2].minor.yy120;
+    Vector_Push(yymsp[-2].minor.yy114, s);
+    yylhsminor.yy114 = yymsp[-2].minor.yy114;
 }
-  yymsp[-2].minor.yy120 = yylhsminor.yy120;
+  yymsp[-2].minor.yy114 = yylhsminor.yy114;
         break;
       case 49: /* expr ::= modifier COLON LB tag_list RB */
 {
-    if (!yymsp[-1].minor.yy35) {
-        yylhsminor.yy35 = NULL;
+    if (!yymsp[-1].minor.yy51) {
+        yylhsminor.yy51 = NULL;
     } else {
       // Tag field names must be case sensitive, we can't do rm_strdupcase
         char *s = rm_strndup(yymsp[-4].minor.yy0.s, yymsp[-4].minor.yy0.len);
         size_t slen = unescapen((char*)s, yymsp[-4].minor.yy0.len);
 
-        yylhsminor.yy35 = NewTagNode(s, slen);
-        QueryNode_AddChildren(yylhsminor.yy35, yymsp[-1].minor.yy35->children, QueryNode_NumChildren(yymsp[-1].minor.yy35));
+        yylhsminor.yy51 = NewTagNode(s, slen);
+        QueryNode_AddChildren(yylhsminor.yy51, yymsp[-1].minor.yy51->children, QueryNode_NumChildren(yymsp[-1].minor.yy51));
 
-        // Set the children count on yymsp[-1].minor.yy35 to 0 so they won't get recursively free'd
-        QueryNode_ClearChildren(yymsp[-1].minor.yy35, 0);
-        QueryNode_Free(yymsp[-1].minor.yy35);
+        // Set the children count on yymsp[-1].minor.yy51 to 0 so they won't get recursively free'd
+        QueryNode_ClearChildren(yymsp[-1].minor.yy51, 0);
+        QueryNode_Free(yymsp[-1].minor.yy51);
     }
 }
-  yymsp[-4].minor.yy35 = yylhsminor.yy35;
+  yymsp[-4].minor.yy51 = yylhsminor.yy51;
         break;
       case 50: /* tag_list ::= param_term */
 {
-  yylhsminor.yy35 = NewPhraseNode(0);
+  yylhsminor.yy51 = NewPhraseNode(0);
   if (yymsp[0].minor.yy0.type == QT_TERM)
     yymsp[0].minor.yy0.type = QT_TERM_CASE;
   else if (yymsp[0].minor.yy0.type == QT_PARAM_TERM)
     yymsp[0].minor.yy0.type = QT_PARAM_TERM_CASE;
-  QueryNode_AddChild(yylhsminor.yy35, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
+  QueryNode_AddChild(yylhsminor.yy51, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 51: /* tag_list ::= affix */
       case 52: /* tag_list ::= verbatim */ yytestcase(yyruleno==52);
       case 53: /* tag_list ::= termlist */ yytestcase(yyruleno==53);
 {
-    yylhsminor.yy35 = NewPhraseNode(0);
-    QueryNode_AddChild(yylhsminor.yy35, yymsp[0].minor.yy35);
+    yylhsminor.yy51 = NewPhraseNode(0);
+    QueryNode_AddChild(yylhsminor.yy51, yymsp[0].minor.yy51);
 }
-  yymsp[0].minor.yy35 = yylhsminor.yy35;
+  yymsp[0].minor.yy51 = yylhsminor.yy51;
         break;
       case 54: /* tag_list ::= tag_list OR param_term */
 {
@@ -1915,31 +1927,31 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
     yymsp[0].minor.yy0.type = QT_TERM_CASE;
   else if (yymsp[0].minor.yy0.type == QT_PARAM_TERM)
     yymsp[0].minor.yy0.type = QT_PARAM_TERM_CASE;
-  QueryNode_AddChild(yymsp[-2].minor.yy35, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
-  yylhsminor.yy35 = yymsp[-2].minor.yy35;
+  QueryNode_AddChild(yymsp[-2].minor.yy51, NewTokenNode_WithParams(ctx, &yymsp[0].minor.yy0));
+  yylhsminor.yy51 = yymsp[-2].minor.yy51;
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 55: /* tag_list ::= tag_list OR affix */
       case 56: /* tag_list ::= tag_list OR verbatim */ yytestcase(yyruleno==56);
       case 57: /* tag_list ::= tag_list OR termlist */ yytestcase(yyruleno==57);
 {
-    QueryNode_AddChild(yymsp[-2].minor.yy35, yymsp[0].minor.yy35);
-    yylhsminor.yy35 = yymsp[-2].minor.yy35;
+    QueryNode_AddChild(yymsp[-2].minor.yy51, yymsp[0].minor.yy51);
+    yylhsminor.yy51 = yymsp[-2].minor.yy51;
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 58: /* expr ::= modifier COLON numeric_range */
 {
-  if (yymsp[0].minor.yy50) {
+  if (yymsp[0].minor.yy30) {
     // we keep the capitalization as is
-    yymsp[0].minor.yy50->nf->fieldName = rm_strndup(yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len);
-    yylhsminor.yy35 = NewNumericNode(yymsp[0].minor.yy50);
+    yymsp[0].minor.yy30->nf->fieldName = rm_strndup(yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len);
+    yylhsminor.yy51 = NewNumericNode(yymsp[0].minor.yy30);
   } else {
-    yylhsminor.yy35 = NewQueryNode(QN_NULL);
+    yylhsminor.yy51 = NewQueryNode(QN_NULL);
   }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 59: /* numeric_range ::= LSQB param_num param_num RSQB */
 {
@@ -1949,20 +1961,20 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
   if (yymsp[-1].minor.yy0.type == QT_PARAM_NUMERIC) {
     yymsp[-1].minor.yy0.type = QT_PARAM_NUMERIC_MAX_RANGE;
   }
-  yymsp[-3].minor.yy50 = NewNumericFilterQueryParam_WithParams(ctx, &yymsp[-2].minor.yy0, &yymsp[-1].minor.yy0, yymsp[-2].minor.yy0.inclusive, yymsp[-1].minor.yy0.inclusive);
+  yymsp[-3].minor.yy30 = NewNumericFilterQueryParam_WithParams(ctx, &yymsp[-2].minor.yy0, &yymsp[-1].minor.yy0, yymsp[-2].minor.yy0.inclusive, yymsp[-1].minor.yy0.inclusive);
 }
         break;
       case 60: /* expr ::= modifier COLON geo_filter */
 {
-  if (yymsp[0].minor.yy50) {
+  if (yymsp[0].minor.yy30) {
     // we keep the capitalization as is
-    yymsp[0].minor.yy50->gf->property = rm_strndup(yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len);
-    yylhsminor.yy35 = NewGeofilterNode(yymsp[0].minor.yy50);
+    yymsp[0].minor.yy30->gf->property = rm_strndup(yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len);
+    yylhsminor.yy51 = NewGeofilterNode(yymsp[0].minor.yy30);
   } else {
-    yylhsminor.yy35 = NewQueryNode(QN_NULL);
+    yylhsminor.yy51 = NewQueryNode(QN_NULL);
   }
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 61: /* geo_filter ::= LSQB param_num param_num param_num param_term RSQB */
 {
@@ -1974,73 +1986,73 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
   if (yymsp[-1].minor.yy0.type == QT_PARAM_TERM)
     yymsp[-1].minor.yy0.type = QT_PARAM_GEO_UNIT;
 
-  yymsp[-5].minor.yy50 = NewGeoFilterQueryParam_WithParams(ctx, &yymsp[-4].minor.yy0, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, &yymsp[-1].minor.yy0);
+  yymsp[-5].minor.yy30 = NewGeoFilterQueryParam_WithParams(ctx, &yymsp[-4].minor.yy0, &yymsp[-3].minor.yy0, &yymsp[-2].minor.yy0, &yymsp[-1].minor.yy0);
 }
         break;
       case 62: /* query ::= expr ARROW LSQB vector_query RSQB */
       case 63: /* query ::= text_expr ARROW LSQB vector_query RSQB */ yytestcase(yyruleno==63);
 { // main parse, hybrid query as entire query case.
   setup_trace(ctx);
-  switch (yymsp[-1].minor.yy35->vn.vq->type) {
+  switch (yymsp[-1].minor.yy51->vn.vq->type) {
     case VECSIM_QT_KNN:
-      yymsp[-1].minor.yy35->vn.vq->knn.order = BY_SCORE;
+      yymsp[-1].minor.yy51->vn.vq->knn.order = BY_SCORE;
       break;
   }
-  ctx->root = yymsp[-1].minor.yy35;
-  if (yymsp[-4].minor.yy35) {
-    QueryNode_AddChild(yymsp[-1].minor.yy35, yymsp[-4].minor.yy35);
+  ctx->root = yymsp[-1].minor.yy51;
+  if (yymsp[-4].minor.yy51) {
+    QueryNode_AddChild(yymsp[-1].minor.yy51, yymsp[-4].minor.yy51);
   }
 }
         break;
       case 64: /* query ::= star ARROW LSQB vector_query RSQB */
-{  yy_destructor(yypParser,55,&yymsp[-4].minor);
+{  yy_destructor(yypParser,56,&yymsp[-4].minor);
 { // main parse, simple vecsim search as entire query case.
   setup_trace(ctx);
-  switch (yymsp[-1].minor.yy35->vn.vq->type) {
+  switch (yymsp[-1].minor.yy51->vn.vq->type) {
     case VECSIM_QT_KNN:
-      yymsp[-1].minor.yy35->vn.vq->knn.order = BY_SCORE;
+      yymsp[-1].minor.yy51->vn.vq->knn.order = BY_SCORE;
       break;
   }
-  ctx->root = yymsp[-1].minor.yy35;
+  ctx->root = yymsp[-1].minor.yy51;
 }
 }
         break;
       case 65: /* vector_query ::= vector_command vector_attribute_list vector_score_field */
 {
-  if (yymsp[-2].minor.yy35->vn.vq->scoreField) {
-    rm_free(yymsp[-2].minor.yy35->vn.vq->scoreField);
-    yymsp[-2].minor.yy35->vn.vq->scoreField = NULL;
+  if (yymsp[-2].minor.yy51->vn.vq->scoreField) {
+    rm_free(yymsp[-2].minor.yy51->vn.vq->scoreField);
+    yymsp[-2].minor.yy51->vn.vq->scoreField = NULL;
   }
-  yymsp[-2].minor.yy35->params = array_grow(yymsp[-2].minor.yy35->params, 1);
-  memset(&array_tail(yymsp[-2].minor.yy35->params), 0, sizeof(*yymsp[-2].minor.yy35->params));
-  QueryNode_SetParam(ctx, &(array_tail(yymsp[-2].minor.yy35->params)), &(yymsp[-2].minor.yy35->vn.vq->scoreField), NULL, &yymsp[0].minor.yy0);
-  yymsp[-2].minor.yy35->vn.vq->params = yymsp[-1].minor.yy32;
-  yylhsminor.yy35 = yymsp[-2].minor.yy35;
+  yymsp[-2].minor.yy51->params = array_grow(yymsp[-2].minor.yy51->params, 1);
+  memset(&array_tail(yymsp[-2].minor.yy51->params), 0, sizeof(*yymsp[-2].minor.yy51->params));
+  QueryNode_SetParam(ctx, &(array_tail(yymsp[-2].minor.yy51->params)), &(yymsp[-2].minor.yy51->vn.vq->scoreField), NULL, &yymsp[0].minor.yy0);
+  yymsp[-2].minor.yy51->vn.vq->params = yymsp[-1].minor.yy10;
+  yylhsminor.yy51 = yymsp[-2].minor.yy51;
 }
-  yymsp[-2].minor.yy35 = yylhsminor.yy35;
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
         break;
       case 66: /* vector_query ::= vector_command vector_score_field */
 {
-  if (yymsp[-1].minor.yy35->vn.vq->scoreField) {
-    rm_free(yymsp[-1].minor.yy35->vn.vq->scoreField);
-    yymsp[-1].minor.yy35->vn.vq->scoreField = NULL;
+  if (yymsp[-1].minor.yy51->vn.vq->scoreField) {
+    rm_free(yymsp[-1].minor.yy51->vn.vq->scoreField);
+    yymsp[-1].minor.yy51->vn.vq->scoreField = NULL;
   }
-  yymsp[-1].minor.yy35->params = array_grow(yymsp[-1].minor.yy35->params, 1);
-  memset(&array_tail(yymsp[-1].minor.yy35->params), 0, sizeof(*yymsp[-1].minor.yy35->params));
-  QueryNode_SetParam(ctx, &(array_tail(yymsp[-1].minor.yy35->params)), &(yymsp[-1].minor.yy35->vn.vq->scoreField), NULL, &yymsp[0].minor.yy0);
-  yylhsminor.yy35 = yymsp[-1].minor.yy35;
+  yymsp[-1].minor.yy51->params = array_grow(yymsp[-1].minor.yy51->params, 1);
+  memset(&array_tail(yymsp[-1].minor.yy51->params), 0, sizeof(*yymsp[-1].minor.yy51->params));
+  QueryNode_SetParam(ctx, &(array_tail(yymsp[-1].minor.yy51->params)), &(yymsp[-1].minor.yy51->vn.vq->scoreField), NULL, &yymsp[0].minor.yy0);
+  yylhsminor.yy51 = yymsp[-1].minor.yy51;
 }
-  yymsp[-1].minor.yy35 = yylhsminor.yy35;
+  yymsp[-1].minor.yy51 = yylhsminor.yy51;
         break;
       case 67: /* vector_query ::= vector_command vector_attribute_list */
 {
-  yymsp[-1].minor.yy35->vn.vq->params = yymsp[0].minor.yy32;
-  yylhsminor.yy35 = yymsp[-1].minor.yy35;
+  yymsp[-1].minor.yy51->vn.vq->params = yymsp[0].minor.yy10;
+  yylhsminor.yy51 = yymsp[-1].minor.yy51;
 }
-  yymsp[-1].minor.yy35 = yylhsminor.yy35;
+  yymsp[-1].minor.yy51 = yylhsminor.yy51;
         break;
       case 69: /* vector_score_field ::= as param_term */
-{  yy_destructor(yypParser,61,&yymsp[-1].minor);
+{  yy_destructor(yypParser,62,&yymsp[-1].minor);
 {
   yymsp[-1].minor.yy0 = yymsp[0].minor.yy0;
 }
@@ -2049,19 +2061,19 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
       case 70: /* query ::= expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
 {
   setup_trace(ctx);
-  switch (yymsp[-5].minor.yy35->vn.vq->type) {
+  switch (yymsp[-5].minor.yy51->vn.vq->type) {
     case VECSIM_QT_KNN:
-      yymsp[-5].minor.yy35->vn.vq->knn.order = BY_SCORE;
+      yymsp[-5].minor.yy51->vn.vq->knn.order = BY_SCORE;
       break;
   }
-  ctx->root = yymsp[-5].minor.yy35;
-  if (yymsp[-5].minor.yy35 && yymsp[-1].minor.yy27) {
-     QueryNode_ApplyAttributes(yymsp[-5].minor.yy35, yymsp[-1].minor.yy27, array_len(yymsp[-1].minor.yy27), ctx->status);
+  ctx->root = yymsp[-5].minor.yy51;
+  if (yymsp[-5].minor.yy51 && yymsp[-1].minor.yy33) {
+     QueryNode_ApplyAttributes(yymsp[-5].minor.yy51, yymsp[-1].minor.yy33, array_len(yymsp[-1].minor.yy33), ctx->status);
   }
-  array_free_ex(yymsp[-1].minor.yy27, rm_free((char*)((QueryAttribute*)ptr )->value));
+  array_free_ex(yymsp[-1].minor.yy33, rm_free((char*)((QueryAttribute*)ptr )->value));
 
-  if (yymsp[-8].minor.yy35) {
-      QueryNode_AddChild(yymsp[-5].minor.yy35, yymsp[-8].minor.yy35);
+  if (yymsp[-8].minor.yy51) {
+      QueryNode_AddChild(yymsp[-5].minor.yy51, yymsp[-8].minor.yy51);
   }
 
 }
@@ -2069,36 +2081,36 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
       case 71: /* query ::= text_expr ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
 {
   setup_trace(ctx);
-  switch (yymsp[-5].minor.yy35->vn.vq->type) {
+  switch (yymsp[-5].minor.yy51->vn.vq->type) {
     case VECSIM_QT_KNN:
-      yymsp[-5].minor.yy35->vn.vq->knn.order = BY_SCORE;
+      yymsp[-5].minor.yy51->vn.vq->knn.order = BY_SCORE;
       break;
   }
-  ctx->root = yymsp[-5].minor.yy35;
-  if (yymsp[-5].minor.yy35 && yymsp[-1].minor.yy27) {
-     QueryNode_ApplyAttributes(yymsp[-5].minor.yy35, yymsp[-1].minor.yy27, array_len(yymsp[-1].minor.yy27), ctx->status);
+  ctx->root = yymsp[-5].minor.yy51;
+  if (yymsp[-5].minor.yy51 && yymsp[-1].minor.yy33) {
+     QueryNode_ApplyAttributes(yymsp[-5].minor.yy51, yymsp[-1].minor.yy33, array_len(yymsp[-1].minor.yy33), ctx->status);
   }
-  array_free_ex(yymsp[-1].minor.yy27, rm_free((char*)((QueryAttribute*)ptr )->value));
+  array_free_ex(yymsp[-1].minor.yy33, rm_free((char*)((QueryAttribute*)ptr )->value));
 
-  if (yymsp[-8].minor.yy35) {
-    QueryNode_AddChild(yymsp[-5].minor.yy35, yymsp[-8].minor.yy35);
+  if (yymsp[-8].minor.yy51) {
+    QueryNode_AddChild(yymsp[-5].minor.yy51, yymsp[-8].minor.yy51);
   }
 }
         break;
       case 72: /* query ::= star ARROW LSQB vector_query RSQB ARROW LB attribute_list RB */
-{  yy_destructor(yypParser,55,&yymsp[-8].minor);
+{  yy_destructor(yypParser,56,&yymsp[-8].minor);
 {
   setup_trace(ctx);
-  switch (yymsp[-5].minor.yy35->vn.vq->type) {
+  switch (yymsp[-5].minor.yy51->vn.vq->type) {
     case VECSIM_QT_KNN:
-      yymsp[-5].minor.yy35->vn.vq->knn.order = BY_SCORE;
+      yymsp[-5].minor.yy51->vn.vq->knn.order = BY_SCORE;
       break;
   }
-  ctx->root = yymsp[-5].minor.yy35;
-  if (yymsp[-5].minor.yy35 && yymsp[-1].minor.yy27) {
-     QueryNode_ApplyAttributes(yymsp[-5].minor.yy35, yymsp[-1].minor.yy27, array_len(yymsp[-1].minor.yy27), ctx->status);
+  ctx->root = yymsp[-5].minor.yy51;
+  if (yymsp[-5].minor.yy51 && yymsp[-1].minor.yy33) {
+     QueryNode_ApplyAttributes(yymsp[-5].minor.yy51, yymsp[-1].minor.yy33, array_len(yymsp[-1].minor.yy33), ctx->status);
   }
-  array_free_ex(yymsp[-1].minor.yy27, rm_free((char*)((QueryAttribute*)ptr )->value));
+  array_free_ex(yymsp[-1].minor.yy33, rm_free((char*)((QueryAttribute*)ptr )->value));
 
 }
 }
@@ -2107,103 +2119,124 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
 {
   if (!strncasecmp("KNN", yymsp[-3].minor.yy0.s, yymsp[-3].minor.yy0.len)) {
     yymsp[0].minor.yy0.type = QT_PARAM_VEC;
-    yylhsminor.yy35 = NewVectorNode_WithParams(ctx, VECSIM_QT_KNN, &yymsp[-2].minor.yy0, &yymsp[0].minor.yy0);
-    yylhsminor.yy35->vn.vq->property = rm_strndup(yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len);
-    RedisModule_Assert(-1 != (rm_asprintf(&yylhsminor.yy35->vn.vq->scoreField, "__%.*s_score", yymsp[-1].minor.yy0.len, yymsp[-1].minor.yy0.s)));
+    yylhsminor.yy51 = NewVectorNode_WithParams(ctx, VECSIM_QT_KNN, &yymsp[-2].minor.yy0, &yymsp[0].minor.yy0);
+    yylhsminor.yy51->vn.vq->property = rm_strndup(yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len);
+    RedisModule_Assert(-1 != (rm_asprintf(&yylhsminor.yy51->vn.vq->scoreField, "__%.*s_score", yymsp[-1].minor.yy0.len, yymsp[-1].minor.yy0.s)));
   } else {
     reportSyntaxError(ctx->status, &yymsp[-3].minor.yy0, "Syntax error: Expecting Vector Similarity command");
-    yylhsminor.yy35 = NULL;
+    yylhsminor.yy51 = NULL;
   }
 }
-  yymsp[-3].minor.yy35 = yylhsminor.yy35;
+  yymsp[-3].minor.yy51 = yylhsminor.yy51;
         break;
-      case 74: /* vector_attribute ::= TERM param_term */
+      case 74: /* expr ::= modifier COLON LSQB vector_range_command RSQB */
+{
+  if (yymsp[-1].minor.yy51) {
+    yymsp[-1].minor.yy51->vn.vq->property = rm_strndup(yymsp[-4].minor.yy0.s, yymsp[-4].minor.yy0.len);
+  }
+  yylhsminor.yy51 = yymsp[-1].minor.yy51;
+}
+  yymsp[-4].minor.yy51 = yylhsminor.yy51;
+        break;
+      case 75: /* vector_range_command ::= TERM param_num ATTRIBUTE */
+{
+  if (yymsp[-2].minor.yy0.len == strlen("VECTOR_RANGE") && !strncasecmp("VECTOR_RANGE", yymsp[-2].minor.yy0.s, yymsp[-2].minor.yy0.len)) {
+    yymsp[0].minor.yy0.type = QT_PARAM_VEC;
+    yylhsminor.yy51 = NewVectorNode_WithParams(ctx, VECSIM_QT_RANGE, &yymsp[-1].minor.yy0, &yymsp[0].minor.yy0);
+  } else {
+    reportSyntaxError(ctx->status, &yymsp[-2].minor.yy0, "Syntax error: Expecting Vector Similarity command");
+    yylhsminor.yy51 = NULL;
+  }
+}
+  yymsp[-2].minor.yy51 = yylhsminor.yy51;
+        break;
+      case 76: /* vector_attribute ::= TERM param_term */
 {
   const char *value = rm_strndup(yymsp[0].minor.yy0.s, yymsp[0].minor.yy0.len);
   const char *name = rm_strndup(yymsp[-1].minor.yy0.s, yymsp[-1].minor.yy0.len);
-  yylhsminor.yy5.param = (VecSimRawParam){ .name = name, .nameLen = yymsp[-1].minor.yy0.len, .value = value, .valLen = yymsp[0].minor.yy0.len };
+  yylhsminor.yy29.param = (VecSimRawParam){ .name = name, .nameLen = yymsp[-1].minor.yy0.len, .value = value, .valLen = yymsp[0].minor.yy0.len };
   if (yymsp[0].minor.yy0.type == QT_PARAM_TERM) {
-    yylhsminor.yy5.needResolve = true;
+    yylhsminor.yy29.needResolve = true;
   }
   else { // if yymsp[0].minor.yy0.type == QT_TERM
-    yylhsminor.yy5.needResolve = false;
+    yylhsminor.yy29.needResolve = false;
   }
 }
-  yymsp[-1].minor.yy5 = yylhsminor.yy5;
+  yymsp[-1].minor.yy29 = yylhsminor.yy29;
         break;
-      case 75: /* vector_attribute_list ::= vector_attribute_list vector_attribute */
+      case 77: /* vector_attribute_list ::= vector_attribute_list vector_attribute */
 {
-  yylhsminor.yy32.params = array_append(yymsp[-1].minor.yy32.params, yymsp[0].minor.yy5.param);
-  yylhsminor.yy32.needResolve = array_append(yymsp[-1].minor.yy32.needResolve, yymsp[0].minor.yy5.needResolve);
+  yylhsminor.yy10.params = array_append(yymsp[-1].minor.yy10.params, yymsp[0].minor.yy29.param);
+  yylhsminor.yy10.needResolve = array_append(yymsp[-1].minor.yy10.needResolve, yymsp[0].minor.yy29.needResolve);
 }
-  yymsp[-1].minor.yy32 = yylhsminor.yy32;
+  yymsp[-1].minor.yy10 = yylhsminor.yy10;
         break;
-      case 76: /* vector_attribute_list ::= vector_attribute */
+      case 78: /* vector_attribute_list ::= vector_attribute */
 {
-  yylhsminor.yy32.params = array_new(VecSimRawParam, 1);
-  yylhsminor.yy32.needResolve = array_new(bool, 1);
-  yylhsminor.yy32.params = array_append(yylhsminor.yy32.params, yymsp[0].minor.yy5.param);
-  yylhsminor.yy32.needResolve = array_append(yylhsminor.yy32.needResolve, yymsp[0].minor.yy5.needResolve);
+  yylhsminor.yy10.params = array_new(VecSimRawParam, 1);
+  yylhsminor.yy10.needResolve = array_new(bool, 1);
+  yylhsminor.yy10.params = array_append(yylhsminor.yy10.params, yymsp[0].minor.yy29.param);
+  yylhsminor.yy10.needResolve = array_append(yylhsminor.yy10.needResolve, yymsp[0].minor.yy29.needResolve);
 }
-  yymsp[0].minor.yy32 = yylhsminor.yy32;
+  yymsp[0].minor.yy10 = yylhsminor.yy10;
         break;
-      case 77: /* num ::= SIZE */
-      case 78: /* num ::= NUMBER */ yytestcase(yyruleno==78);
+      case 79: /* num ::= SIZE */
+      case 80: /* num ::= NUMBER */ yytestcase(yyruleno==80);
 {
-  yylhsminor.yy83.num = yymsp[0].minor.yy0.numval;
-  yylhsminor.yy83.inclusive = 1;
+  yylhsminor.yy127.num = yymsp[0].minor.yy0.numval;
+  yylhsminor.yy127.inclusive = 1;
 }
-  yymsp[0].minor.yy83 = yylhsminor.yy83;
+  yymsp[0].minor.yy127 = yylhsminor.yy127;
         break;
-      case 79: /* num ::= LP num */
+      case 81: /* num ::= LP num */
 {
-  yymsp[-1].minor.yy83=yymsp[0].minor.yy83;
-  yymsp[-1].minor.yy83.inclusive = 0;
+  yymsp[-1].minor.yy127=yymsp[0].minor.yy127;
+  yymsp[-1].minor.yy127.inclusive = 0;
 }
         break;
-      case 80: /* num ::= MINUS num */
+      case 82: /* num ::= MINUS num */
 {
-  yymsp[0].minor.yy83.num = -yymsp[0].minor.yy83.num;
-  yymsp[-1].minor.yy83 = yymsp[0].minor.yy83;
+  yymsp[0].minor.yy127.num = -yymsp[0].minor.yy127.num;
+  yymsp[-1].minor.yy127 = yymsp[0].minor.yy127;
 }
         break;
-      case 81: /* term ::= TERM */
-      case 82: /* term ::= NUMBER */ yytestcase(yyruleno==82);
-      case 83: /* term ::= SIZE */ yytestcase(yyruleno==83);
+      case 83: /* term ::= TERM */
+      case 84: /* term ::= NUMBER */ yytestcase(yyruleno==84);
+      case 85: /* term ::= SIZE */ yytestcase(yyruleno==85);
 {
   yylhsminor.yy0 = yymsp[0].minor.yy0;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 84: /* param_term ::= term */
+      case 86: /* param_term ::= term */
 {
   yylhsminor.yy0 = yymsp[0].minor.yy0;
   yylhsminor.yy0.type = QT_TERM;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 85: /* param_term ::= ATTRIBUTE */
+      case 87: /* param_term ::= ATTRIBUTE */
 {
   yylhsminor.yy0 = yymsp[0].minor.yy0;
   yylhsminor.yy0.type = QT_PARAM_TERM;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 86: /* param_size ::= SIZE */
+      case 88: /* param_size ::= SIZE */
 {
   yylhsminor.yy0 = yymsp[0].minor.yy0;
   yylhsminor.yy0.type = QT_SIZE;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 87: /* param_size ::= ATTRIBUTE */
+      case 89: /* param_size ::= ATTRIBUTE */
 {
   yylhsminor.yy0 = yymsp[0].minor.yy0;
   yylhsminor.yy0.type = QT_PARAM_SIZE;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 88: /* param_num ::= ATTRIBUTE */
+      case 90: /* param_num ::= ATTRIBUTE */
 {
     yylhsminor.yy0 = yymsp[0].minor.yy0;
     yylhsminor.yy0.type = QT_PARAM_NUMERIC;
@@ -2211,29 +2244,29 @@ yylhsminor.yy35 = yymsp[0].minor.yy35;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 89: /* param_num ::= num */
+      case 91: /* param_num ::= num */
 {
-  yylhsminor.yy0.numval = yymsp[0].minor.yy83.num;
-  yylhsminor.yy0.inclusive = yymsp[0].minor.yy83.inclusive;
+  yylhsminor.yy0.numval = yymsp[0].minor.yy127.num;
+  yylhsminor.yy0.inclusive = yymsp[0].minor.yy127.inclusive;
   yylhsminor.yy0.type = QT_NUMERIC;
 }
   yymsp[0].minor.yy0 = yylhsminor.yy0;
         break;
-      case 90: /* param_num ::= LP ATTRIBUTE */
+      case 92: /* param_num ::= LP ATTRIBUTE */
 {
     yymsp[-1].minor.yy0 = yymsp[0].minor.yy0;
     yymsp[-1].minor.yy0.type = QT_PARAM_NUMERIC;
     yymsp[-1].minor.yy0.inclusive = 0;
 }
         break;
-      case 92: /* star ::= LP star RP */
+      case 94: /* star ::= LP star RP */
 {
 }
-  yy_destructor(yypParser,55,&yymsp[-1].minor);
+  yy_destructor(yypParser,56,&yymsp[-1].minor);
         break;
       default:
-      /* (91) star ::= STAR */ yytestcase(yyruleno==91);
-      /* (93) as ::= AS_T */ yytestcase(yyruleno==93);
+      /* (93) star ::= STAR */ yytestcase(yyruleno==93);
+      /* (95) as ::= AS_T */ yytestcase(yyruleno==95);
         break;
 /********** End reduce actions ************************************************/
   };
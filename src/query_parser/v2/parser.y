@@ -184,6 +184,9 @@ static void reportSyntaxError(QueryError *status, QueryToken* tok, const char *m
 %type vector_command { QueryNode *}
 %destructor vector_command { QueryNode_Free($$); }
 
+%type vector_range_command { QueryNode *}
+%destructor vector_range_command { QueryNode_Free($$); }
+
 %type vector_attribute { SingleVectorQueryParam }
 // This destructor is commented out because it's not reachable: every vector_attribute that created
 // successfuly can successfuly be reduced to vector_attribute_list.
@@ -982,6 +985,24 @@ vector_command(A) ::= TERM(T) param_size(B) modifier(C) ATTRIBUTE(D). {
   }
 }
 
+// A range query is a regular filter expression, so it can be combined with any other expression.
+expr(A) ::= modifier(B) COLON LSQB vector_range_command(C) RSQB. {
+  if (C) {
+    C->vn.vq->property = rm_strndup(B.s, B.len);
+  }
+  A = C;
+}
+
+vector_range_command(A) ::= TERM(T) param_num(B) ATTRIBUTE(C). {
+  if (T.len == strlen("VECTOR_RANGE") && !strncasecmp("VECTOR_RANGE", T.s, T.len)) {
+    C.type = QT_PARAM_VEC;
+    A = NewVectorNode_WithParams(ctx, VECSIM_QT_RANGE, &B, &C);
+  } else {
+    reportSyntaxError(ctx->status, &T, "Syntax error: Expecting Vector Similarity command");
+    A = NULL;
+  }
+}
+
 vector_attribute(A) ::= TERM(B) param_term(C). {
   const char *value = rm_strndup(C.s, C.len);
   const char *name = rm_strndup(B.s, B.len);
@@ -153,10 +153,7 @@ RSFieldID RediSearch_CreateField(IndexSpec* sp, const char* name, unsigned types
     fs->options |= FieldSpec_WithSuffixTrie;
     if (fs->types == INDEXFLD_T_FULLTEXT) {
       sp->suffixMask |= FIELD_BIT(fs);
-      if (!sp->suffix) {
-        sp->suffix = NewTrie(suffixTrie_freeCallback, Trie_Sort_Lex);
-        sp->flags |= Index_HasSuffixTrie;
-      }
+      IndexSpec_InitSuffixIndex(sp);
     }
   }
 
@@ -366,7 +363,7 @@ QueryNode* RediSearch_CreateGeoNode(IndexSpec* sp, const char* field, double lat
   QueryNode* ret = NewQueryNode(QN_GEO);
   ret->opts.fieldMask = IndexSpec_GetFieldBit(sp, field, strlen(field));
 
-  GeoFilter *flt = rm_malloc(sizeof(*flt));
+  GeoFilter *flt = rm_calloc(1, sizeof(*flt));
   flt->lat = lat;
   flt->lon = lon;
   flt->radius = radius;
@@ -6,6 +6,10 @@
 #include "rmutil/rm_assert.h"
 #include "rmutil/cxx/chrono-clock.h"
 #include "util/timeout.h"
+#include "tag_index.h"
+#include "util/arr.h"
+
+#include <math.h>
 
 /*******************************************************************************************************************
  *  General Result Processor Helper functions
@@ -257,6 +261,27 @@ typedef struct {
   size_t nkeys;
 } RPVecSim;
 
+// Find the distance result of the vector node in a result tree. A KNN query keeps it at the root
+// (or as the first child of a hybrid result), while a range query may sit anywhere below an
+// intersection or a union.
+static const RSIndexResult *findDistanceResult(const RSIndexResult *r) {
+  if (r->type == RSResultType_Distance) {
+    return r;
+  }
+  if (r->type == RSResultType_HybridDistance) {
+    return r->agg.children[0];
+  }
+  if (r->type & (RSResultType_Intersection | RSResultType_Union)) {
+    for (int i = 0; i < r->agg.numChildren; i++) {
+      const RSIndexResult *found = findDistanceResult(r->agg.children[i]);
+      if (found) {
+        return found;
+      }
+    }
+  }
+  return NULL;
+}
+
 static int rpvecsimNext(ResultProcessor *base, SearchResult *res) {
   int rc;
   RPVecSim *self = (RPVecSim *)base;
@@ -272,15 +297,11 @@ static int rpvecsimNext(ResultProcessor *base, SearchResult *res) {
   //  stored in some entry of the self->keys array
   RS_LOG_ASSERT(self->nkeys == 1, "Internal error, number of vector fields in a query is at most 1");
   for (size_t i = 0; i < self->nkeys; i++) {
-    RSValue *val;
-    if (res->indexResult->type == RSResultType_HybridDistance) {
-      val = RS_NumVal(res->indexResult->agg.children[0]->dist.distance);
-    } else {
-      // The entire query is a TOP-K query, or this is hybrid query that doesn't use the doc score,
-      // so the distance is saved in the root of indexResult.
-      val = RS_NumVal(res->indexResult->dist.distance);
+    // A range query under a union may not have matched this document
+    const RSIndexResult *dist = findDistanceResult(res->indexResult);
+    if (dist) {
+      RLookup_WriteOwnKey(self->keys[i], &(res->rowdata), RS_NumVal(dist->dist.distance));
     }
-    RLookup_WriteOwnKey(self->keys[i], &(res->rowdata), val);
   }
 
   return rc;
@@ -610,6 +631,236 @@ void SortAscMap_Dump(uint64_t tt, size_t n) {
   printf("\n");
 }
 
+/*******************************************************************************************************************
+ *  Fusion Processor
+ *
+ * It takes scored results from upstream, out of a union of the text query and the KNN query, and replaces each
+ * score with a fusion of the result's place in the text ranking and in the vector ranking: either reciprocal rank
+ * fusion, or a weighted sum of the normalized text score and vector distance. The sorter downstream then orders
+ * the results by the fused score.
+ *
+ * Like the sorter it is a reducer, as ranks are only known once all the results are in. With a window only the
+ * top results of each ranking take part, so text results that did not match the KNN query are kept in a heap of
+ * the window's size and the rest are dropped as soon as they arrive.
+ *******************************************************************************************************************/
+
+typedef struct {
+  SearchResult *r;
+  // NAN if the result did not match the KNN query
+  double distance;
+  // 1 based ranks, 0 if the result takes no part in the ranking
+  size_t textRank;
+  size_t vecRank;
+} FusionEntry;
+
+typedef struct {
+  ResultProcessor base;
+  FusionOptions opts;
+
+  // The accumulated results, yielded from `offset` once we're done
+  FusionEntry *entries;
+  size_t offset;
+
+  // Text-only results, bounded by the window. NULL if there is no window
+  heap_t *textOnly;
+
+  // pooled result - we recycle it to avoid allocations
+  SearchResult *pooledResult;
+} RPFusion;
+
+typedef struct {
+  double key;
+  size_t idx;
+} FusionRankEntry;
+
+static int cmpFusionRank(const void *p1, const void *p2) {
+  const FusionRankEntry *e1 = p1, *e2 = p2;
+  if (e1->key < e2->key) {
+    return -1;
+  } else if (e1->key > e2->key) {
+    return 1;
+  }
+  return e1->idx < e2->idx ? -1 : 1;
+}
+
+// Sort the first n rank entries and assign the ranks of the ones within the window. Returns the
+// number of ranked entries
+static size_t rpfusionRank(RPFusion *self, FusionRankEntry *ranks, size_t n, int byText) {
+  qsort(ranks, n, sizeof(*ranks), cmpFusionRank);
+  if (self->opts.window && n > self->opts.window) {
+    n = self->opts.window;
+  }
+  for (size_t ii = 0; ii < n; ++ii) {
+    FusionEntry *e = self->entries + ranks[ii].idx;
+    if (byText) {
+      e->textRank = ii + 1;
+    } else {
+      e->vecRank = ii + 1;
+    }
+  }
+  return n;
+}
+
+static void rpfusionApply(RPFusion *self, ResultProcessor *rp) {
+  if (self->textOnly) {
+    SearchResult *h;
+    while ((h = mmh_pop_max(self->textOnly))) {
+      FusionEntry e = {.r = h, .distance = NAN};
+      self->entries = array_append(self->entries, e);
+    }
+  }
+  size_t n = array_len(self->entries);
+  if (!n) {
+    return;
+  }
+
+  // Rank by text score (descending) and by vector distance (ascending)
+  FusionRankEntry *ranks = rm_malloc(n * sizeof(*ranks));
+  size_t nranks = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    if (self->entries[ii].r->score > 0) {
+      ranks[nranks++] = (FusionRankEntry){.key = -self->entries[ii].r->score, .idx = ii};
+    }
+  }
+  nranks = rpfusionRank(self, ranks, nranks, 1);
+  double maxScore = nranks ? -ranks[0].key : 0;
+
+  nranks = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    if (!isnan(self->entries[ii].distance)) {
+      ranks[nranks++] = (FusionRankEntry){.key = self->entries[ii].distance, .idx = ii};
+    }
+  }
+  nranks = rpfusionRank(self, ranks, nranks, 0);
+  double minDist = nranks ? ranks[0].key : 0;
+  double maxDist = nranks ? ranks[nranks - 1].key : 0;
+  rm_free(ranks);
+
+  double w = self->opts.weight;
+  size_t kept = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    FusionEntry *e = self->entries + ii;
+    if (self->opts.window && !e->textRank && !e->vecRank) {
+      // Outside of both windows
+      srDtor(e->r);
+      rp->parent->totalResults--;
+      continue;
+    }
+
+    double score = 0;
+    if (self->opts.method == FusionMethod_RRF) {
+      if (e->textRank) {
+        score += w / (FUSION_RRF_K + e->textRank);
+      }
+      if (e->vecRank) {
+        score += (1 - w) / (FUSION_RRF_K + e->vecRank);
+      }
+    } else {
+      if (e->textRank) {
+        score += w * e->r->score / maxScore;
+      }
+      if (e->vecRank) {
+        score += (1 - w) * (maxDist == minDist ? 1 : (maxDist - e->distance) / (maxDist - minDist));
+      }
+    }
+    e->r->score = score;
+    self->entries[kept++] = *e;
+  }
+  self->entries = array_trimm(self->entries, kept, ARR_CAP_NOSHRINK);
+}
+
+static int rpfusionNext_Yield(ResultProcessor *rp, SearchResult *r) {
+  RPFusion *self = (RPFusion *)rp;
+  if (self->offset < array_len(self->entries)) {
+    SearchResult *sr = self->entries[self->offset++].r;
+    RLookupRow oldrow = r->rowdata;
+    *r = *sr;
+
+    rm_free(sr);
+    RLookupRow_Cleanup(&oldrow);
+    return RS_RESULT_OK;
+  }
+  return RS_RESULT_EOF;
+}
+
+static int rpfusionNext_Accum(ResultProcessor *rp, SearchResult *r) {
+  RPFusion *self = (RPFusion *)rp;
+
+  while (1) {
+    if (self->pooledResult == NULL) {
+      self->pooledResult = rm_calloc(1, sizeof(*self->pooledResult));
+    } else {
+      RLookupRow_Wipe(&self->pooledResult->rowdata);
+    }
+
+    SearchResult *h = self->pooledResult;
+    int rc = rp->upstream->Next(rp->upstream, h);
+
+    // if our upstream has finished - fuse the scores and yield
+    if (rc == RS_RESULT_EOF || (rc == RS_RESULT_TIMEDOUT && RSGlobalConfig.timeoutPolicy == TimeoutPolicy_Return)) {
+      rpfusionApply(self, rp);
+      rp->Next = rpfusionNext_Yield;
+      return rpfusionNext_Yield(rp, r);
+    } else if (rc != RS_RESULT_OK) {
+      return rc;
+    }
+
+    // The index result does not outlive this call, so take the distance now
+    const RSIndexResult *dist = findDistanceResult(h->indexResult);
+    h->indexResult = NULL;
+
+    if (!dist && self->textOnly) {
+      if (self->textOnly->count < self->opts.window) {
+        mmh_insert(self->textOnly, h);
+        self->pooledResult = NULL;
+      } else {
+        // Only the best text-only results can make it into the text window
+        if (cmpByScore(h, mmh_peek_min(self->textOnly), NULL) > 0) {
+          self->pooledResult = mmh_pop_min(self->textOnly);
+          mmh_insert(self->textOnly, h);
+        }
+        SearchResult_Clear(self->pooledResult);
+        rp->parent->totalResults--;
+      }
+      continue;
+    }
+
+    FusionEntry e = {.r = h, .distance = dist ? dist->dist.distance : NAN};
+    self->entries = array_append(self->entries, e);
+    self->pooledResult = NULL;
+  }
+}
+
+static void rpfusionFree(ResultProcessor *rp) {
+  RPFusion *self = (RPFusion *)rp;
+  if (self->pooledResult) {
+    SearchResult_Destroy(self->pooledResult);
+    rm_free(self->pooledResult);
+  }
+  for (size_t ii = self->offset; ii < array_len(self->entries); ++ii) {
+    srDtor(self->entries[ii].r);
+  }
+  array_free(self->entries);
+  if (self->textOnly) {
+    // calling mmh_free will free all the remaining results in the heap, if any
+    mmh_free(self->textOnly);
+  }
+  rm_free(rp);
+}
+
+ResultProcessor *RPFusion_New(const FusionOptions *opts) {
+  RPFusion *ret = rm_calloc(1, sizeof(*ret));
+  ret->opts = *opts;
+  ret->entries = array_new(FusionEntry, 16);
+  if (opts->window) {
+    ret->textOnly = mmh_init_with_size(opts->window + 1, cmpByScore, NULL, srDtor);
+  }
+  ret->base.Next = rpfusionNext_Accum;
+  ret->base.Free = rpfusionFree;
+  ret->base.type = RP_FUSION;
+  return &ret->base;
+}
+
 /*******************************************************************************************************************
  *  Paging Processor
  *
@@ -675,13 +926,96 @@ ResultProcessor *RPPager_New(size_t offset, size_t limit) {
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+// A loaded key that can be read from the column of its tag field instead of the document
+typedef struct {
+  const RLookupKey *key;
+  const TagIndex *tidx;
+  arrayof(RSValue *) values;  // dictionary id -> shared value, created on first use
+  uint32_t dictRevision;      // revision of the dictionary the values were created for
+} RPLoaderTagColumn;
+
 typedef struct {
   ResultProcessor base;
   RLookup *lk;
   const RLookupKey **fields;
   size_t nfields;
+
+  bool tagColumnsResolved;
+  arrayof(RPLoaderTagColumn) tagColumns;
+  const RLookupKey **pending;  // keys that still need to be loaded from the document
 } RPLoader;
 
+/* Find the explicitly loaded keys that map to a TAG field of a hash index. Those are read from
+ * the tag column when the document's value was recorded there, see TagIndex_GetDocValue */
+static void rploaderResolveTagColumns(RPLoader *lc, RedisSearchCtx *sctx) {
+  lc->tagColumnsResolved = true;
+  for (size_t ii = 0; ii < lc->nfields; ++ii) {
+    const RLookupKey *kk = lc->fields[ii];
+    if (kk->fieldtype != RLOOKUP_C_STR) continue;
+    const TagIndex *tidx = TagIndex_OpenColumn(sctx, kk->path);
+    if (tidx) {
+      RPLoaderTagColumn tc = {.key = kk, .tidx = tidx, .values = NULL};
+      lc->tagColumns = array_ensure_append_1(lc->tagColumns, tc);
+    }
+  }
+  if (lc->tagColumns) {
+    lc->pending = rm_calloc(lc->nfields, sizeof(*lc->pending));
+  }
+}
+
+static void rploaderClearTagColumnValues(RPLoaderTagColumn *tc) {
+  for (size_t ii = 0; ii < array_len(tc->values); ++ii) {
+    if (tc->values[ii]) {
+      RSValue_Decref(tc->values[ii]);
+    }
+  }
+  array_free(tc->values);
+  tc->values = NULL;
+}
+
+static inline bool rploaderIsTagColumnKey(const RPLoader *lc, const RLookupKey *kk) {
+  for (size_t ii = 0; ii < array_len(lc->tagColumns); ++ii) {
+    if (lc->tagColumns[ii].key == kk) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Write the values found in the tag columns to the row, and collect the keys that are left to
+ * load into lc->pending. Returns the number of pending keys */
+static size_t rploaderReadTagColumns(RPLoader *lc, SearchResult *r) {
+  size_t npending = 0;
+  for (size_t ii = 0; ii < array_len(lc->tagColumns); ++ii) {
+    RPLoaderTagColumn *tc = lc->tagColumns + ii;
+    const TagIndex *tidx = tc->tidx;
+    const TagDictEntry *e = TagIndex_GetDocValue(tidx, r->docId);
+    if (!e) {
+      lc->pending[npending++] = tc->key;
+      continue;
+    }
+
+    // rows share one value per dictionary id, as long as the GC did not release any id
+    if (tc->dictRevision != tidx->dictRevision) {
+      rploaderClearTagColumnValues(tc);
+      tc->dictRevision = tidx->dictRevision;
+    }
+    size_t id = e - tidx->dict;
+    RSValue **vp = array_ensure_at(&tc->values, id, RSValue *);
+    if (!*vp) {
+      *vp = RS_NewCopiedString(e->value, e->len);
+    }
+    RLookup_WriteKey(tc->key, &r->rowdata, *vp);
+  }
+
+  for (size_t ii = 0; ii < lc->nfields; ++ii) {
+    if (!rploaderIsTagColumnKey(lc, lc->fields[ii])) {
+      lc->pending[npending++] = lc->fields[ii];
+    }
+  }
+  return npending;
+}
+
 static int rploaderNext(ResultProcessor *base, SearchResult *r) {
   RPLoader *lc = (RPLoader *)base;
   int rc = base->upstream->Next(base->upstream, r);
@@ -698,14 +1032,30 @@ static int rploaderNext(ResultProcessor *base, SearchResult *r) {
   }
   RedisSearchCtx *sctx = lc->base.parent->sctx;
 
+  const RLookupKey **keys = lc->fields;
+  size_t nkeys = lc->nfields;
+  if (isExplicitReturn) {
+    if (!lc->tagColumnsResolved) {
+      rploaderResolveTagColumns(lc, sctx);
+    }
+    if (lc->tagColumns) {
+      keys = lc->pending;
+      nkeys = rploaderReadTagColumns(lc, r);
+      if (!nkeys) {
+        // everything was read from the tag columns, no need to open the document
+        return RS_RESULT_OK;
+      }
+    }
+  }
+
   QueryError status = {0};
   RLookupLoadOptions loadopts = {.sctx = lc->base.parent->sctx,  // lb
                                   .dmd = r->dmd,
                                   .noSortables = 1,
                                   .forceString = 1,
                                   .status = &status,
-                                  .keys = lc->fields,
-                                  .nkeys = lc->nfields};
+                                  .keys = keys,
+                                  .nkeys = nkeys};
   if (isExplicitReturn) {
     loadopts.mode |= RLOOKUP_LOAD_KEYLIST;
   } else {
@@ -718,6 +1068,11 @@ static int rploaderNext(ResultProcessor *base, SearchResult *r) {
 
 static void rploaderFree(ResultProcessor *base) {
   RPLoader *lc = (RPLoader *)base;
+  for (size_t ii = 0; ii < array_len(lc->tagColumns); ++ii) {
+    rploaderClearTagColumnValues(lc->tagColumns + ii);
+  }
+  array_free(lc->tagColumns);
+  rm_free(lc->pending);
   rm_free(lc->fields);
   rm_free(lc);
 }
@@ -738,7 +1093,7 @@ ResultProcessor *RPLoader_New(RLookup *lk, const RLookupKey **keys, size_t nkeys
 static char *RPTypeLookup[RP_MAX] = {"Index",     "Loader",        "Scorer",      "Sorter",
                                      "Counter",   "Pager/Limiter", "Highlighter", "Grouper",
                                      "Projector", "Filter",        "Profile",     "Network",
-                                     "Vector Similarity Scores Loader"};
+                                     "Vector Similarity Scores Loader", "Fusion"};
 
 const char *RPTypeToString(ResultProcessorType type) {
   RS_LOG_ASSERT(type >= 0 && type < RP_MAX, "enum is out of range");
@@ -59,6 +59,7 @@ typedef enum {
   RP_PROFILE,
   RP_NETWORK,
   RP_VECSIM,
+  RP_FUSION,
   RP_MAX,
 } ResultProcessorType;
 
@@ -196,6 +197,10 @@ ResultProcessor *RPScorer_New(const ExtScoringFunctionCtx *funcs,
 
 ResultProcessor *RPVecSim_New(const RLookupKey **keys, size_t nkeys);
 
+/* Replace the text scores of the results with their fusion with the vector distances, as set by
+ * the FUSE argument. Accumulates all the results before yielding any of them */
+ResultProcessor *RPFusion_New(const FusionOptions *opts);
+
 /** Functions abstracting the sortmap. Hides the bitwise logic */
 #define SORTASCMAP_INIT 0xFFFFFFFFFFFFFFFF
 #define SORTASCMAP_MAXFIELDS 8
@@ -90,6 +90,65 @@ void calcRanges(double longitude, double latitude, double radius_meters, GeoHash
   calcAllNeighbors(&georadius, longitude, latitude, radius_meters, ranges);
 }
 
+/* Calculate the ranges covering a lon/lat bounding box.
+ * We pick the finest step at which a geohash cell is at least as large as the box, so the box
+ * lies within the 3x3 cells around its center, and keep only the cells that intersect it.
+ * If min == max, the range is empty */
+void calcBoxRanges(double minLon, double minLat, double maxLon, double maxLat,
+                   GeoHashRange *ranges) {
+  GeoHashRange lonRange, latRange;
+  geohashGetCoordRange(&lonRange, &latRange);
+
+  double width = maxLon - minLon;
+  double height = maxLat - minLat;
+  uint8_t step = GEO_STEP_MAX;
+  while (step > 1 && ((lonRange.max - lonRange.min) / (double)(1ULL << step) < width ||
+                      (latRange.max - latRange.min) / (double)(1ULL << step) < height)) {
+    step--;
+  }
+
+  GeoHashBits cells[GEO_RANGE_COUNT];
+  GeoHashNeighbors n;
+  geohashEncode(&lonRange, &latRange, minLon + width / 2, minLat + height / 2, step, &cells[0]);
+  geohashNeighbors(&cells[0], &n);
+  cells[1] = n.north;
+  cells[2] = n.south;
+  cells[3] = n.east;
+  cells[4] = n.west;
+  cells[5] = n.north_east;
+  cells[6] = n.north_west;
+  cells[7] = n.south_east;
+  cells[8] = n.south_west;
+
+  for (size_t i = 0; i < GEO_RANGE_COUNT; i++) {
+    ranges[i].min = ranges[i].max = 0;
+    if (HASHISZERO(cells[i])) {
+      continue;
+    }
+
+    GeoHashArea area;
+    geohashDecode(lonRange, latRange, cells[i], &area);
+    if (area.longitude.max < minLon || area.longitude.min > maxLon ||
+        area.latitude.max < minLat || area.latitude.min > maxLat) {
+      continue;
+    }
+
+    // Neighbors wrap around at coarse steps, so the same cell may show up more than once
+    int dup = 0;
+    for (size_t j = 0; j < i && !dup; j++) {
+      dup = cells[j].bits == cells[i].bits && !RANGEISZERO(ranges[j]);
+    }
+    if (dup) {
+      continue;
+    }
+
+    GeoHashFix52Bits min, max;
+    scoresOfGeoHashBox(cells[i], &min, &max);
+    ranges[i].min = min;
+    ranges[i].max = max;
+  }
+}
+
 bool isWithinRadiusLonLat(double lon1, double lat1, double lon2, double lat2, double radius,
                           double *distance) {
   double dist = geohashGetDistance(lon1, lat1, lon2, lat2);
@@ -124,29 +183,3 @@ int parseGeo(const char *c, size_t len, double *lon, double *lat) {
 
   return REDISMODULE_OK;
 }
-
-/*
-int isWithinRadius(double center, double point, double radius, double *distance) {
-  double xyCenter[2], xyPoint[2];
-  decodeGeo(center, xyCenter);
-  decodeGeo(point, xyPoint);
-  return isWithinRadiusLonLat(xyCenter[0], xyCenter[1], xyPoint[0], xyPoint[1],
-                                    radius, distance);
-}
-
-IndexIterator *NewGeoRangeIterator(GeoIndex *gi, const GeoFilter *gf, double weight) {
-  GeoHashRange ranges[GEO_RANGE_COUNT] = {0};
-  calcRanges(gf, ranges);
-
-  int iterCount = 0;
-  IndexIterator **iters = rm_calloc(GEO_RANGE_COUNT, sizeof(*iters));
-  for (size_t ii = 0; ii < GEO_RANGE_COUNT; ++ii) {
-    if (ranges[ii].min != ranges[ii].max) {
-      NumericFilter *filt = NewNumericFilter(ranges[ii].min, ranges[ii].max, 1, 1);
-      iters[iterCount++] = NewNumericFilterIterator(NULL, filt, NULL);
-    }
-  }
-  iters = rm_realloc(iters, iterCount * sizeof(*iters));
-  IndexIterator *it = NewUnionIterator(iters, iterCount, NULL, 1, 1);
-  return it;
-}*/
\ No newline at end of file
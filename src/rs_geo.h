@@ -25,6 +25,14 @@ int  decodeGeo(double bits, double *xy);
 void calcRanges(double longitude, double latitude, double radius_meters,
                 GeoHashRange *ranges);
 
+/*
+ * Calculate which squares contain the given bounding box.
+ *
+ * Results must still be filtered against the box (or the shape it bounds).
+ */
+void calcBoxRanges(double minLon, double minLat, double maxLon, double maxLat,
+                   GeoHashRange *ranges);
+
 /*
  * Return true is distance is smaller than radius. radius must be in meters.
  * If `distance' is not NULL, the distance value is returned.
@@ -78,6 +78,26 @@ typedef enum {
 
 #define RS_DEFAULT_QUERY_FLAGS 0x00
 
+typedef enum {
+  // Results are ranked by the scorer alone
+  FusionMethod_None = 0,
+  // Reciprocal rank fusion of the text and vector rankings
+  FusionMethod_RRF,
+  // Weighted sum of the normalized text score and vector distance
+  FusionMethod_Linear
+} FusionMethod;
+
+#define FUSION_WEIGHT_DEFAULT 0.5
+#define FUSION_RRF_K 60
+
+typedef struct {
+  FusionMethod method;
+  // Weight of the text ranking, the vector ranking gets the rest
+  double weight;
+  // Only the top `window` results of each ranking take part in the fusion, 0 means all of them
+  size_t window;
+} FusionOptions;
+
 typedef struct {
   const char *expanderName;
   const char *scorerName;
@@ -97,6 +117,7 @@ typedef struct {
 
   const StopWordList *stopwords;
   dict *params;
+  FusionOptions fusion;
 
   /** Legacy options */
   struct {
@@ -916,10 +916,7 @@ static int IndexSpec_AddFieldsInternal(IndexSpec *sp, ArgsCursor *ac, QueryError
     }
     if (FIELD_IS(fs, INDEXFLD_T_FULLTEXT) && FieldSpec_HasSuffixTrie(fs)) {
       sp->suffixMask |= FIELD_BIT(fs);
-      if (!sp->suffix) {
-        sp->flags |= Index_HasSuffixTrie;
-        sp->suffix = NewTrie(suffixTrie_freeCallback, Trie_Sort_Lex);
-      }
+      IndexSpec_InitSuffixIndex(sp);
     }
     fs = NULL;
   }
@@ -1067,10 +1064,110 @@ int IndexSpec_AddTerm(IndexSpec *sp, const char *term, size_t len) {
   if (isNew) {
     sp->stats.numTerms++;
     sp->stats.termsSize += len;
+    if (sp->termsDelta) {
+      Trie_InsertStringBuffer(sp->termsDelta, (char *)term, len, 1, 1, NULL);
+    }
+    if (sp->termsPending) {
+      Trie_InsertStringBuffer(sp->termsPending, (char *)term, len, 1, 1, NULL);
+    }
   }
   return isNew;
 }
 
+void IndexSpec_SetTermFrequency(IndexSpec *sp, const char *term, size_t len, size_t numDocs) {
+  // the term is already in the trie, this only replaces its score
+  Trie_InsertStringBuffer(sp->terms, (char *)term, len, numDocs, 0, NULL);
+}
+
+void IndexSpec_InitSuffixIndex(IndexSpec *sp) {
+  sp->flags |= Index_HasSuffixTrie;
+  // with SUFFIX_ARRAY, the suffix trie still serves the queries until the GC builds the array
+  if (!sp->suffix && !sp->suffixArray) {
+    sp->suffix = NewTrie(suffixTrie_freeCallback, Trie_Sort_Lex);
+  }
+}
+
+void IndexSpec_DeleteTerm(IndexSpec *sp, const char *term, size_t len) {
+  Trie_Delete(sp->terms, term, len);
+  if (sp->termsDelta) {
+    Trie_Delete(sp->termsDelta, term, len);
+  }
+  if (sp->termsPending) {
+    Trie_Delete(sp->termsPending, term, len);
+  }
+}
+
+static void IndexSpec_FreeTermsSnapshot(IndexSpec *sp) {
+  if (sp->termsSnapshot) {
+    TermsSnapshot_Free(sp->termsSnapshot);
+    sp->termsSnapshot = NULL;
+  }
+  if (sp->termsDelta) {
+    TrieType_Free(sp->termsDelta);
+    sp->termsDelta = NULL;
+  }
+  if (sp->suffixArray) {
+    SuffixArray_Free(sp->suffixArray);
+    sp->suffixArray = NULL;
+  }
+}
+
+static void IndexSpec_FreeTermsPending(IndexSpec *sp) {
+  if (sp->termsPending) {
+    TrieType_Free(sp->termsPending);
+    sp->termsPending = NULL;
+  }
+}
+
+int IndexSpec_PrepareTermsSnapshot(IndexSpec *sp) {
+  // a snapshot left pending by a failed GC run is dropped, the child builds a new one
+  IndexSpec_FreeTermsPending(sp);
+  // the snapshot costs memory on top of the terms trie, it is only kept if asked for, or to build
+  // the suffix array from
+  int wanted = RSGlobalConfig.termsSnapshot ||
+               ((sp->flags & Index_HasSuffixTrie) && RSGlobalConfig.suffixArray);
+  // once the suffix array replaced the suffix trie it is kept however few terms are left
+  if (!wanted || !sp->terms ||
+      (sp->stats.numTerms < TERMS_SNAPSHOT_MIN_TERMS && !sp->suffixArray)) {
+    IndexSpec_FreeTermsSnapshot(sp);
+    return 0;
+  }
+  if (sp->termsSnapshot) {
+    // terms deleted since the build still sit in the snapshot and expand to empty readers
+    size_t snapshotSize = sp->termsSnapshot->numTerms;
+    size_t added = sp->termsDelta->size;
+    size_t removed = snapshotSize + added > sp->stats.numTerms
+                         ? snapshotSize + added - sp->stats.numTerms
+                         : 0;
+    if ((added + removed) * TERMS_SNAPSHOT_REBUILD_RATIO < snapshotSize) {
+      return 0;
+    }
+  }
+  sp->termsPending = NewTrie(NULL, Trie_Sort_Lex);
+  return 1;
+}
+
+void IndexSpec_SetTermsSnapshot(IndexSpec *sp, TermsSnapshot *snap, SuffixArray *sa) {
+  if (!sp->termsPending) {
+    // the terms added since the fork were not tracked, the snapshot would miss them
+    TermsSnapshot_Free(snap);
+    if (sa) {
+      SuffixArray_Free(sa);
+    }
+    return;
+  }
+  IndexSpec_FreeTermsSnapshot(sp);
+  sp->termsSnapshot = snap;
+  sp->termsDelta = sp->termsPending;
+  sp->termsPending = NULL;
+  sp->suffixArray = sa;
+  // the suffix array takes over from the suffix trie, the terms added from now on are in the delta
+  if (sa && sp->suffix) {
+    TrieType_Free(sp->suffix);
+    sp->suffix = NULL;
+  }
+}
+
 void Spec_AddToDict(const IndexSpec *sp) {
   dictAdd(specDict_g, sp->name, (void *)sp);
 }
@@ -1149,6 +1246,8 @@ static void IndexSpec_FreeUnlinkedData(IndexSpec *spec) {
   if (spec->terms) {
     TrieType_Free(spec->terms);
   }
+  IndexSpec_FreeTermsSnapshot(spec);
+  IndexSpec_FreeTermsPending(spec);
   // Free NUMERIC, TAG and GEO fields trie and inverted indexes
   if (spec->keysDict) {
     dictRelease(spec->keysDict);
@@ -1767,6 +1866,10 @@ void IndexesScanner_Free(IndexesScanner *scanner) {
     }
   }
 
+  for (size_t ii = 0; ii < scanner->batchLen; ++ii) {
+    Document_Free(scanner->batch + ii);
+  }
+  rm_free(scanner->batch);
   rm_free(scanner);
 }
 
@@ -1791,6 +1894,69 @@ static void IndexSpec_DoneIndexingCallabck(struct RSAddDocumentCtx *docCtx, Redi
 //---------------------------------------------------------------------------------------------
 
 int IndexSpec_UpdateDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString *key, DocumentType type);
+static int IndexSpec_LoadDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString *key,
+                             DocumentType type, Document *doc);
+
+// The number of documents an index scan loads before indexing them together. With
+// CONCURRENT_WRITE_MODE their preprocessing is spread over the index thread pool, so this also
+// bounds how many keys are scanned between two releases of the GIL.
+#define SCAN_BATCH_SIZE 64
+
+// Index the scanner's batch. Must be called before the GIL is released, as the documents were
+// loaded under it
+static void IndexesScanner_FlushBatch(IndexesScanner *scanner, RedisModuleCtx *ctx) {
+  IndexSpec *sp = scanner->spec;
+  if (scanner->batchLen && sp && !scanner->cancelled) {
+    hires_clock_t t0;
+    hires_clock_get(&t0);
+
+    RedisSearchCtx sctx = SEARCH_CTX_STATIC(ctx, sp);
+    RSAddDocumentCtx *aCtxs[SCAN_BATCH_SIZE];
+    size_t n = 0;
+    for (size_t ii = 0; ii < scanner->batchLen; ++ii) {
+      QueryError status = {0};
+      RSAddDocumentCtx *aCtx = NewAddDocumentCtx(sp, scanner->batch + ii, &status);
+      if (!aCtx) {
+        sp->stats.indexingFailures++;
+        QueryError_ClearError(&status);
+        continue;
+      }
+      aCtx->stateFlags |= ACTX_F_NOBLOCK | ACTX_F_NOFREEDOC;
+      aCtxs[n++] = aCtx;
+    }
+    AddDocumentCtx_SubmitBatch(aCtxs, n, &sctx, DOCUMENT_ADD_REPLACE);
+
+    sp->stats.totalIndexTime += hires_clock_since_usec(&t0);
+  }
+
+  for (size_t ii = 0; ii < scanner->batchLen; ++ii) {
+    Document_Free(scanner->batch + ii);
+  }
+  scanner->batchLen = 0;
+}
+
+static void IndexesScanner_AddToBatch(IndexesScanner *scanner, RedisModuleCtx *ctx,
+                                      RedisModuleString *keyname, DocumentType type) {
+  IndexSpec *sp = scanner->spec;
+  if (!sp->rule) {
+    RedisModule_Log(ctx, "warning", "Index spec %s: no rule found", sp->name);
+    return;
+  }
+  if (!scanner->batch) {
+    scanner->batch = rm_calloc(SCAN_BATCH_SIZE, sizeof(*scanner->batch));
+  }
+  Document *doc = scanner->batch + scanner->batchLen;
+  memset(doc, 0, sizeof(*doc));
+  if (IndexSpec_LoadDoc(sp, ctx, keyname, type, doc) != REDISMODULE_OK) {
+    return;
+  }
+  // the key name and the fields are only valid during the scan callback
+  Document_MakeStringsOwner(doc);
+  if (++scanner->batchLen == SCAN_BATCH_SIZE) {
+    IndexesScanner_FlushBatch(scanner, ctx);
+  }
+}
+
 static void Indexes_ScanProc(RedisModuleCtx *ctx, RedisModuleString *keyname, RedisModuleKey *key,
                              IndexesScanner *scanner) {
   // RMKey it is provided as best effort but in some cases it might be NULL
@@ -1818,7 +1984,7 @@ static void Indexes_ScanProc(RedisModuleCtx *ctx, RedisModuleString *keyname, Re
   } else {
     IndexSpec *sp = scanner->spec;
     if (SchemaRule_ShouldIndex(sp, keyname, type)) {
-      IndexSpec_UpdateDoc(sp, ctx, keyname, type);
+      IndexesScanner_AddToBatch(scanner, ctx, keyname, type);
     }
   }
   ++scanner->scannedKeys;
@@ -1842,7 +2008,15 @@ static void Indexes_ScanAndReindexTask(IndexesScanner *scanner) {
     RedisModule_Log(ctx, "notice", "Scanning index %s in background", scanner->spec->name);
   }
 
+  size_t scannedAtYield = scanner->scannedKeys;
   while (RedisModule_Scan(ctx, cursor, (RedisModuleScanCB)Indexes_ScanProc, scanner)) {
+    // Keep scanning while the batch is small, so its documents can be preprocessed together
+    if (scanner->batchLen && scanner->scannedKeys - scannedAtYield < SCAN_BATCH_SIZE) {
+      continue;
+    }
+    IndexesScanner_FlushBatch(scanner, ctx);
+    scannedAtYield = scanner->scannedKeys;
+
     RedisModule_ThreadSafeContextUnlock(ctx);
     sched_yield();
     RedisModule_ThreadSafeContextLock(ctx);
@@ -1854,6 +2028,8 @@ static void Indexes_ScanAndReindexTask(IndexesScanner *scanner) {
     }
   }
 
+  IndexesScanner_FlushBatch(scanner, ctx);
+
   if (scanner->global) {
     RedisModule_Log(ctx, "notice", "Scanning indexes in background: done (scanned=%ld)",
                   scanner->totalKeys);
@@ -2141,11 +2317,8 @@ IndexSpec *IndexSpec_CreateFromRdb(RedisModuleCtx *ctx, RedisModuleIO *rdb, int
       RSSortingTable_Add(&sp->sortables, fs->name, fieldTypeToValueType(fs->types));
     }
     if (FieldSpec_HasSuffixTrie(fs)) {
-      sp->flags |= Index_HasSuffixTrie;
       sp->suffixMask |= FIELD_BIT(fs);
-      if (!sp->suffix) {
-        sp->suffix = NewTrie(suffixTrie_freeCallback, Trie_Sort_Lex);
-      }
+      IndexSpec_InitSuffixIndex(sp);
     }
 
   }
@@ -2498,27 +2671,20 @@ int IndexSpec_RegisterType(RedisModuleCtx *ctx) {
 
 int Document_LoadSchemaFieldJson(Document *doc, RedisSearchCtx *sctx);
 
-int IndexSpec_UpdateDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString *key, DocumentType type) {
-  if (!spec->rule) {
-    RedisModule_Log(ctx, "warning", "Index spec %s: no rule found", spec->name);
-    return REDISMODULE_ERR;
-  }
-
-  hires_clock_t t0;
-  hires_clock_get(&t0);
-
+// Load the indexed fields of a document. On failure the document is removed from the index
+static int IndexSpec_LoadDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString *key,
+                             DocumentType type, Document *doc) {
   RedisSearchCtx sctx = SEARCH_CTX_STATIC(ctx, spec);
-  Document doc = {0};
-  Document_Init(&doc, key, DEFAULT_SCORE, DEFAULT_LANGUAGE, type);
+  Document_Init(doc, key, DEFAULT_SCORE, DEFAULT_LANGUAGE, type);
   // if a key does not exit, is not a hash or has no fields in index schema
 
   int rv = REDISMODULE_ERR;
   switch (type) {
   case DocumentType_Hash:
-    rv = Document_LoadSchemaFieldHash(&doc, &sctx);
+    rv = Document_LoadSchemaFieldHash(doc, &sctx);
     break;
   case DocumentType_Json:
-    rv = Document_LoadSchemaFieldJson(&doc, &sctx);
+    rv = Document_LoadSchemaFieldJson(doc, &sctx);
     break;
   case DocumentType_Unsupported:
     RS_LOG_ASSERT(0, "Should receieve valid type");
@@ -2530,7 +2696,23 @@ int IndexSpec_UpdateDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString
     // if a document did not load properly, it is deleted
     // to prevent mismatch of index and hash
     IndexSpec_DeleteDoc(spec, ctx, key);
-    Document_Free(&doc);
+    Document_Free(doc);
+  }
+  return rv;
+}
+
+int IndexSpec_UpdateDoc(IndexSpec *spec, RedisModuleCtx *ctx, RedisModuleString *key, DocumentType type) {
+  if (!spec->rule) {
+    RedisModule_Log(ctx, "warning", "Index spec %s: no rule found", spec->name);
+    return REDISMODULE_ERR;
+  }
+
+  hires_clock_t t0;
+  hires_clock_get(&t0);
+
+  RedisSearchCtx sctx = SEARCH_CTX_STATIC(ctx, spec);
+  Document doc = {0};
+  if (IndexSpec_LoadDoc(spec, ctx, key, type, &doc) != REDISMODULE_OK) {
     return REDISMODULE_ERR;
   }
 
@@ -8,6 +8,8 @@
 #include "redismodule.h"
 #include "doc_table.h"
 #include "trie/trie_type.h"
+#include "trie/terms_snapshot.h"
+#include "trie/suffix_array.h"
 #include "sortable.h"
 #include "stopwords.h"
 #include "gc.h"
@@ -245,6 +247,10 @@ typedef struct IndexSpec {
   IndexFlags flags;               // Flags
 
   Trie *terms;                    // Trie of all terms. Used for GC and fuzzy queries
+  TermsSnapshot *termsSnapshot;   // Read-optimized copy of terms, rebuilt by GC. Used for prefix and fuzzy queries
+  Trie *termsDelta;               // Terms added since termsSnapshot was built
+  Trie *termsPending;             // Terms added since the GC forked to build the next termsSnapshot
+  SuffixArray *suffixArray;       // Suffixes of termsSnapshot. Used for contains queries when there is no suffix trie
   Trie *suffix;                   // Trie of suffix tokens of terms. Used for contains queries
   t_fieldMask suffixMask;         // Mask of all field that support contains query
   dict *keysDict;                 // Global dictionary. Contains inverted indexes of all TEXT terms
@@ -497,6 +503,35 @@ IndexSpec *IndexSpec_LoadEx(RedisModuleCtx *ctx, IndexLoadOptions *options);
 
 int IndexSpec_AddTerm(IndexSpec *sp, const char *term, size_t len);
 
+/* Set the score of a term in the terms trie to its document frequency, so prefix expansion can
+ * prefer frequent terms when it has to drop some */
+void IndexSpec_SetTermFrequency(IndexSpec *sp, const char *term, size_t len, size_t numDocs);
+
+/* Enable contains queries on WITHSUFFIXTRIE fields. They are served by a suffix trie, or, if the
+ * SUFFIX_ARRAY configuration is set, by a suffix array rebuilt by the GC, which replaces the suffix
+ * trie once the index has TERMS_SNAPSHOT_MIN_TERMS terms */
+void IndexSpec_InitSuffixIndex(IndexSpec *sp);
+
+/* Minimum number of terms for an index to keep a terms snapshot, when the TERMS_SNAPSHOT or
+ * SUFFIX_ARRAY configuration is set */
+#define TERMS_SNAPSHOT_MIN_TERMS 1024
+/* The snapshot is rebuilt once the terms added or removed since it was built reach
+ * 1/TERMS_SNAPSHOT_REBUILD_RATIO of it */
+#define TERMS_SNAPSHOT_REBUILD_RATIO 8
+
+/* Remove a term from the terms trie and from the terms added since the last snapshot */
+void IndexSpec_DeleteTerm(IndexSpec *sp, const char *term, size_t len);
+
+/* Decide, before the GC forks, whether the read-optimized terms snapshot should be rebuilt
+ * according to how much the terms have changed since it was built, and drop it if the index has
+ * too few terms. Returns 1 if the fork child should build a new snapshot, in which case the terms
+ * added from now on are tracked until it is set */
+int IndexSpec_PrepareTermsSnapshot(IndexSpec *sp);
+
+/* Replace the terms snapshot, and the suffix array built from it if the index has no suffix trie,
+ * with the ones the GC child built from the terms at fork time. Takes ownership of both */
+void IndexSpec_SetTermsSnapshot(IndexSpec *sp, TermsSnapshot *snap, SuffixArray *sa);
+
 /*
  * Free an indexSpec.
  */
@@ -546,6 +581,9 @@ typedef struct IndexesScanner {
   IndexSpec *spec;
   size_t scannedKeys, totalKeys;
   bool cancelled;
+  // Documents loaded by the current scan steps, indexed together before the GIL is released
+  struct Document *batch;
+  size_t batchLen;
 } IndexesScanner;
 
 double IndexesScanner_IndexedPercent(IndexesScanner *scanner, IndexSpec *sp);
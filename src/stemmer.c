@@ -1,19 +1,75 @@
 #include "stemmer.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
 #include <sys/param.h>
 #include "snowball/include/libstemmer.h"
+#include "util/fnv.h"
 #include "rmalloc.h"
 
+// Words shorter than this are never changed by any of the Snowball stemmers
+#define STEM_MIN_WORD_LEN 3
+
+// The stem cache is a small open addressing table keyed by the word's hash. It is owned by a
+// single stemmer, so it needs no locking: indexing stemmers belong to one forward index at a
+// time, and query expansion uses the per-thread stemmers below.
+#define STEM_CACHE_SLOTS 512
+#define STEM_CACHE_PROBES 2
+// Longer words are rare enough not to be worth caching
+#define STEM_CACHE_MAX_LEN 30
+// Flush the local counters to the global stats every so many lookups
+#define STEM_CACHE_FLUSH_EVERY 1024
+
+typedef struct {
+  uint32_t hash;
+  uint8_t len;      // length of the word, 0 marks an empty slot
+  uint8_t stemLen;  // length of the stem including its prefix, 0 if the word has no stem
+  char word[STEM_CACHE_MAX_LEN];
+  char stem[STEM_CACHE_MAX_LEN + 2];  // prefix, stem and terminating NUL
+} stemCacheEntry;
+
+static StemmerCacheStats globalStats_g = {0};
+
 struct sbStemmerCtx {
   struct sb_stemmer *sb;
   char *buf;
   size_t cap;
+  stemCacheEntry *cache;  // allocated on the first cacheable lookup
+  StemmerCacheStats stats;  // not yet flushed to globalStats_g
 };
 
-const char *__sbstemmer_Stem(void *ctx, const char *word, size_t len, size_t *outlen) {
+static void flushCacheStats(struct sbStemmerCtx *stctx) {
+  __sync_fetch_and_add(&globalStats_g.lookups, stctx->stats.lookups);
+  __sync_fetch_and_add(&globalStats_g.hits, stctx->stats.hits);
+  __sync_fetch_and_add(&globalStats_g.skipped, stctx->stats.skipped);
+  memset(&stctx->stats, 0, sizeof(stctx->stats));
+}
+
+void Stemmer_GetCacheStats(StemmerCacheStats *stats) {
+  stats->lookups = __sync_fetch_and_add(&globalStats_g.lookups, 0);
+  stats->hits = __sync_fetch_and_add(&globalStats_g.hits, 0);
+  stats->skipped = __sync_fetch_and_add(&globalStats_g.skipped, 0);
+}
+
+// Returns true if the word contains nothing a stemmer could strip - i.e. it has no letters.
+// Any non ASCII byte is assumed to be part of a letter
+static int isUnstemmable(const char *word, size_t len) {
+  if (len < STEM_MIN_WORD_LEN) {
+    return 1;
+  }
+  for (size_t ii = 0; ii < len; ++ii) {
+    unsigned char c = word[ii];
+    if (c >= 0x80 || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z')) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static const char *sbStem(struct sbStemmerCtx *stctx, const char *word, size_t len,
+                          size_t *outlen) {
   const sb_symbol *b = (const sb_symbol *)word;
-  struct sbStemmerCtx *stctx = ctx;
   struct sb_stemmer *sb = stctx->sb;
 
   const sb_symbol *stemmed = sb_stemmer_stem(sb, b, (int)len);
@@ -39,9 +95,68 @@ const char *__sbstemmer_Stem(void *ctx, const char *word, size_t len, size_t *ou
   return NULL;
 }
 
+const char *__sbstemmer_Stem(void *ctx, const char *word, size_t len, size_t *outlen) {
+  struct sbStemmerCtx *stctx = ctx;
+  if (isUnstemmable(word, len)) {
+    stctx->stats.skipped++;
+    return NULL;
+  }
+  if (len > STEM_CACHE_MAX_LEN) {
+    return sbStem(stctx, word, len, outlen);
+  }
+
+  if (++stctx->stats.lookups == STEM_CACHE_FLUSH_EVERY) {
+    flushCacheStats(stctx);
+  }
+  if (!stctx->cache) {
+    stctx->cache = rm_calloc(STEM_CACHE_SLOTS, sizeof(*stctx->cache));
+  }
+
+  uint32_t hash = rs_fnv_32a_buf((void *)word, len, 0);
+  stemCacheEntry *slot = NULL;
+  for (uint32_t ii = 0; ii < STEM_CACHE_PROBES; ++ii) {
+    stemCacheEntry *e = stctx->cache + ((hash + ii) & (STEM_CACHE_SLOTS - 1));
+    if (!e->len) {
+      slot = slot ? slot : e;
+      continue;
+    }
+    if (e->hash == hash && e->len == len && !memcmp(e->word, word, len)) {
+      stctx->stats.hits++;
+      if (!e->stemLen) {
+        return NULL;
+      }
+      *outlen = e->stemLen;
+      return e->stem;
+    }
+  }
+  // no free slot in the probe window - evict the word's home slot
+  if (!slot) {
+    slot = stctx->cache + (hash & (STEM_CACHE_SLOTS - 1));
+  }
+
+  const char *stem = sbStem(stctx, word, len, outlen);
+  if (stem && *outlen > STEM_CACHE_MAX_LEN + 1) {
+    // the stem does not fit the entry, leave the slot as it was
+    return stem;
+  }
+  slot->hash = hash;
+  slot->len = len;
+  memcpy(slot->word, word, len);
+  if (stem) {
+    slot->stemLen = *outlen;
+    memcpy(slot->stem, stem, *outlen);
+    slot->stem[*outlen] = '\0';
+  } else {
+    slot->stemLen = 0;
+  }
+  return stem;
+}
+
 void __sbstemmer_Free(Stemmer *s) {
   struct sbStemmerCtx *ctx = s->ctx;
+  flushCacheStats(ctx);
   sb_stemmer_delete(ctx->sb);
+  rm_free(ctx->cache);
   rm_free(ctx->buf);
   rm_free(ctx);
   rm_free(s);
@@ -62,7 +177,7 @@ Stemmer *__newSnowballStemmer(RSLanguage language) {
     return NULL;
   }
 
-  struct sbStemmerCtx *ctx = rm_malloc(sizeof(*ctx));
+  struct sbStemmerCtx *ctx = rm_calloc(1, sizeof(*ctx));
   ctx->sb = sb;
   ctx->cap = 24;
   ctx->buf = rm_malloc(ctx->cap);
@@ -96,3 +211,77 @@ Stemmer *NewStemmer(StemmerType type, RSLanguage language) {
 int ResetStemmer(Stemmer *stemmer, StemmerType type, RSLanguage language) {
   return stemmer->Reset && stemmer->Reset(stemmer, type, language);
 }
+
+typedef struct threadStemmers {
+  Stemmer *stemmers[RS_LANG_UNSUPPORTED];
+  struct threadStemmers *next;
+} threadStemmers;
+
+static pthread_key_t threadStemmersKey_g;
+
+// Every thread's stemmers, so that the ones of threads that never exit (such as the main thread)
+// can be freed when the module shuts down
+static threadStemmers *allThreadStemmers_g = NULL;
+static pthread_mutex_t allThreadStemmersLock_g = PTHREAD_MUTEX_INITIALIZER;
+
+static void freeThreadStemmers(threadStemmers *ts) {
+  for (size_t ii = 0; ii < RS_LANG_UNSUPPORTED; ++ii) {
+    if (ts->stemmers[ii]) {
+      ts->stemmers[ii]->Free(ts->stemmers[ii]);
+    }
+  }
+  rm_free(ts);
+}
+
+static void threadStemmersDtor(void *p) {
+  // the stemmers may already have been freed by Stemmer_FreeThreadLocal
+  int found = 0;
+  pthread_mutex_lock(&allThreadStemmersLock_g);
+  for (threadStemmers **pp = &allThreadStemmers_g; *pp; pp = &(*pp)->next) {
+    if (*pp == p) {
+      *pp = (*pp)->next;
+      found = 1;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&allThreadStemmersLock_g);
+  if (found) {
+    freeThreadStemmers(p);
+  }
+}
+
+static void __attribute__((constructor)) initThreadStemmersKey() {
+  pthread_key_create(&threadStemmersKey_g, threadStemmersDtor);
+}
+
+void Stemmer_FreeThreadLocal() {
+  pthread_mutex_lock(&allThreadStemmersLock_g);
+  threadStemmers *ts = allThreadStemmers_g;
+  allThreadStemmers_g = NULL;
+  pthread_mutex_unlock(&allThreadStemmersLock_g);
+  pthread_setspecific(threadStemmersKey_g, NULL);
+  while (ts) {
+    threadStemmers *next = ts->next;
+    freeThreadStemmers(ts);
+    ts = next;
+  }
+}
+
+Stemmer *GetThreadLocalStemmer(RSLanguage language) {
+  if (language < 0 || language >= RS_LANG_UNSUPPORTED) {
+    return NULL;
+  }
+  threadStemmers *ts = pthread_getspecific(threadStemmersKey_g);
+  if (!ts) {
+    ts = rm_calloc(1, sizeof(*ts));
+    pthread_setspecific(threadStemmersKey_g, ts);
+    pthread_mutex_lock(&allThreadStemmersLock_g);
+    ts->next = allThreadStemmers_g;
+    allThreadStemmers_g = ts;
+    pthread_mutex_unlock(&allThreadStemmersLock_g);
+  }
+  if (!ts->stemmers[language]) {
+    ts->stemmers[language] = NewStemmer(SnowballStemmer, language);
+  }
+  return ts->stemmers[language];
+}
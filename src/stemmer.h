@@ -1,6 +1,7 @@
 #ifndef __RS_STEMMER_H__
 #define __RS_STEMMER_H__
 #include "language.h"
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,6 +31,26 @@ Stemmer *NewStemmer(StemmerType type, RSLanguage language);
 
 int ResetStemmer(Stemmer *stemmer, StemmerType type, RSLanguage language);
 
+/* Get the calling thread's Snowball stemmer for the given language, creating it on first use.
+ * The stemmer is owned by the thread and freed when it exits, or by Stemmer_FreeThreadLocal -
+ * callers must not free it.
+ * Returns NULL if there is no stemmer for the language */
+Stemmer *GetThreadLocalStemmer(RSLanguage language);
+
+/* Free the stemmers of all the threads, including those that are still running. Called when the
+ * module shuts down, once no thread uses its stemmers anymore */
+void Stemmer_FreeThreadLocal();
+
+typedef struct {
+  size_t lookups;  // words looked up in a stem cache
+  size_t hits;     // lookups answered from the cache
+  size_t skipped;  // words that cannot be stemmed, returned without a lookup
+} StemmerCacheStats;
+
+/* Get the stem cache statistics of all stemmers. The numbers are approximate, as stemmers
+ * report their counters in batches */
+void Stemmer_GetCacheStats(StemmerCacheStats *stats);
+
 /* Get a stemmer expander instance for registering it */
 void RegisterStemmerExpander();
 
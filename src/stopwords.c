@@ -5,12 +5,36 @@
 #include "util/strconv.h"
 #include "rmutil/rm_assert.h"
 #include <ctype.h>
+#include <sys/param.h>
 #include "rdb.h"
 
 #define MAX_STOPWORDLIST_SIZE 1024
 
+// Stopword lists never change once created - FT.CREATE and FT.ALTER replace the whole list -
+// so every list is compiled into a hash-and-displace perfect hash when it is created. A small
+// bloom filter keyed on the term's length and first two characters rejects most terms before
+// they are even hashed. The trie is kept for listing, replies and RDB.
+#define STOPWORD_BLOOM_BITS 512
+#define STOPWORD_BUCKET_SIZE 4  // average number of words per displacement bucket
+#define STOPWORD_MAX_DISP UINT16_MAX
+
+typedef struct {
+  const char *str;  // NULL marks an empty slot
+  size_t len;
+} StopWordSlot;
+
+typedef struct {
+  uint64_t bloom[STOPWORD_BLOOM_BITS / 64];
+  uint16_t *disp;       // the displacement of each bucket
+  StopWordSlot *slots;  // the words, placed by their perfect hash
+  char *strs;           // storage of all the words
+  uint32_t numBuckets;
+  uint32_t mask;
+} StopWordHash;
+
 typedef struct StopWordList {
   TrieMap *m;
+  StopWordHash *h;  // NULL if the perfect hash could not be built, then we use the trie
   size_t refcount;
 } StopWordList;
 
@@ -25,6 +49,182 @@ StopWordList *DefaultStopWordList() {
   return __default_stopwords;
 }
 
+static inline unsigned char asciiLower(unsigned char c) {
+  return (c >= 'A' && c <= 'Z') ? c | 0x20 : c;
+}
+
+// FNV-1a over the lowercased term, so lookups need no lowercased copy
+static inline uint32_t stopwordHash(const char *s, size_t len) {
+  uint32_t h = 0x811c9dc5;
+  for (size_t ii = 0; ii < len; ++ii) {
+    h ^= asciiLower(s[ii]);
+    h *= 0x01000193;
+  }
+  return h;
+}
+
+// The final slot of a word given its hash and its bucket's displacement
+static inline uint32_t stopwordSlot(uint32_t h, uint32_t disp) {
+  h ^= disp * 0x9e3779b9;
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+static inline uint32_t stopwordBloomBit(const char *s, size_t len) {
+  uint32_t k = (uint32_t)len;
+  if (len) {
+    k |= asciiLower(s[0]) << 8;
+    if (len > 1) {
+      k |= asciiLower(s[1]) << 16;
+    }
+  }
+  // keep the top bits of a multiplicative hash
+  return (k * 0x9e3779b1) >> (32 - 9);
+}
+
+static void StopWordHash_Free(StopWordHash *h) {
+  if (h) {
+    rm_free(h->disp);
+    rm_free(h->slots);
+    rm_free(h->strs);
+    rm_free(h);
+  }
+}
+
+/* Build the perfect hash of a list's words. Returns NULL if no displacement places some bucket's
+ * words on free slots, which is very unlikely with our load factor */
+static StopWordHash *StopWordHash_Build(TrieMap *m) {
+  size_t n = m->cardinality;
+  if (!n) {
+    return NULL;
+  }
+
+  StopWordHash *h = rm_calloc(1, sizeof(*h));
+  h->numBuckets = n / STOPWORD_BUCKET_SIZE + 1;
+  // keep the load factor under 0.8
+  uint32_t numSlots = 2;
+  while (numSlots < n + n / 4) {
+    numSlots <<= 1;
+  }
+  h->mask = numSlots - 1;
+  h->disp = rm_calloc(h->numBuckets, sizeof(*h->disp));
+  h->slots = rm_calloc(numSlots, sizeof(*h->slots));
+
+  // copy the words aside, and group them by bucket
+  char *str;
+  tm_len_t len;
+  void *ptr;
+  size_t totalLen = 0;
+  TrieMapIterator *it = TrieMap_Iterate(m, "", 0);
+  while (TrieMapIterator_Next(it, &str, &len, &ptr)) {
+    totalLen += len;
+  }
+  TrieMapIterator_Free(it);
+  h->strs = rm_malloc(totalLen ? totalLen : 1);
+
+  StopWordSlot *words = rm_malloc(n * sizeof(*words));
+  uint32_t *hashes = rm_malloc(n * sizeof(*hashes));
+  uint32_t *bucketStart = rm_calloc(h->numBuckets + 1, sizeof(*bucketStart));
+  char *pos = h->strs;
+  size_t ii = 0;
+  it = TrieMap_Iterate(m, "", 0);
+  while (ii < n && TrieMapIterator_Next(it, &str, &len, &ptr)) {
+    // the iterator reuses its buffer, so copy the word right away
+    memcpy(pos, str, len);
+    words[ii].str = pos;
+    words[ii].len = len;
+    pos += len;
+
+    hashes[ii] = stopwordHash(str, len);
+    bucketStart[hashes[ii] % h->numBuckets + 1]++;
+    uint32_t bit = stopwordBloomBit(str, len);
+    h->bloom[bit >> 6] |= 1ULL << (bit & 63);
+    ii++;
+  }
+  TrieMapIterator_Free(it);
+  n = ii;
+
+  for (uint32_t b = 0; b < h->numBuckets; ++b) {
+    bucketStart[b + 1] += bucketStart[b];
+  }
+  uint32_t *order = rm_malloc(n * sizeof(*order));
+  uint32_t *fill = rm_malloc(h->numBuckets * sizeof(*fill));
+  memcpy(fill, bucketStart, h->numBuckets * sizeof(*fill));
+  for (ii = 0; ii < n; ++ii) {
+    order[fill[hashes[ii] % h->numBuckets]++] = ii;
+  }
+
+  // place the biggest buckets first, while the table is still empty
+  uint32_t maxBucket = 0;
+  for (uint32_t b = 0; b < h->numBuckets; ++b) {
+    maxBucket = MAX(maxBucket, bucketStart[b + 1] - bucketStart[b]);
+  }
+  uint32_t placed[maxBucket ? maxBucket : 1];
+  int ok = 1;
+  for (uint32_t size = maxBucket; ok && size > 0; --size) {
+    for (uint32_t b = 0; ok && b < h->numBuckets; ++b) {
+      if (bucketStart[b + 1] - bucketStart[b] != size) continue;
+
+      uint32_t disp;
+      for (disp = 0; disp <= STOPWORD_MAX_DISP; ++disp) {
+        uint32_t k;
+        for (k = 0; k < size; ++k) {
+          uint32_t w = order[bucketStart[b] + k];
+          uint32_t slot = stopwordSlot(hashes[w], disp) & h->mask;
+          if (h->slots[slot].str) break;
+          // take the slot now, so the bucket's other words won't collide with it
+          h->slots[slot] = words[w];
+          placed[k] = slot;
+        }
+        if (k == size) break;
+        // roll back this bucket's words and try the next displacement
+        while (k--) {
+          h->slots[placed[k]].str = NULL;
+        }
+      }
+      if (disp > STOPWORD_MAX_DISP) {
+        ok = 0;
+      } else {
+        h->disp[b] = disp;
+      }
+    }
+  }
+
+  rm_free(fill);
+  rm_free(order);
+  rm_free(bucketStart);
+  rm_free(hashes);
+  rm_free(words);
+  if (!ok) {
+    StopWordHash_Free(h);
+    return NULL;
+  }
+  return h;
+}
+
+static int StopWordHash_Contains(const StopWordHash *h, const char *term, size_t len) {
+  uint32_t bit = stopwordBloomBit(term, len);
+  if (!(h->bloom[bit >> 6] & (1ULL << (bit & 63)))) {
+    return 0;
+  }
+  uint32_t hv = stopwordHash(term, len);
+  const StopWordSlot *slot = h->slots + (stopwordSlot(hv, h->disp[hv % h->numBuckets]) & h->mask);
+  if (!slot->str || slot->len != len) {
+    return 0;
+  }
+  // the stored words are already lowercased
+  for (size_t ii = 0; ii < len; ++ii) {
+    if (asciiLower(term[ii]) != (unsigned char)slot->str[ii]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
 /* Check if a stopword list contains a term. */
 int StopWordList_Contains(const StopWordList *sl, const char *term, size_t len) {
   char *lowStr;
@@ -32,6 +232,9 @@ int StopWordList_Contains(const StopWordList *sl, const char *term, size_t len)
   if (sl == __empty_stopwords || !sl || !term) {
     return 0;
   }
+  if (sl->h) {
+    return StopWordHash_Contains(sl->h, term, len);
+  }
 
   // do not use heap allocation for short strings
   if (len < 32) {
@@ -94,6 +297,7 @@ StopWordList *NewStopWordListCStr(const char **strs, size_t len) {
     TrieMap_Add(sl->m, t, tlen, NULL, NULL);
     rm_free(t);
   }
+  sl->h = StopWordHash_Build(sl->m);
   if (len == 0) {
     __empty_stopwords = sl;
   }
@@ -107,6 +311,7 @@ void StopWordList_Ref(StopWordList *sl) {
 static void StopWordList_FreeInternal(StopWordList *sl) {
   if (sl) {
     TrieMap_Free(sl->m, NULL);
+    StopWordHash_Free(sl->h);
     rm_free(sl);
   }
 }
@@ -141,6 +346,7 @@ StopWordList *StopWordList_RdbLoad(RedisModuleIO *rdb, int encver) {
   uint64_t elements = LoadUnsigned_IOError(rdb, goto cleanup);
   sl = rm_malloc(sizeof(*sl));
   sl->m = NewTrieMap();
+  sl->h = NULL;
   sl->refcount = 1;
 
   while (elements--) {
@@ -149,6 +355,7 @@ StopWordList *StopWordList_RdbLoad(RedisModuleIO *rdb, int encver) {
     TrieMap_Add(sl->m, str, len, NULL, NULL);
     RedisModule_Free(str);
   }
+  sl->h = StopWordHash_Build(sl->m);
 
   return sl;
 
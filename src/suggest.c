@@ -82,6 +82,7 @@ int RSSuggestAddCommand(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
   Trie *tree;
   if (type == REDISMODULE_KEYTYPE_EMPTY) {
     tree = NewTrie(NULL, Trie_Sort_Score);
+    Trie_EnableSearchCache(tree);
     RedisModule_ModuleTypeSetValue(key, TrieType, tree);
   } else {
     tree = RedisModule_ModuleTypeGetValue(key);
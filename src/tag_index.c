@@ -18,7 +18,15 @@ static uint32_t tagUniqueId = 0;
 /* See tag_index.h for documentation  */
 TagIndex *NewTagIndex() {
   TagIndex *idx = rm_new(TagIndex);
-  idx->values = NewTrieMap();
+  StrMap_Init(&idx->values);
+  idx->dict = array_new(TagDictEntry, 1);
+  // id 0 is reserved to mark documents without a dictionary encoded value
+  idx->dict = array_append(idx->dict, ((TagDictEntry){0}));
+  idx->freeIds = NULL;
+  idx->dictRevision = 0;
+  idx->docValues = NULL;
+  idx->docValuesBase = 0;
+  idx->sorted = NULL;
   idx->uniqueId = tagUniqueId++;
   idx->suffix = NULL;
   return idx;
@@ -59,18 +67,20 @@ char *TagIndex_SepString(char sep, char **s, size_t *toklen) {
   return start;
 }
 
-static int tokenizeTagString(const char *str, char sep, TagFieldFlags flags, char ***resArray) {
+// Tags are split in place inside a single copy of the string, so blocks fit a few typical values
+#define TAG_ARENA_BLOCK_SIZE 1024
+
+static int tokenizeTagString(const char *str, char sep, TagFieldFlags flags, char ***resArray,
+                             BlkAlloc *arena) {
+  char *p = BlkAlloc_Strndup(arena, str, strlen(str), TAG_ARENA_BLOCK_SIZE);
   if (sep == TAG_FIELD_DEFAULT_JSON_SEP) {
-    char *tok = rm_strdup(str);
     if (!(flags & TagField_CaseSensitive)) { // check case sensitive
-      tok = strtolower(tok);
+      p = strtolower(p);
     }
-    *resArray = array_append(*resArray, tok);
+    *resArray = array_append(*resArray, p);
     return REDISMODULE_OK;
   }
 
-  char *p;
-  char *pp = p = rm_strdup(str);
   while (p) {
     // get the next token
     size_t toklen;
@@ -82,29 +92,32 @@ static int tokenizeTagString(const char *str, char sep, TagFieldFlags flags, cha
       if (!(flags & TagField_CaseSensitive)) { // check case sensitive
         tok = strtolower(tok);
       }
-      tok = rm_strndup(tok, MIN(toklen, MAX_TAG_LEN));
+      // the token is already terminated in the copy, just cut it if it's too long
+      if (toklen > MAX_TAG_LEN) {
+        tok[MAX_TAG_LEN] = '\0';
+      }
       *resArray = array_append(*resArray, tok);
     }
   }
-  rm_free(pp);
   return REDISMODULE_OK;
 }
 
 /* Preprocess a document tag field, returning a vector of all tags split from the content */
-char **TagIndex_Preprocess(char sep, TagFieldFlags flags, const DocumentField *data) {
+char **TagIndex_Preprocess(char sep, TagFieldFlags flags, const DocumentField *data,
+                           BlkAlloc *arena) {
   char **ret = array_new(char *, 4);
   const char *str;
   switch (data->unionType) {
   case FLD_VAR_T_RMS:
     str = (char *)RedisModule_StringPtrLen(data->text, NULL);
-    tokenizeTagString(str, sep, flags, &ret);
+    tokenizeTagString(str, sep, flags, &ret, arena);
     break;
   case FLD_VAR_T_CSTR:
-    tokenizeTagString(data->strval, sep, flags, &ret);
+    tokenizeTagString(data->strval, sep, flags, &ret, arena);
     break;
   case FLD_VAR_T_ARRAY:
     for (int i = 0; i < data->arrayLen; i++) {
-      tokenizeTagString(data->multiVal[i], sep, flags, &ret);
+      tokenizeTagString(data->multiVal[i], sep, flags, &ret, arena);
     }
     break;
   case FLD_VAR_T_NULL:
@@ -117,17 +130,147 @@ char **TagIndex_Preprocess(char sep, TagFieldFlags flags, const DocumentField *d
   return ret;
 }
 
+/* Add a new value to the dictionary, returning its id */
+static uint32_t tagIndex_AddValue(TagIndex *idx, const char *value, size_t len, InvertedIndex *iv) {
+  uint32_t id;
+  if (array_len(idx->freeIds)) {
+    id = array_pop(idx->freeIds);
+  } else {
+    id = array_len(idx->dict);
+    idx->dict = array_append(idx->dict, ((TagDictEntry){0}));
+  }
+  StrMap_Add(&idx->values, value, len, (void *)(uintptr_t)id);
+  // the dictionary shares the key copy owned by the map
+  const StrMapEntry *e = StrMap_FindEntry(&idx->values, value, len);
+  idx->dict[id] = (TagDictEntry){.iv = iv, .value = e->key, .len = e->len};
+  if (idx->sorted) {
+    TrieMap_Add(idx->sorted, (char *)value, len, iv, NULL);
+  }
+  return id;
+}
+
+// The sorted view does not own the inverted indexes, which are freed through `values`. TrieMap
+// frees the values itself when given no callback
+static void sortedValues_freeCallback(void *p) {
+}
+
+static inline uint32_t tagIndex_FindId(const TagIndex *idx, const char *value, size_t len) {
+  return (uint32_t)(uintptr_t)StrMap_Find(&idx->values, value, len);
+}
+
 struct InvertedIndex *TagIndex_OpenIndex(TagIndex *idx, const char *value, size_t len, int create) {
-  InvertedIndex *iv = TrieMap_Find(idx->values, (char *)value, len);
-  if (iv == TRIEMAP_NOTFOUND) {
-    if (create) {
-      iv = NewInvertedIndex(Index_DocIdsOnly, 1);
-      TrieMap_Add(idx->values, (char *)value, len, iv, NULL);
-    }
+  uint32_t id = tagIndex_FindId(idx, value, len);
+  if (id) {
+    return idx->dict[id].iv;
+  }
+  if (!create) {
+    return TRIEMAP_NOTFOUND;
   }
+  InvertedIndex *iv = NewInvertedIndex(Index_DocIdsOnly, 1);
+  tagIndex_AddValue(idx, value, len, iv);
   return iv;
 }
 
+void TagIndex_DeleteValue(TagIndex *idx, const char *value, size_t len) {
+  uint32_t id = tagIndex_FindId(idx, value, len);
+  if (!id) {
+    return;
+  }
+  InvertedIndex *iv = idx->dict[id].iv;
+  // The GC only deletes values without documents, so the column entries still holding the id
+  // belong to deleted documents, which are never read. That makes the id safe to reuse.
+  idx->dict[id] = (TagDictEntry){0};
+  idx->freeIds = array_ensure_append_1(idx->freeIds, id);
+  idx->dictRevision++;
+
+  if (idx->sorted) {
+    TrieMap_Delete(idx->sorted, value, len, sortedValues_freeCallback);
+  }
+  if (idx->suffix) {
+    deleteSuffixTrieMap(idx->suffix, value, len);
+  }
+  StrMap_Delete(&idx->values, value, len);
+  InvertedIndex_Free(iv);
+}
+
+TrieMap *TagIndex_GetSortedValues(TagIndex *idx) {
+  if (!idx->sorted) {
+    idx->sorted = NewTrieMap();
+    TAGINDEX_FOREACH_VALUE(idx, e, {
+      TrieMap_Add(idx->sorted, (char *)e->value, e->len, e->iv, NULL);
+    });
+  }
+  return idx->sorted;
+}
+
+void TagIndex_SetDocValue(TagIndex *idx, t_docId docId, const char *value, size_t len) {
+  uint32_t id = tagIndex_FindId(idx, value, len);
+  if (!id) {
+    return;
+  }
+  t_docId page = docId / TAG_DOCVALUES_PAGE_SIZE;
+  size_t npages = array_len(idx->docValues);
+  if (!npages) {
+    idx->docValuesBase = page;
+  } else if (page < idx->docValuesBase) {
+    // only possible for documents older than the pages freed by the GC
+    size_t n = idx->docValuesBase - page;
+    idx->docValues = array_grow(idx->docValues, n);
+    memmove(idx->docValues + n, idx->docValues, npages * sizeof(*idx->docValues));
+    memset(idx->docValues, 0, n * sizeof(*idx->docValues));
+    idx->docValuesBase = page;
+  }
+
+  TagDocValuesPage **pp =
+      array_ensure_at(&idx->docValues, page - idx->docValuesBase, TagDocValuesPage *);
+  if (!*pp) {
+    *pp = rm_calloc(1, sizeof(**pp));
+  }
+  uint32_t *slot = (*pp)->ids + docId % TAG_DOCVALUES_PAGE_SIZE;
+  if (!*slot) {
+    (*pp)->numValues++;
+  }
+  *slot = id;
+}
+
+void TagIndex_ClearDocValues(TagIndex *idx, const t_docId *docIds, size_t n) {
+  size_t npages = array_len(idx->docValues);
+  for (size_t ii = 0; ii < n; ++ii) {
+    t_docId page = docIds[ii] / TAG_DOCVALUES_PAGE_SIZE;
+    if (page < idx->docValuesBase || page - idx->docValuesBase >= npages) {
+      continue;
+    }
+    TagDocValuesPage **pp = idx->docValues + (page - idx->docValuesBase);
+    uint32_t *slot = *pp ? (*pp)->ids + docIds[ii] % TAG_DOCVALUES_PAGE_SIZE : NULL;
+    if (!slot || !*slot) {
+      continue;
+    }
+    *slot = 0;
+    if (!--(*pp)->numValues) {
+      rm_free(*pp);
+      *pp = NULL;
+    }
+  }
+
+  // drop the empty pages at both ends, documents are mostly deleted oldest first
+  size_t first = 0, last = npages;
+  while (first < last && !idx->docValues[first]) {
+    first++;
+  }
+  while (last > first && !idx->docValues[last - 1]) {
+    last--;
+  }
+  if (first == last) {
+    array_free(idx->docValues);
+    idx->docValues = NULL;
+    idx->docValuesBase = 0;
+  } else if (first > 0 || last < npages) {
+    memmove(idx->docValues, idx->docValues + first, (last - first) * sizeof(*idx->docValues));
+    idx->docValues = array_trimm_cap(idx->docValues, last - first);
+    idx->docValuesBase += first;
+  }
+}
+
 /* Ecode a single docId into a specific tag value */
 static inline size_t tagIndex_Put(TagIndex *idx, const char *value, size_t len, t_docId docId) {
 
@@ -237,8 +380,9 @@ IndexIterator *TagIndex_GetReader(IndexSpec *sp, InvertedIndex *iv, const char *
 IndexIterator *TagIndex_OpenReader(TagIndex *idx, IndexSpec *sp, const char *value, size_t len,
                                    double weight) {
 
-  InvertedIndex *iv = TrieMap_Find(idx->values, (char *)value, len);
-  if (iv == TRIEMAP_NOTFOUND || !iv || iv->numDocs == 0) {
+  uint32_t id = tagIndex_FindId(idx, value, len);
+  InvertedIndex *iv = id ? idx->dict[id].iv : NULL;
+  if (!iv || iv->numDocs == 0) {
     return NULL;
   }
   return TagIndex_GetReader(sp, iv, value, len, weight);
@@ -298,23 +442,45 @@ TagIndex *TagIndex_Open(RedisSearchCtx *sctx, RedisModuleString *formattedKey, i
   return ret;
 }
 
-/* Serialize all the tags in the index to the redis client */
-void TagIndex_SerializeValues(TagIndex *idx, RedisModuleCtx *ctx) {
-  TrieMapIterator *it = TrieMap_Iterate(idx->values, "", 0);
+TagIndex *TagIndex_OpenColumn(RedisSearchCtx *sctx, const char *path) {
+  IndexSpec *sp = sctx->spec;
+  // the column is only kept for hash documents of indexes holding their tag indexes
+  if (!sp->keysDict || !isSpecHash(sp)) {
+    return NULL;
+  }
+  for (int ii = 0; ii < sp->numFields; ++ii) {
+    const FieldSpec *fs = sp->fields + ii;
+    // aliased fields are loaded by a fallback lookup, leave them to the document loader
+    if (FIELD_IS(fs, INDEXFLD_T_TAG) && !strcmp(fs->path, path)) {
+      RedisModuleString *kname = IndexSpec_GetFormattedKey(sp, fs, INDEXFLD_T_TAG);
+      return TagIndex_Open(sctx, kname, 0, NULL);
+    }
+  }
+  return NULL;
+}
 
-  char *str;
-  tm_len_t slen;
-  void *ptr;
-  RedisModule_ReplyWithArray(ctx, REDISMODULE_POSTPONED_ARRAY_LEN);
-  long long count = 0;
-  while (TrieMapIterator_Next(it, &str, &slen, &ptr)) {
-    ++count;
-    RedisModule_ReplyWithStringBuffer(ctx, str, slen);
+static int cmpTagEntries(const void *p1, const void *p2) {
+  const TagDictEntry *e1 = *(const TagDictEntry **)p1, *e2 = *(const TagDictEntry **)p2;
+  int rc = memcmp(e1->value, e2->value, MIN(e1->len, e2->len));
+  if (rc) {
+    return rc;
   }
+  return (int)e1->len - (int)e2->len;
+}
 
-  RedisModule_ReplySetArrayLength(ctx, count);
+/* Serialize all the tags in the index to the redis client */
+void TagIndex_SerializeValues(TagIndex *idx, RedisModuleCtx *ctx) {
+  // reply in lexicographic order without forcing the sorted view to be built
+  size_t n = 0;
+  const TagDictEntry **entries = rm_malloc(idx->values.size * sizeof(*entries));
+  TAGINDEX_FOREACH_VALUE(idx, e, { entries[n++] = e; });
+  qsort(entries, n, sizeof(*entries), cmpTagEntries);
 
-  TrieMapIterator_Free(it);
+  RedisModule_ReplyWithArray(ctx, n);
+  for (size_t ii = 0; ii < n; ++ii) {
+    RedisModule_ReplyWithStringBuffer(ctx, entries[ii]->value, entries[ii]->len);
+  }
+  rm_free(entries);
 }
 
 RedisModuleType *TagIndexType;
@@ -328,50 +494,49 @@ void *TagIndex_RdbLoad(RedisModuleIO *rdb, int encver) {
     char *s = RedisModule_LoadStringBuffer(rdb, &slen);
     InvertedIndex *inv = InvertedIndex_RdbLoad(rdb, INVERTED_INDEX_ENCVER);
     RS_LOG_ASSERT(inv, "loading inverted index from rdb failed");
-    TrieMap_Add(idx->values, s, MIN(slen, MAX_TAG_LEN), inv, NULL);
+    tagIndex_AddValue(idx, s, MIN(slen, MAX_TAG_LEN), inv);
     RedisModule_Free(s);
   }
   return idx;
 }
 void TagIndex_RdbSave(RedisModuleIO *rdb, void *value) {
   TagIndex *idx = value;
-  RedisModule_SaveUnsigned(rdb, idx->values->cardinality);
-  TrieMapIterator *it = TrieMap_Iterate(idx->values, "", 0);
-
-  char *str;
-  tm_len_t slen;
-  void *ptr;
+  RedisModule_SaveUnsigned(rdb, idx->values.size);
   size_t count = 0;
-  while (TrieMapIterator_Next(it, &str, &slen, &ptr)) {
+  TAGINDEX_FOREACH_VALUE(idx, e, {
     count++;
-    RedisModule_SaveStringBuffer(rdb, str, slen);
-    InvertedIndex *inv = ptr;
-    InvertedIndex_RdbSave(rdb, inv);
-  }
-  RS_LOG_ASSERT(count == idx->values->cardinality, "not all inverted indexes save to rdb");
-  TrieMapIterator_Free(it);
+    RedisModule_SaveStringBuffer(rdb, e->value, e->len);
+    InvertedIndex_RdbSave(rdb, e->iv);
+  });
+  RS_LOG_ASSERT(count == idx->values.size, "not all inverted indexes save to rdb");
 }
 
 void TagIndex_Free(void *p) {
   TagIndex *idx = p;
-  TrieMap_Free(idx->values, InvertedIndex_Free);
+  TAGINDEX_FOREACH_VALUE(idx, e, { InvertedIndex_Free(e->iv); });
+  array_free(idx->dict);
+  array_free(idx->freeIds);
+  StrMap_Free(&idx->values, NULL);
+  array_free_ex(idx->docValues, rm_free(*(TagDocValuesPage **)ptr));
+  TrieMap_Free(idx->sorted, sortedValues_freeCallback);
   TrieMap_Free(idx->suffix, suffixTrieMap_freeCallback);
   rm_free(idx);
 }
 
 size_t TagIndex_MemUsage(const void *value) {
   const TagIndex *idx = value;
-  size_t sz = sizeof(*idx);
-
-  TrieMapIterator *it = TrieMap_Iterate(idx->values, "", 0);
-
-  char *str;
-  tm_len_t slen;
-  void *ptr;
-  while (TrieMapIterator_Next(it, &str, &slen, &ptr)) {
-    sz += slen + InvertedIndex_MemUsage((InvertedIndex *)ptr);
+  size_t sz = sizeof(*idx) - sizeof(idx->values) + StrMap_MemUsage(&idx->values);
+  sz += array_len(idx->dict) * sizeof(*idx->dict);
+  sz += array_len(idx->freeIds) * sizeof(*idx->freeIds);
+  sz += array_len(idx->docValues) * sizeof(*idx->docValues);
+  array_foreach(idx->docValues, p, {
+    if (p) sz += sizeof(*p);
+  });
+
+  TAGINDEX_FOREACH_VALUE(idx, e, { sz += InvertedIndex_MemUsage(e->iv); });
+  if (idx->sorted) {
+    sz += TrieMap_MemUsage(idx->sorted);
   }
-  TrieMapIterator_Free(it);
   return sz;
 }
 
@@ -7,6 +7,7 @@
 #include "value.h"
 #include "geo_index.h"
 #include "vector_index.h"
+#include "util/strmap.h"
 
 struct InvertedIndex;
 
@@ -91,14 +92,57 @@ extern "C" {
  *
  *    127.0.0.7:6379> FT.SEARCH idx "@tags:{to\\ be\\ or\\ not\\ to\\ be}"
  *
+ * ## Storage
+ *
+ * Tag values are mapped to their inverted indexes in an open addressing hash map, which serves
+ * the exact-match lookups that make up the vast majority of tag queries. Prefix, wildcard and
+ * lexical range queries need ordered access, so a TrieMap over the same values is built lazily
+ * on the first such query (see TagIndex_GetSortedValues), and kept in sync from then on.
+ *
+ * Every value is also assigned a small integer id in the field's dictionary when it is first
+ * indexed. Documents whose field holds exactly one tag, identical to the raw field value, have
+ * that id recorded in a docId indexed column, which lets aggregations read the value of the field
+ * without loading the document (see TagIndex_GetDocValue).
+ *
+ * The column is split into pages that are only allocated once a document of their range has a
+ * value. The fork GC clears the entries of deleted documents and frees the pages left empty, and
+ * the ids of values it removes are reused by new values, so both stay proportional to the live
+ * data. Since document ids are never reused, a stale entry is never read for a live document.
  *
  */
+typedef struct {
+  struct InvertedIndex *iv;  // NULL if the value was removed by the GC
+  const char *value;         // owned by TagIndex.values
+  uint32_t len;
+} TagDictEntry;
+
+#define TAG_DOCVALUES_PAGE_SIZE 1024
+
+typedef struct {
+  uint32_t numValues;                     // number of non zero ids in the page
+  uint32_t ids[TAG_DOCVALUES_PAGE_SIZE];  // dictionary id per document, 0 if unknown
+} TagDocValuesPage;
+
 typedef struct {
   uint32_t uniqueId;
-  TrieMap *values;
+  StrMap values;              // tag value -> dictionary id
+  arrayof(TagDictEntry) dict; // dictionary id -> tag value and its inverted index
+  arrayof(uint32_t) freeIds;  // ids of values removed by the GC, reused by new values
+  uint32_t dictRevision;      // incremented whenever an id is released, see TagIndex_DeleteValue
+  arrayof(TagDocValuesPage *) docValues; // column pages, NULL where no document has a value
+  t_docId docValuesBase;      // page number of docValues[0], the pages before it were all freed
+  TrieMap *sorted;            // lazily built ordered view of `values`, NULL until first needed
   TrieMap *suffix;
 } TagIndex;
 
+/* Iterate the live entries of the tag dictionary, `e` is a `const TagDictEntry *` */
+#define TAGINDEX_FOREACH_VALUE(idx, e, block)                            \
+  for (uint32_t e##_ii = 1; e##_ii < array_len((idx)->dict); ++e##_ii) { \
+    const TagDictEntry *e = (idx)->dict + e##_ii;                        \
+    if (!e->iv) continue;                                                \
+    block;                                                               \
+  }
+
 #define TAG_INDEX_KEY_FMT "tag:%s/%s"
 /* Format the key name for a tag index */
 RedisModuleString *TagIndex_FormatName(RedisSearchCtx *sctx, const char *field);
@@ -110,11 +154,12 @@ void TagIndex_Free(void *p);
 
 char *TagIndex_SepString(char sep, char **s, size_t *toklen);
 
-/* Preprocess a document tag field, returning a vector of all tags split from the content */
-char **TagIndex_Preprocess(char sep, TagFieldFlags flags, const DocumentField *data);
+/* Preprocess a document tag field, returning a vector of all tags split from the content. The
+ * tags themselves are allocated from the arena, and live until it is cleared */
+char **TagIndex_Preprocess(char sep, TagFieldFlags flags, const DocumentField *data,
+                           BlkAlloc *arena);
 
 static inline void TagIndex_FreePreprocessedData(char **s) {
-  array_foreach(s, tmpv, { rm_free(tmpv); });
   array_free(s);
 }
 
@@ -133,6 +178,43 @@ TagIndex *TagIndex_Open(RedisSearchCtx *sctx, RedisModuleString *formattedKey, i
 
 struct InvertedIndex *TagIndex_OpenIndex(TagIndex *idx, const char *value, size_t len, int create);
 
+/* Remove a tag value and free its inverted index. Used by the GC once a value has no documents.
+ * The dictionary id of the value is released for reuse, and dictRevision is incremented so that
+ * readers caching anything per id can tell */
+void TagIndex_DeleteValue(TagIndex *idx, const char *value, size_t len);
+
+/* Return a TrieMap view of all the tag values, for prefix, wildcard and range queries.
+ * The view is built on first use and maintained from then on */
+TrieMap *TagIndex_GetSortedValues(TagIndex *idx);
+
+/* Record that the field of docId holds exactly `value`, which must have been indexed already */
+void TagIndex_SetDocValue(TagIndex *idx, t_docId docId, const char *value, size_t len);
+
+/* Forget the values recorded for the given documents, freeing the column pages left empty. Used
+ * by the GC for deleted documents */
+void TagIndex_ClearDocValues(TagIndex *idx, const t_docId *docIds, size_t n);
+
+/* Open the tag index of the TAG field at `path`, for reading the values of its column. Returns
+ * NULL if the field has no column, or no value was indexed for it yet */
+TagIndex *TagIndex_OpenColumn(RedisSearchCtx *sctx, const char *path);
+
+/* Return the dictionary id of the value recorded for docId, or 0 if none was recorded */
+static inline uint32_t TagIndex_GetDocValueId(const TagIndex *idx, t_docId docId) {
+  t_docId page = docId / TAG_DOCVALUES_PAGE_SIZE;
+  if (page < idx->docValuesBase || page - idx->docValuesBase >= array_len(idx->docValues)) {
+    return 0;
+  }
+  const TagDocValuesPage *p = idx->docValues[page - idx->docValuesBase];
+  uint32_t id = p ? p->ids[docId % TAG_DOCVALUES_PAGE_SIZE] : 0;
+  return id && idx->dict[id].iv ? id : 0;
+}
+
+/* Return the dictionary entry of the value recorded for docId, or NULL if none was recorded */
+static inline const TagDictEntry *TagIndex_GetDocValue(const TagIndex *idx, t_docId docId) {
+  uint32_t id = TagIndex_GetDocValueId(idx, docId);
+  return id ? idx->dict + id : NULL;
+}
+
 /* Serialize all the tags in the index to the redis client */
 void TagIndex_SerializeValues(TagIndex *idx, RedisModuleCtx *ctx);
 
@@ -5,6 +5,7 @@
 #include "rmalloc.h"
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 #include "phonetic_manager.h"
 
@@ -29,6 +30,47 @@ static void simpleTokenizer_Start(RSTokenizer *base, char *text, size_t len, uin
 // Normalization buffer
 #define MAX_NORMALIZE_SIZE 128
 
+// Word-at-a-time byte tests. Each tells whether any byte of the 8 in x matches, exactly for ASCII
+// bytes; bytes with the high bit set may give false positives, which only cost a slower scan.
+#define BYTES_ONES 0x0101010101010101ULL
+#define BYTES_HIGHS 0x8080808080808080ULL
+#define BYTES_LOWS 0x7f7f7f7f7f7f7f7fULL
+
+// Any byte < n, for n <= 128
+static inline uint64_t bytesHasLess(uint64_t x, uint8_t n) {
+  return (x - BYTES_ONES * n) & ~x & BYTES_HIGHS;
+}
+
+// Any byte equal to c
+static inline uint64_t bytesHas(uint64_t x, uint8_t c) {
+  uint64_t y = x ^ (BYTES_ONES * c);
+  return (y - BYTES_ONES) & ~y & BYTES_HIGHS;
+}
+
+// Any byte in (m, n), for n <= 128
+static inline uint64_t bytesHasBetween(uint64_t x, uint8_t m, uint8_t n) {
+  uint64_t low = x & BYTES_LOWS;
+  return (BYTES_ONES * (127 + n) - low) & ~x & (low + BYTES_ONES * (127 - m)) & BYTES_HIGHS;
+}
+
+/**
+ * Returns the length of a prefix of s which DefaultNormalize leaves as is - no upper case letters,
+ * blanks, control characters or escapes. Checks 8 bytes at a time, so it may stop up to 7 bytes
+ * short of the first byte that needs normalizing.
+ */
+static inline size_t normalizedPrefixLen(const char *s, size_t len) {
+  size_t ii = 0;
+  for (; ii + sizeof(uint64_t) <= len; ii += sizeof(uint64_t)) {
+    uint64_t x;
+    memcpy(&x, s + ii, sizeof(x));
+    if (bytesHasLess(x, ' ' + 1) | bytesHasBetween(x, 'A' - 1, 'Z' + 1) | bytesHas(x, '\\') |
+        bytesHas(x, 0x7f)) {
+      break;
+    }
+  }
+  return ii;
+}
+
 /**
  * Normalizes text.
  * - s contains the raw token
@@ -46,9 +88,16 @@ static char *DefaultNormalize(char *s, char *dst, size_t *len) {
     realDest = dst;          \
     memcpy(realDest, s, ii); \
   }
+  // Most tokens are already lower case, so skip over what needs no normalizing first
+  size_t prefixLen = normalizedPrefixLen(s, origLen);
+  if (dst != s) {
+    memcpy(dst, s, prefixLen);
+  }
+  dstLen = prefixLen;
+
   // set to 1 if the previous character was a backslash escape
   int escaped = 0;
-  for (size_t ii = 0; ii < origLen; ++ii) {
+  for (size_t ii = prefixLen; ii < origLen; ++ii) {
     if (isupper(s[ii])) {
       SWITCH_DEST();
       realDest[dstLen++] = tolower(s[ii]);
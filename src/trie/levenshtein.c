@@ -2,8 +2,10 @@
 #include <stdio.h>
 #include <sys/param.h>
 #include <string.h>
+#include <pthread.h>
 #include "levenshtein.h"
 #include "rune_util.h"
+#include "util/fnv.h"
 #include "rmalloc.h"
 
 // NewSparseAutomaton creates a new automaton for the string s, with a given max
@@ -105,21 +107,55 @@ int __sv_equals(sparseVector *sv1, sparseVector *sv2) {
   return 1;
 }
 
-dfaNode *__dfn_getCache(Vector *cache, sparseVector *v) {
-  size_t n = Vector_Size(cache);
-  for (int i = 0; i < n; i++) {
-    dfaNode *dfn;
-    Vector_Get(cache, i, &dfn);
+static inline uint32_t __sv_hash(sparseVector *sv) {
+  return rs_fnv_32a_buf(sv->entries, sv->len * sizeof(*sv->entries), 0);
+}
+
+#define DFA_STATES_INITIAL_CAP 16
+
+static void __dfaStates_init(dfaStates *states) {
+  states->nodes = NewVector(dfaNode *, 8);
+  states->cap = DFA_STATES_INITIAL_CAP;
+  states->table = rm_calloc(states->cap, sizeof(*states->table));
+}
 
-    if (__sv_equals(v, dfn->v)) {
+static void __dfaStates_place(dfaStates *states, dfaNode *dfn) {
+  size_t mask = states->cap - 1;
+  size_t pos = dfn->hash & mask;
+  while (states->table[pos]) {
+    pos = (pos + 1) & mask;
+  }
+  states->table[pos] = dfn;
+}
+
+dfaNode *__dfn_getCache(dfaStates *states, sparseVector *v) {
+  uint32_t hash = __sv_hash(v);
+  size_t mask = states->cap - 1;
+  for (size_t pos = hash & mask; states->table[pos]; pos = (pos + 1) & mask) {
+    dfaNode *dfn = states->table[pos];
+    if (dfn->hash == hash && __sv_equals(v, dfn->v)) {
       return dfn;
     }
   }
   return NULL;
 }
 
-void __dfn_putCache(Vector *cache, dfaNode *dfn) {
-  Vector_Push(cache, dfn);
+void __dfn_putCache(dfaStates *states, dfaNode *dfn) {
+  dfn->hash = __sv_hash(dfn->v);
+  Vector_Push(states->nodes, dfn);
+  // keep the table at most half full
+  if (Vector_Size(states->nodes) * 2 > states->cap) {
+    rm_free(states->table);
+    states->cap *= 2;
+    states->table = rm_calloc(states->cap, sizeof(*states->table));
+    for (size_t i = 0; i < Vector_Size(states->nodes); i++) {
+      dfaNode *n;
+      Vector_Get(states->nodes, i, &n);
+      __dfaStates_place(states, n);
+    }
+  } else {
+    __dfaStates_place(states, dfn);
+  }
 }
 
 inline dfaNode *__dfn_getEdge(dfaNode *n, rune r) {
@@ -136,7 +172,7 @@ void __dfn_addEdge(dfaNode *n, rune r, dfaNode *child) {
   n->edges[n->numEdges++] = (dfaEdge){.r = r, .n = child};
 }
 
-void dfa_build(dfaNode *parent, SparseAutomaton *a, Vector *cache) {
+void dfa_build(dfaNode *parent, SparseAutomaton *a, dfaStates *cache) {
   parent->match = SparseAutomaton_IsMatch(a, parent->v);
 
   for (int i = 0; i < parent->v->len; i++) {
@@ -185,21 +221,196 @@ void dfa_build(dfaNode *parent, SparseAutomaton *a, Vector *cache) {
   //}
 }
 
-DFAFilter *NewDFAFilter(rune *str, size_t len, int maxDist, int prefixMode) {
-  Vector *cache = NewVector(dfaNode *, 8);
+/***************************************************************************************
+ * Compiled DFA cache
+ ***************************************************************************************/
+
+// Number of recently used DFAs kept around. Fuzzy terms come mostly from type-ahead and
+// spell checking, where the same few terms are repeated over and over
+#define DFA_CACHE_SIZE 128
+
+static struct {
+  LevenshteinDFA *head, *tail;  // most and least recently used
+  size_t size;
+  size_t lookups;
+  size_t hits;
+  pthread_mutex_t lock;
+} dfaCache_g = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static uint32_t dfaHash(const rune *str, size_t len, int maxDist) {
+  return rs_fnv_32a_buf(str, len * sizeof(*str), (uint32_t)maxDist);
+}
+
+static LevenshteinDFA *dfaCompile(const rune *str, size_t len, int maxDist, uint32_t hash) {
+  LevenshteinDFA *dfa = rm_calloc(1, sizeof(*dfa));
+  dfa->str = rm_malloc((len + 1) * sizeof(*str));
+  memcpy(dfa->str, str, len * sizeof(*str));
+  dfa->str[len] = 0;
+  dfa->len = len;
+  dfa->maxDist = maxDist;
+  dfa->hash = hash;
+  dfa->refcount = 1;
+
+  SparseAutomaton a = NewSparseAutomaton(dfa->str, len, maxDist);
+  dfaStates states;
+  __dfaStates_init(&states);
+  dfaNode *dr = __newDfaNode(0, SparseAutomaton_Start(&a));
+  __dfn_putCache(&states, dr);
+  dfa_build(dr, &a, &states);
+
+  rm_free(states.table);
+  dfa->nodes = states.nodes;
+  return dfa;
+}
 
-  SparseAutomaton a = NewSparseAutomaton(str, len, maxDist);
+static void dfaFree(LevenshteinDFA *dfa) {
+  for (int i = 0; i < Vector_Size(dfa->nodes); i++) {
+    dfaNode *dn;
+    Vector_Get(dfa->nodes, i, &dn);
+
+    if (dn) __dfaNode_free(dn);
+  }
+  Vector_Free(dfa->nodes);
+  rm_free(dfa->str);
+  rm_free(dfa);
+}
+
+// The cache functions below must be called with the cache lock held
+
+static void dfaCacheUnlink(LevenshteinDFA *dfa) {
+  if (dfa->prev) {
+    dfa->prev->next = dfa->next;
+  } else {
+    dfaCache_g.head = dfa->next;
+  }
+  if (dfa->next) {
+    dfa->next->prev = dfa->prev;
+  } else {
+    dfaCache_g.tail = dfa->prev;
+  }
+  dfa->prev = dfa->next = NULL;
+}
 
-  sparseVector *v = SparseAutomaton_Start(&a);
-  dfaNode *dr = __newDfaNode(0, v);
-  __dfn_putCache(cache, dr);
-  dfa_build(dr, &a, cache);
+static void dfaCachePushFront(LevenshteinDFA *dfa) {
+  dfa->prev = NULL;
+  dfa->next = dfaCache_g.head;
+  if (dfaCache_g.head) {
+    dfaCache_g.head->prev = dfa;
+  } else {
+    dfaCache_g.tail = dfa;
+  }
+  dfaCache_g.head = dfa;
+}
+
+static LevenshteinDFA *dfaCacheFind(const rune *str, size_t len, int maxDist, uint32_t hash) {
+  for (LevenshteinDFA *dfa = dfaCache_g.head; dfa; dfa = dfa->next) {
+    if (dfa->hash == hash && dfa->len == len && dfa->maxDist == maxDist &&
+        !memcmp(dfa->str, str, len * sizeof(*str))) {
+      return dfa;
+    }
+  }
+  return NULL;
+}
+
+/* Returns the evicted DFA if it is no longer used by anyone, so it can be freed outside the lock */
+static LevenshteinDFA *dfaCacheEvict(void) {
+  LevenshteinDFA *dfa = dfaCache_g.tail;
+  dfaCacheUnlink(dfa);
+  dfaCache_g.size--;
+  return --dfa->refcount ? NULL : dfa;
+}
+
+LevenshteinDFA *LevenshteinDFA_Get(const rune *str, size_t len, int maxDist) {
+  uint32_t hash = dfaHash(str, len, maxDist);
+
+  pthread_mutex_lock(&dfaCache_g.lock);
+  dfaCache_g.lookups++;
+  LevenshteinDFA *dfa = dfaCacheFind(str, len, maxDist, hash);
+  if (dfa) {
+    dfaCache_g.hits++;
+    dfa->refcount++;
+    dfaCacheUnlink(dfa);
+    dfaCachePushFront(dfa);
+  }
+  pthread_mutex_unlock(&dfaCache_g.lock);
+  if (dfa) {
+    return dfa;
+  }
+
+  // build outside the lock, so that concurrent queries are not serialized on construction
+  LevenshteinDFA *built = dfaCompile(str, len, maxDist, hash);
+  LevenshteinDFA *evicted = NULL;
+
+  pthread_mutex_lock(&dfaCache_g.lock);
+  // another thread may have built the same DFA in the meantime
+  dfa = dfaCacheFind(str, len, maxDist, hash);
+  if (dfa) {
+    dfa->refcount++;
+  } else {
+    dfa = built;
+    built = NULL;
+    dfa->refcount++;  // the cache's reference
+    dfaCachePushFront(dfa);
+    if (++dfaCache_g.size > DFA_CACHE_SIZE) {
+      evicted = dfaCacheEvict();
+    }
+  }
+  pthread_mutex_unlock(&dfaCache_g.lock);
+
+  if (built) {
+    dfaFree(built);
+  }
+  if (evicted) {
+    dfaFree(evicted);
+  }
+  return dfa;
+}
+
+void LevenshteinDFA_Release(LevenshteinDFA *dfa) {
+  pthread_mutex_lock(&dfaCache_g.lock);
+  size_t refcount = --dfa->refcount;
+  pthread_mutex_unlock(&dfaCache_g.lock);
+  if (!refcount) {
+    dfaFree(dfa);
+  }
+}
+
+void LevenshteinDFA_GetCacheStats(LevenshteinDFACacheStats *stats) {
+  pthread_mutex_lock(&dfaCache_g.lock);
+  stats->lookups = dfaCache_g.lookups;
+  stats->hits = dfaCache_g.hits;
+  stats->size = dfaCache_g.size;
+  pthread_mutex_unlock(&dfaCache_g.lock);
+}
+
+void LevenshteinDFA_ClearCache(void) {
+  pthread_mutex_lock(&dfaCache_g.lock);
+  LevenshteinDFA *unused = NULL;
+  while (dfaCache_g.tail) {
+    LevenshteinDFA *dfa = dfaCacheEvict();
+    if (dfa) {
+      dfa->next = unused;
+      unused = dfa;
+    }
+  }
+  pthread_mutex_unlock(&dfaCache_g.lock);
+  while (unused) {
+    LevenshteinDFA *next = unused->next;
+    dfaFree(unused);
+    unused = next;
+  }
+}
+
+DFAFilter *NewDFAFilter(rune *str, size_t len, int maxDist, int prefixMode) {
+  LevenshteinDFA *dfa = LevenshteinDFA_Get(str, len, maxDist);
+  dfaNode *dr;
+  Vector_Get(dfa->nodes, 0, &dr);
 
   DFAFilter *ret = rm_malloc(sizeof(*ret));
-  ret->cache = cache;
+  ret->dfa = dfa;
   ret->stack = NewVector(dfaNode *, 8);
   ret->distStack = NewVector(int, 8);
-  ret->a = a;
+  ret->a = NewSparseAutomaton(dfa->str, len, maxDist);
   ret->prefixMode = prefixMode;
   Vector_Push(ret->stack, dr);
   Vector_Push(ret->distStack, (maxDist + 1));
@@ -208,14 +419,7 @@ DFAFilter *NewDFAFilter(rune *str, size_t len, int maxDist, int prefixMode) {
 }
 
 void DFAFilter_Free(DFAFilter *fc) {
-  for (int i = 0; i < Vector_Size(fc->cache); i++) {
-    dfaNode *dn;
-    Vector_Get(fc->cache, i, &dn);
-
-    if (dn) __dfaNode_free(dn);
-  }
-
-  Vector_Free(fc->cache);
+  LevenshteinDFA_Release(fc->dfa);
   Vector_Free(fc->stack);
   Vector_Free(fc->distStack);
 }
@@ -254,6 +458,11 @@ FilterCode FilterFunc(rune b, void *ctx, int *matched, void *matchCtx) {
 
   // we can continue - push the state on the stack
   if (next) {
+    // the runes read so far include b now, so outside prefix mode they only match if the state
+    // after b does. Otherwise a term one edit too far is let through after a matching prefix
+    if (!fc->prefixMode) {
+      *matched = 0;
+    }
     if (next->match) {
       // printf("MATCH NEXT %c, dist %d\n", b, next->distance);
       *matched = 1;
@@ -2,6 +2,7 @@
 #define __LEVENSHTEIN_H__
 
 #include <stdlib.h>
+#include <stdint.h>
 
 #include "sparse_vector.h"
 #include "rmutil/vector.h"
@@ -26,6 +27,7 @@ struct dfaEdge;
 /* dfaNode is DFA graph node constructed using the Levenshtein automaton */
 typedef struct dfaNode {
     int distance;
+    uint32_t hash;  // hash of the state vector
 
     int match;
     sparseVector *v;
@@ -46,8 +48,18 @@ dfaNode *__dfn_getEdge(dfaNode *n, rune r);
 /* Create a new DFA node */
 dfaNode *__newDfaNode(int distance, sparseVector *state);
 
+/* The states of a DFA under construction, hashed by their state vector so that equal states are
+ * only created once */
+typedef struct {
+    // all the states in creation order, owning them. The first one is the root
+    Vector *nodes;
+    // open addressing table of the states
+    dfaNode **table;
+    size_t cap;
+} dfaStates;
+
 /* Recusively build the DFA node and all its descendants */
-void dfa_build(dfaNode *parent, SparseAutomaton *a, Vector *cache);
+void dfa_build(dfaNode *parent, SparseAutomaton *a, dfaStates *states);
 
 /* Create a new Sparse Levenshtein Automaton  for string s and length len, with a maximal edit
  * distance of maxEdits */
@@ -65,10 +77,43 @@ int SparseAutomaton_IsMatch(SparseAutomaton *a, sparseVector *v);
 /* Can the current state lead to a possible match, or is this a dead end? */
 int SparseAutomaton_CanMatch(SparseAutomaton *a, sparseVector *v);
 
+/* LevenshteinDFA is a compiled DFA for a string and a maximal distance. A DFA is immutable once
+ * built, so the filters for the same fuzzy term share one DFA, and recently used DFAs are kept in
+ * an LRU cache instead of being rebuilt by every query. */
+typedef struct LevenshteinDFA {
+    rune *str;
+    size_t len;
+    int maxDist;
+    uint32_t hash;
+    // all the DFA states, the first one is the root
+    Vector *nodes;
+    // number of filters using the DFA, plus one while it is in the cache
+    size_t refcount;
+    // LRU list links, most recently used first
+    struct LevenshteinDFA *prev, *next;
+} LevenshteinDFA;
+
+/* Get the DFA for the given string and maximal distance, from the cache or by building it. The
+ * DFA must be released with LevenshteinDFA_Release */
+LevenshteinDFA *LevenshteinDFA_Get(const rune *str, size_t len, int maxDist);
+
+void LevenshteinDFA_Release(LevenshteinDFA *dfa);
+
+typedef struct {
+    size_t lookups;
+    size_t hits;
+    size_t size;  // number of cached DFAs
+} LevenshteinDFACacheStats;
+
+void LevenshteinDFA_GetCacheStats(LevenshteinDFACacheStats *stats);
+
+/* Release all the cached DFAs */
+void LevenshteinDFA_ClearCache(void);
+
 /* DFAFilter is a constructed DFA used to filter the traversal on the trie */
 typedef struct {
-    // a cache of the DFA states, allowing us to re-use the same state whenever we need it
-    Vector *cache;
+    // the shared DFA the filter walks
+    LevenshteinDFA *dfa;
     // A stack of the states leading up to the current state
     Vector *stack;
     // A stack of the minimal distance for each state, used for prefix matching
@@ -0,0 +1,304 @@
+#include "search_cache.h"
+#include "rune_util.h"
+#include "rmalloc.h"
+
+#include <string.h>
+#include <sys/types.h>
+
+typedef struct {
+  char *str;
+  size_t len;
+  rune *runes;  // the entry as stored in the trie, to match the inserted and deleted entries
+  size_t rlen;
+  float score;
+  char *payload;
+  size_t plen;
+} cachedResult;
+
+typedef struct searchCacheEntry {
+  char *query;
+  size_t len;
+  rune *runes;  // folded
+  size_t rlen;
+  size_t num;
+  int maxDist;
+  int prefixMode;
+  int trim;
+  cachedResult *results;  // sorted by descending score, room for num results
+  size_t n;
+  struct searchCacheEntry *prev, *next;
+} searchCacheEntry;
+
+struct TrieSearchCache {
+  searchCacheEntry *head, *tail;  // most and least recently used
+  size_t size;
+  size_t lookups;
+  size_t hits;
+};
+
+TrieSearchCache *NewTrieSearchCache() {
+  return rm_calloc(1, sizeof(TrieSearchCache));
+}
+
+static void cachedResultFree(cachedResult *r) {
+  rm_free(r->str);
+  rm_free(r->runes);
+  rm_free(r->payload);
+}
+
+static void entryFree(searchCacheEntry *e) {
+  for (size_t ii = 0; ii < e->n; ++ii) {
+    cachedResultFree(e->results + ii);
+  }
+  rm_free(e->results);
+  rm_free(e->query);
+  rm_free(e->runes);
+  rm_free(e);
+}
+
+static void entryUnlink(TrieSearchCache *c, searchCacheEntry *e) {
+  if (e->prev) {
+    e->prev->next = e->next;
+  } else {
+    c->head = e->next;
+  }
+  if (e->next) {
+    e->next->prev = e->prev;
+  } else {
+    c->tail = e->prev;
+  }
+  e->prev = e->next = NULL;
+}
+
+static void entryPushFront(TrieSearchCache *c, searchCacheEntry *e) {
+  e->prev = NULL;
+  e->next = c->head;
+  if (c->head) {
+    c->head->prev = e;
+  } else {
+    c->tail = e;
+  }
+  c->head = e;
+}
+
+static void entryDrop(TrieSearchCache *c, searchCacheEntry *e) {
+  entryUnlink(c, e);
+  entryFree(e);
+  c->size--;
+}
+
+void TrieSearchCache_Free(TrieSearchCache *c) {
+  while (c->head) {
+    entryDrop(c, c->head);
+  }
+  rm_free(c);
+}
+
+size_t TrieSearchCache_MemUsage(const TrieSearchCache *c) {
+  size_t sz = sizeof(*c);
+  for (const searchCacheEntry *e = c->head; e; e = e->next) {
+    sz += sizeof(*e) + e->len + e->rlen * sizeof(rune) + e->num * sizeof(cachedResult);
+    for (size_t ii = 0; ii < e->n; ++ii) {
+      sz += e->results[ii].len + e->results[ii].rlen * sizeof(rune) + e->results[ii].plen;
+    }
+  }
+  return sz;
+}
+
+void TrieSearchCache_GetStats(const TrieSearchCache *c, TrieSearchCacheStats *stats) {
+  stats->lookups = c->lookups;
+  stats->hits = c->hits;
+  stats->size = c->size;
+}
+
+static searchCacheEntry *entryFind(TrieSearchCache *c, const char *s, size_t len, size_t num,
+                                   int maxDist, int prefixMode, int trim) {
+  for (searchCacheEntry *e = c->head; e; e = e->next) {
+    if (e->len == len && e->num == num && e->maxDist == maxDist && e->prefixMode == prefixMode &&
+        e->trim == trim && !memcmp(e->query, s, len)) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+Vector *TrieSearchCache_Get(TrieSearchCache *c, const char *s, size_t len, size_t num, int maxDist,
+                            int prefixMode, int trim) {
+  c->lookups++;
+  searchCacheEntry *e = entryFind(c, s, len, num, maxDist, prefixMode, trim);
+  if (!e) {
+    return NULL;
+  }
+  c->hits++;
+  entryUnlink(c, e);
+  entryPushFront(c, e);
+
+  Vector *ret = NewVector(TrieSearchResult *, e->n);
+  for (size_t ii = 0; ii < e->n; ++ii) {
+    const cachedResult *r = e->results + ii;
+    TrieSearchResult *res = rm_malloc(sizeof(*res));
+    res->str = rm_strndup(r->str, r->len);
+    res->len = r->len;
+    res->score = r->score;
+    res->payload = r->payload;
+    res->plen = r->plen;
+    Vector_Push(ret, res);
+  }
+  return ret;
+}
+
+static void setPayload(cachedResult *r, const char *payload, size_t plen) {
+  rm_free(r->payload);
+  r->payload = NULL;
+  r->plen = 0;
+  if (payload && plen) {
+    r->payload = rm_malloc(plen);
+    memcpy(r->payload, payload, plen);
+    r->plen = plen;
+  }
+}
+
+void TrieSearchCache_Put(TrieSearchCache *c, const char *s, size_t len, const rune *runes,
+                         size_t rlen, size_t num, int maxDist, int prefixMode, int trim,
+                         Vector *results) {
+  if (num > TRIE_SEARCH_CACHE_MAX_RESULTS ||
+      entryFind(c, s, len, num, maxDist, prefixMode, trim)) {
+    return;
+  }
+
+  searchCacheEntry *e = rm_calloc(1, sizeof(*e));
+  e->query = rm_malloc(len);
+  memcpy(e->query, s, len);
+  e->len = len;
+  e->runes = rm_malloc(rlen * sizeof(rune) + 1);
+  memcpy(e->runes, runes, rlen * sizeof(rune));
+  e->rlen = rlen;
+  e->num = num;
+  e->maxDist = maxDist;
+  e->prefixMode = prefixMode;
+  e->trim = trim;
+  e->results = rm_calloc(num, sizeof(*e->results));
+  for (size_t ii = 0; ii < Vector_Size(results) && ii < num; ++ii) {
+    TrieSearchResult *res;
+    Vector_Get(results, ii, &res);
+    cachedResult *r = e->results + e->n++;
+    r->str = rm_strndup(res->str, res->len);
+    r->len = res->len;
+    r->runes = strToRunes(res->str, &r->rlen);
+    r->score = res->score;
+    setPayload(r, res->payload, res->plen);
+  }
+
+  entryPushFront(c, e);
+  if (++c->size > TRIE_SEARCH_CACHE_SIZE) {
+    entryDrop(c, c->tail);
+  }
+}
+
+/* Returns 1 if a search for the entry's string would yield str */
+static int entryMatches(const searchCacheEntry *e, const rune *str, size_t len) {
+  if (len < e->rlen) {
+    return 0;
+  }
+  for (size_t ii = 0; ii < e->rlen; ++ii) {
+    if (runeFold(str[ii]) != e->runes[ii]) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static ssize_t entryFindResult(const searchCacheEntry *e, const rune *str, size_t len) {
+  for (size_t ii = 0; ii < e->n; ++ii) {
+    if (e->results[ii].rlen == len && !memcmp(e->results[ii].runes, str, len * sizeof(rune))) {
+      return ii;
+    }
+  }
+  return -1;
+}
+
+/* Move the result at idx to its place by score, after the results with the same score */
+static void entryReorder(searchCacheEntry *e, size_t idx) {
+  cachedResult r = e->results[idx];
+  memmove(e->results + idx, e->results + idx + 1, (e->n - idx - 1) * sizeof(r));
+  size_t pos = 0;
+  while (pos < e->n - 1 && e->results[pos].score >= r.score) {
+    pos++;
+  }
+  memmove(e->results + pos + 1, e->results + pos, (e->n - 1 - pos) * sizeof(r));
+  e->results[pos] = r;
+}
+
+/* Only exact prefix searches can be updated in place */
+static inline int entryIsIncremental(const searchCacheEntry *e) {
+  return e->prefixMode && !e->maxDist && !e->trim;
+}
+
+void TrieSearchCache_OnInsert(TrieSearchCache *c, const rune *str, size_t len, float score,
+                              const char *payload, size_t plen) {
+  searchCacheEntry *next;
+  for (searchCacheEntry *e = c->head; e; e = next) {
+    next = e->next;
+    if (!entryIsIncremental(e)) {
+      entryDrop(c, e);
+      continue;
+    }
+    if (!entryMatches(e, str, len)) {
+      continue;
+    }
+
+    float entScore = Trie_SearchScore(e->runes, e->rlen, e->len, str, len, score, 0, 0, 1);
+    int full = e->n == e->num;
+    ssize_t idx = entryFindResult(e, str, len);
+    if (idx >= 0) {
+      if (full && entScore < e->results[idx].score) {
+        // an entry that is not cached may now rank higher
+        entryDrop(c, e);
+        continue;
+      }
+    } else {
+      if (full && entScore <= e->results[e->n - 1].score) {
+        continue;
+      }
+      if (full) {
+        cachedResultFree(e->results + --e->n);
+      }
+      idx = e->n++;
+      cachedResult *r = e->results + idx;
+      memset(r, 0, sizeof(*r));
+      r->str = runesToStr(str, len, &r->len);
+      r->runes = rm_malloc(len * sizeof(rune));
+      memcpy(r->runes, str, len * sizeof(rune));
+      r->rlen = len;
+    }
+    e->results[idx].score = entScore;
+    setPayload(e->results + idx, payload, plen);
+    entryReorder(e, idx);
+  }
+}
+
+void TrieSearchCache_OnDelete(TrieSearchCache *c, const rune *str, size_t len) {
+  searchCacheEntry *next;
+  for (searchCacheEntry *e = c->head; e; e = next) {
+    next = e->next;
+    if (!entryIsIncremental(e)) {
+      entryDrop(c, e);
+      continue;
+    }
+    if (!entryMatches(e, str, len)) {
+      continue;
+    }
+    ssize_t idx = entryFindResult(e, str, len);
+    if (idx < 0) {
+      continue;
+    }
+    if (e->n == e->num) {
+      // the entry that replaces it in the results is not known
+      entryDrop(c, e);
+      continue;
+    }
+    cachedResultFree(e->results + idx);
+    memmove(e->results + idx, e->results + idx + 1, (e->n - idx - 1) * sizeof(cachedResult));
+    e->n--;
+  }
+}
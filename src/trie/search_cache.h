@@ -0,0 +1,66 @@
+#ifndef __TRIE_SEARCH_CACHE_H__
+#define __TRIE_SEARCH_CACHE_H__
+
+#include <stdlib.h>
+
+#include "trie_type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * TrieSearchCache keeps the results of recent Trie_Search calls on a trie, so the prefixes that
+ * auto-complete traffic asks for over and over are answered without walking the trie.
+ *
+ * Each cached prefix holds its top results, and is kept up to date as the trie changes: an entry
+ * inserted under the prefix is merged into its results if it ranks high enough, and the prefix is
+ * only dropped (and searched again on its next lookup) when an entry of a full result list is
+ * deleted or loses score, since the entry replacing it is not known. Fuzzy and trimmed searches
+ * depend on the whole trie, so they are dropped on every change.
+ */
+
+// The number of searches kept per trie
+#define TRIE_SEARCH_CACHE_SIZE 128
+// Searches asking for more results are not cached
+#define TRIE_SEARCH_CACHE_MAX_RESULTS 100
+
+typedef struct TrieSearchCache TrieSearchCache;
+
+typedef struct {
+  size_t lookups;
+  size_t hits;
+  size_t size;
+} TrieSearchCacheStats;
+
+TrieSearchCache *NewTrieSearchCache();
+
+void TrieSearchCache_Free(TrieSearchCache *c);
+
+size_t TrieSearchCache_MemUsage(const TrieSearchCache *c);
+
+void TrieSearchCache_GetStats(const TrieSearchCache *c, TrieSearchCacheStats *stats);
+
+/* Returns the results of a cached search, in the form Trie_Search returns them, or NULL if the
+ * search is not cached. The payloads of the results belong to the cache and are only valid until
+ * the trie is modified */
+Vector *TrieSearchCache_Get(TrieSearchCache *c, const char *s, size_t len, size_t num, int maxDist,
+                            int prefixMode, int trim);
+
+/* Cache the results of a search. runes is the folded search string */
+void TrieSearchCache_Put(TrieSearchCache *c, const char *s, size_t len, const rune *runes,
+                         size_t rlen, size_t num, int maxDist, int prefixMode, int trim,
+                         Vector *results);
+
+/* Update the cached searches after an entry was inserted or updated in the trie, with its new
+ * score and payload */
+void TrieSearchCache_OnInsert(TrieSearchCache *c, const rune *str, size_t len, float score,
+                              const char *payload, size_t plen);
+
+/* Update the cached searches after an entry was deleted from the trie */
+void TrieSearchCache_OnDelete(TrieSearchCache *c, const rune *str, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,212 @@
+#include "suffix_array.h"
+#include "redisearch.h"
+#include "rmalloc.h"
+#include "rune_util.h"
+#include "wildcard/wildcard.h"
+#include "util/timeout.h"
+
+#include <string.h>
+
+typedef struct {
+  char *text;
+  size_t len;
+  size_t cap;
+  size_t numSuffixes;
+} textBuilder;
+
+static inline int isCharStart(char c) {
+  return ((unsigned char)c & 0xC0) != 0x80;
+}
+
+static int appendTermCb(const char *s, size_t n, void *p, void *payload) {
+  textBuilder *b = p;
+  if (b->len + n + 1 > b->cap) {
+    b->cap = (b->cap + n + 1) * 2;
+    b->text = rm_realloc(b->text, b->cap);
+  }
+  memcpy(b->text + b->len, s, n);
+  for (size_t ii = 0; ii + SUFFIX_ARRAY_MIN_SUFFIX <= n; ++ii) {
+    b->numSuffixes += isCharStart(s[ii]);
+  }
+  b->len += n;
+  b->text[b->len++] = '\0';
+  return REDISEARCH_OK;
+}
+
+static int cmpSuffixes(const void *p1, const void *p2) {
+  return strcmp(*(const char **)p1, *(const char **)p2);
+}
+
+SuffixArray *NewSuffixArray(const TermsSnapshot *s) {
+  textBuilder b = {0};
+  TermsSnapshot_IteratePrefix(s, "", 0, appendTermCb, &b);
+
+  // sort pointers to the suffixes first, the NUL after each term ends the comparison
+  const char **ptrs = rm_malloc((b.numSuffixes ? b.numSuffixes : 1) * sizeof(*ptrs));
+  size_t n = 0;
+  for (size_t start = 0; start < b.len;) {
+    size_t tlen = strlen(b.text + start);
+    for (size_t ii = 0; ii + SUFFIX_ARRAY_MIN_SUFFIX <= tlen; ++ii) {
+      if (isCharStart(b.text[start + ii])) {
+        ptrs[n++] = b.text + start + ii;
+      }
+    }
+    start += tlen + 1;
+  }
+  qsort(ptrs, n, sizeof(*ptrs), cmpSuffixes);
+
+  SuffixArray *sa = rm_malloc(sizeof(*sa));
+  sa->text = b.len ? rm_realloc(b.text, b.len) : b.text;
+  sa->textLen = b.len;
+  sa->numSuffixes = n;
+  sa->suffixes = rm_malloc((n ? n : 1) * sizeof(*sa->suffixes));
+  for (size_t ii = 0; ii < n; ++ii) {
+    sa->suffixes[ii] = ptrs[ii] - b.text;
+  }
+  rm_free(ptrs);
+  return sa;
+}
+
+void SuffixArray_Free(SuffixArray *sa) {
+  rm_free(sa->text);
+  rm_free(sa->suffixes);
+  rm_free(sa);
+}
+
+size_t SuffixArray_MemUsage(const SuffixArray *sa) {
+  return sizeof(*sa) + sa->textLen + sa->numSuffixes * sizeof(*sa->suffixes);
+}
+
+/* Binary search the bounds of the suffixes starting with str: returns the first suffix whose first
+ * len bytes compare >= str, or > str if upper is set */
+static size_t searchBound(const SuffixArray *sa, const char *str, size_t len, int upper) {
+  size_t lo = 0, hi = sa->numSuffixes;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    int rc = strncmp(sa->text + sa->suffixes[mid], str, len);
+    if (rc < 0 || (upper && rc == 0)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+static int cmpOffsets(const void *p1, const void *p2) {
+  uint32_t o1 = *(const uint32_t *)p1, o2 = *(const uint32_t *)p2;
+  return (o1 > o2) - (o1 < o2);
+}
+
+/* Collect the offsets of the distinct terms holding a suffix starting with str, in term order.
+ * Returns NULL if the timeout is reached */
+static uint32_t *collectTerms(const SuffixArray *sa, const char *str, size_t len, int suffixOnly,
+                              size_t *nterms, struct timespec *timeout, size_t *timeoutCounter) {
+  size_t begin = searchBound(sa, str, len, 0);
+  size_t end = searchBound(sa, str, len, 1);
+  uint32_t *terms = rm_malloc((end > begin ? end - begin : 1) * sizeof(*terms));
+  size_t n = 0;
+  for (size_t ii = begin; ii < end; ++ii) {
+    if (TimedOut_WithCounter(timeout, timeoutCounter)) {
+      rm_free(terms);
+      return NULL;
+    }
+    uint32_t off = sa->suffixes[ii];
+    if (suffixOnly && sa->text[off + len] != '\0') {
+      continue;
+    }
+    while (off && sa->text[off - 1] != '\0') {
+      off--;
+    }
+    terms[n++] = off;
+  }
+
+  // a term may hold the pattern more than once
+  qsort(terms, n, sizeof(*terms), cmpOffsets);
+  size_t uniq = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    if (!uniq || terms[uniq - 1] != terms[ii]) {
+      terms[uniq++] = terms[ii];
+    }
+  }
+  *nterms = uniq;
+  return terms;
+}
+
+int SuffixArray_IterateContains(const SuffixArray *sa, const char *str, size_t len, int suffixOnly,
+                                TrieSuffixCallback callback, void *ctx, struct timespec *timeout) {
+  if (len < SUFFIX_ARRAY_MIN_SUFFIX) {
+    return 0;
+  }
+  size_t n, timeoutCounter = timeout ? 0 : REDISEARCH_UNINITIALIZED;
+  uint32_t *terms = collectTerms(sa, str, len, suffixOnly, &n, timeout, &timeoutCounter);
+  if (!terms) {
+    return 1;
+  }
+  for (size_t ii = 0; ii < n; ++ii) {
+    const char *term = sa->text + terms[ii];
+    if (callback(term, strlen(term), ctx, NULL) == REDISEARCH_ERR ||
+        TimedOut_WithCounter(timeout, &timeoutCounter)) {
+      break;
+    }
+  }
+  rm_free(terms);
+  return 1;
+}
+
+int SuffixArray_IterateWildcard(const SuffixArray *sa, const char *pattern, size_t len,
+                                TrieSuffixCallback callback, void *ctx, struct timespec *timeout) {
+  // an escaped character is a literal, but the matcher has no escapes: '\*' and '\?' still
+  // match as wildcards there, so they end a literal run like unescaped ones do
+  char *pat = rm_strndup(pattern, len);
+  len = Wildcard_RemoveEscape(pat, len);
+
+  // find the longest run of literal characters
+  size_t best = 0, bestLen = 0;
+  for (size_t ii = 0; ii < len;) {
+    size_t jj = ii;
+    while (jj < len && pat[jj] != '*' && pat[jj] != '?') {
+      jj++;
+    }
+    if (jj - ii > bestLen) {
+      best = ii;
+      bestLen = jj - ii;
+    }
+    ii = jj + 1;
+  }
+  if (bestLen < SUFFIX_ARRAY_MIN_SUFFIX) {
+    rm_free(pat);
+    return 0;
+  }
+
+  // '?' stands for a character, which may be more than one byte: such patterns are matched as runes
+  runeBuf patBuf, termBuf;
+  size_t nrunes = 0;
+  rune *runes = memchr(pat, '?', len) ? runeBufFill(pat, len, &patBuf, &nrunes) : NULL;
+
+  size_t n, timeoutCounter = timeout ? 0 : REDISEARCH_UNINITIALIZED;
+  uint32_t *terms = collectTerms(sa, pat + best, bestLen, 0, &n, timeout, &timeoutCounter);
+  for (size_t ii = 0; terms && ii < n; ++ii) {
+    const char *term = sa->text + terms[ii];
+    size_t tlen = strlen(term);
+    int match;
+    if (runes) {
+      size_t tnrunes;
+      rune *trunes = runeBufFill(term, tlen, &termBuf, &tnrunes);
+      match = Wildcard_MatchRune(runes, nrunes, trunes, tnrunes) == FULL_MATCH;
+      runeBufFree(&termBuf);
+    } else {
+      match = Wildcard_MatchChar(pat, len, term, tlen) == FULL_MATCH;
+    }
+    if ((match && callback(term, tlen, ctx, NULL) == REDISEARCH_ERR) ||
+        TimedOut_WithCounter(timeout, &timeoutCounter)) {
+      break;
+    }
+  }
+  if (runes) {
+    runeBufFree(&patBuf);
+  }
+  rm_free(terms);
+  rm_free(pat);
+  return 1;
+}
@@ -0,0 +1,59 @@
+#ifndef __SUFFIX_ARRAY_H__
+#define __SUFFIX_ARRAY_H__
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "terms_snapshot.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * SuffixArray is a compact alternative to the suffix trie for contains, suffix and wildcard
+ * queries over the terms of an index.
+ *
+ * The terms of a TermsSnapshot are laid out in order in one NUL separated buffer, and the array
+ * holds the offset of every suffix (starting at a character boundary and at least
+ * SUFFIX_ARRAY_MIN_SUFFIX bytes long) sorted lexicographically. All the suffixes starting with a
+ * pattern are then a contiguous range of the array, found by binary search, and the term holding
+ * a suffix is found by walking back to the previous separator.
+ *
+ * Like the snapshot it is built from, the array is immutable and rebuilt by the GC.
+ */
+
+// The shortest suffix kept in the array, same as the suffix trie's MIN_SUFFIX
+#define SUFFIX_ARRAY_MIN_SUFFIX 2
+
+typedef struct {
+  char *text;          // the terms in lexicographic order, each followed by a NUL
+  size_t textLen;
+  uint32_t *suffixes;  // offsets in text of the suffixes, in lexicographic order
+  size_t numSuffixes;
+} SuffixArray;
+
+/* Build the suffix array of all the terms in a snapshot */
+SuffixArray *NewSuffixArray(const TermsSnapshot *s);
+
+void SuffixArray_Free(SuffixArray *sa);
+
+size_t SuffixArray_MemUsage(const SuffixArray *sa);
+
+/* Call the callback once for every term containing str, or only ending with it if suffixOnly is
+ * set. Iteration stops if the callback returns REDISEARCH_ERR or the timeout, if not NULL, is
+ * reached. Returns 0 if str is too short to be looked up in the array, 1 otherwise */
+int SuffixArray_IterateContains(const SuffixArray *sa, const char *str, size_t len, int suffixOnly,
+                                TrieSuffixCallback callback, void *ctx, struct timespec *timeout);
+
+/* Call the callback for every term matching the wildcard pattern, using its longest literal part
+ * to look up candidates. A '\' escapes the next character. Returns 0 if the pattern has no literal
+ * part long enough to be looked up, in which case the caller should scan the terms instead */
+int SuffixArray_IterateWildcard(const SuffixArray *sa, const char *pattern, size_t len,
+                                TrieSuffixCallback callback, void *ctx, struct timespec *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,308 @@
+#include "terms_snapshot.h"
+#include "rune_util.h"
+#include "redisearch.h"
+#include "rmalloc.h"
+
+#include <string.h>
+#include <sys/param.h>
+
+typedef struct {
+  char *str;
+  size_t len;
+} snapTerm;
+
+static inline int cmpBytes(const char *s1, size_t n1, const char *s2, size_t n2) {
+  int rc = memcmp(s1, s2, MIN(n1, n2));
+  if (rc) {
+    return rc;
+  }
+  return (n1 > n2) - (n1 < n2);
+}
+
+static int cmpSnapTerms(const void *p1, const void *p2) {
+  const snapTerm *t1 = p1, *t2 = p2;
+  return cmpBytes(t1->str, t1->len, t2->str, t2->len);
+}
+
+static inline size_t putVarint(char *p, size_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    p[n++] = (char)(v | 0x80);
+    v >>= 7;
+  }
+  p[n++] = (char)v;
+  return n;
+}
+
+static inline const char *getVarint(const char *p, size_t *v) {
+  size_t val = 0;
+  int shift = 0;
+  unsigned char c;
+  do {
+    c = *p++;
+    val |= (size_t)(c & 0x7f) << shift;
+    shift += 7;
+  } while (c & 0x80);
+  *v = val;
+  return p;
+}
+
+TermsSnapshot *NewTermsSnapshot(Trie *t) {
+  size_t cap = t->size ? t->size : 1, n = 0, totalLen = 0, maxLen = 0;
+  snapTerm *terms = rm_malloc(cap * sizeof(*terms));
+  int sorted = 1;
+
+  TrieIterator *it = Trie_Iterate(t, "", 0, 0, 1);
+  rune *rstr = NULL;
+  t_len slen = 0;
+  float score = 0;
+  int dist = 0;
+  while (it && TrieIterator_Next(it, &rstr, &slen, NULL, &score, &dist)) {
+    if (n == cap) {
+      cap *= 2;
+      terms = rm_realloc(terms, cap * sizeof(*terms));
+    }
+    snapTerm *cur = terms + n;
+    cur->str = runesToStr(rstr, slen, &cur->len);
+    if (n && sorted && cmpSnapTerms(cur - 1, cur) > 0) {
+      sorted = 0;
+    }
+    totalLen += cur->len;
+    maxLen = MAX(maxLen, cur->len);
+    n++;
+  }
+  if (it) {
+    TrieIterator_Free(it);
+  }
+
+  // The Trie yields terms in rune order, which is also UTF-8 byte order, so this is only a
+  // safety net
+  if (!sorted) {
+    qsort(terms, n, sizeof(*terms), cmpSnapTerms);
+  }
+
+  TermsSnapshot *s = rm_calloc(1, sizeof(*s));
+  s->numTerms = n;
+  s->maxTermLen = maxLen;
+  s->numRestarts = (n + TERMS_SNAPSHOT_RESTART - 1) / TERMS_SNAPSHOT_RESTART;
+  s->restarts = rm_malloc(MAX(s->numRestarts, 1) * sizeof(*s->restarts));
+  // every entry has two varints of at most 10 bytes each
+  s->data = rm_malloc(totalLen + n * 20 + 1);
+
+  size_t off = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    size_t shared = 0;
+    if (ii % TERMS_SNAPSHOT_RESTART == 0) {
+      s->restarts[ii / TERMS_SNAPSHOT_RESTART] = off;
+    } else {
+      const snapTerm *prev = terms + ii - 1;
+      size_t lim = MIN(prev->len, terms[ii].len);
+      while (shared < lim && prev->str[shared] == terms[ii].str[shared]) {
+        shared++;
+      }
+    }
+    off += putVarint(s->data + off, shared);
+    off += putVarint(s->data + off, terms[ii].len - shared);
+    memcpy(s->data + off, terms[ii].str + shared, terms[ii].len - shared);
+    off += terms[ii].len - shared;
+  }
+  for (size_t ii = 0; ii < n; ++ii) {
+    rm_free(terms[ii].str);
+  }
+  rm_free(terms);
+
+  s->dataLen = off;
+  s->data = rm_realloc(s->data, MAX(off, 1));
+  return s;
+}
+
+void TermsSnapshot_Free(TermsSnapshot *s) {
+  rm_free(s->data);
+  rm_free(s->restarts);
+  rm_free(s);
+}
+
+size_t TermsSnapshot_MemUsage(const TermsSnapshot *s) {
+  return sizeof(*s) + s->dataLen + s->numRestarts * sizeof(*s->restarts);
+}
+
+/* A cursor decoding the entries in order into a buffer holding the current term */
+typedef struct {
+  const TermsSnapshot *s;
+  const char *p;
+  size_t idx;
+  char *buf;
+  size_t len;
+  size_t shared;  // bytes the current term shares with the previous entry
+} snapCursor;
+
+static void cursorInit(snapCursor *c, const TermsSnapshot *s, size_t restart) {
+  c->s = s;
+  c->p = s->data + s->restarts[restart];
+  c->idx = restart * TERMS_SNAPSHOT_RESTART;
+  c->buf = rm_malloc(s->maxTermLen + 1);
+  c->len = 0;
+  c->shared = 0;
+}
+
+static inline int cursorNext(snapCursor *c) {
+  if (c->idx == c->s->numTerms) {
+    return 0;
+  }
+  size_t shared, suffix;
+  c->p = getVarint(c->p, &shared);
+  c->p = getVarint(c->p, &suffix);
+  memcpy(c->buf + shared, c->p, suffix);
+  c->p += suffix;
+  c->len = shared + suffix;
+  c->buf[c->len] = '\0';
+  c->shared = shared;
+  c->idx++;
+  return 1;
+}
+
+static void cursorFree(snapCursor *c) {
+  rm_free(c->buf);
+}
+
+/* Find the last restart point whose term sorts before str (or is equal to it, if inclusive).
+ * Returns 0 if there is none, since scanning then starts from the first term anyway */
+static size_t findRestart(const TermsSnapshot *s, const char *str, size_t len, int inclusive) {
+  size_t lo = 0, hi = s->numRestarts;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    size_t shared, headLen;
+    const char *p = getVarint(s->data + s->restarts[mid], &shared);
+    p = getVarint(p, &headLen);
+    int rc = cmpBytes(p, headLen, str, len);
+    if (rc < 0 || (inclusive && rc == 0)) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+int TermsSnapshot_Contains(const TermsSnapshot *s, const char *str, size_t len) {
+  if (!s->numTerms || len > s->maxTermLen) {
+    return 0;
+  }
+  snapCursor c;
+  cursorInit(&c, s, findRestart(s, str, len, 1));
+  int found = 0;
+  for (size_t ii = 0; ii < TERMS_SNAPSHOT_RESTART && cursorNext(&c); ++ii) {
+    int rc = cmpBytes(c.buf, c.len, str, len);
+    if (rc >= 0) {
+      found = rc == 0;
+      break;
+    }
+  }
+  cursorFree(&c);
+  return found;
+}
+
+void TermsSnapshot_IteratePrefix(const TermsSnapshot *s, const char *prefix, size_t len,
+                                 TrieSuffixCallback callback, void *ctx) {
+  if (!s->numTerms || len > s->maxTermLen) {
+    return;
+  }
+  snapCursor c;
+  cursorInit(&c, s, findRestart(s, prefix, len, 0));
+  while (cursorNext(&c)) {
+    if (c.len >= len && !memcmp(c.buf, prefix, len)) {
+      if (callback(c.buf, c.len, ctx, NULL) == REDISEARCH_ERR) {
+        break;
+      }
+    } else if (cmpBytes(c.buf, c.len, prefix, len) > 0) {
+      // past the range of terms starting with the prefix
+      break;
+    }
+  }
+  cursorFree(&c);
+}
+
+void TermsSnapshot_IterateFuzzy(const TermsSnapshot *s, const rune *str, size_t len, int maxDist,
+                                TrieSuffixCallback callback, void *ctx) {
+  if (!s->numTerms) {
+    return;
+  }
+  // A term has at most as many runes as bytes. rows[i] holds the Levenshtein row of the first i
+  // runes of the current term against str
+  size_t cols = len + 1, maxRunes = s->maxTermLen;
+  int *rows = rm_malloc((maxRunes + 1) * cols * sizeof(*rows));
+  rune *runes = rm_malloc((maxRunes + 1) * sizeof(*runes));
+  rune *next = rm_malloc((maxRunes + 1) * sizeof(*next));
+  size_t *offsets = rm_malloc((maxRunes + 1) * sizeof(*offsets));
+  for (size_t jj = 0; jj < cols; ++jj) {
+    rows[jj] = jj;
+  }
+
+  size_t validRows = 0;  // rows[1..validRows] are computed for runes[0..validRows-1]
+  size_t deadBytes = 0;  // a byte prefix that can no longer match, if not 0
+
+  snapCursor c;
+  cursorInit(&c, s, 0);
+  while (cursorNext(&c)) {
+    // the previous term started with the dead prefix, so does this one if it shares enough
+    if (deadBytes) {
+      if (c.shared >= deadBytes) {
+        continue;
+      }
+      deadBytes = 0;
+    }
+
+    size_t n = 0;
+    const char *p = c.buf, *end = c.buf + c.len;
+    while (p < end) {
+      uint32_t cp;
+      p = nu_utf8_read(p, &cp);
+      next[n] = (rune)cp;
+      offsets[n++] = p - c.buf;
+    }
+
+    // rows up to the first rune that differs from the previous term can be reused
+    size_t lcp = 0, lim = MIN(n, validRows);
+    while (lcp < lim && next[lcp] == runes[lcp]) {
+      lcp++;
+    }
+    rune *tmp = runes;
+    runes = next;
+    next = tmp;
+
+    size_t ii;
+    for (ii = lcp; ii < n; ++ii) {
+      const int *prev = rows + ii * cols;
+      int *row = rows + (ii + 1) * cols;
+      int rowMin = row[0] = ii + 1;
+      for (size_t jj = 1; jj < cols; ++jj) {
+        int v = prev[jj - 1] + (str[jj - 1] != runes[ii]);
+        v = MIN(v, prev[jj] + 1);
+        v = MIN(v, row[jj - 1] + 1);
+        row[jj] = v;
+        rowMin = MIN(rowMin, v);
+      }
+      if (rowMin > maxDist) {
+        break;
+      }
+    }
+    if (ii < n) {
+      validRows = ii + 1;
+      deadBytes = offsets[ii];
+      continue;
+    }
+    validRows = n;
+
+    if (rows[n * cols + len] <= maxDist) {
+      if (callback(c.buf, c.len, ctx, NULL) == REDISEARCH_ERR) {
+        break;
+      }
+    }
+  }
+
+  cursorFree(&c);
+  rm_free(rows);
+  rm_free(runes);
+  rm_free(next);
+  rm_free(offsets);
+}
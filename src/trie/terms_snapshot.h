@@ -0,0 +1,63 @@
+#ifndef __TERMS_SNAPSHOT_H__
+#define __TERMS_SNAPSHOT_H__
+
+#include <stdlib.h>
+
+#include "trie_type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * TermsSnapshot is a frozen, read-optimized copy of a terms Trie.
+ *
+ * The terms are kept as sorted UTF-8 strings in a single contiguous buffer, front coded against
+ * their predecessor: each entry stores the number of bytes it shares with the previous term,
+ * followed by the remaining suffix. Every TERMS_SNAPSHOT_RESTART-th entry is stored in full and
+ * its offset is kept in a restart table, so prefix lookups binary search the restart points and
+ * then scan forward.
+ *
+ * Fuzzy expansion walks the terms in order and keeps one Levenshtein row per character of the
+ * current term, so rows are only recomputed past the prefix shared with the previous term, and a
+ * prefix that can no longer match lets the scan skip all of its terms without decoding them.
+ *
+ * The snapshot is immutable; new terms are expected to be kept in a small side Trie until the
+ * snapshot is rebuilt by the GC (see IndexSpec_PrepareTermsSnapshot).
+ */
+
+#define TERMS_SNAPSHOT_RESTART 16
+
+typedef struct {
+  char *data;          // front coded entries
+  size_t dataLen;
+  uint32_t *restarts;  // offsets in data of the fully stored entries
+  size_t numRestarts;
+  size_t numTerms;
+  size_t maxTermLen;   // the longest term, in bytes
+} TermsSnapshot;
+
+/* Build a snapshot of all the terms in a Trie */
+TermsSnapshot *NewTermsSnapshot(Trie *t);
+
+void TermsSnapshot_Free(TermsSnapshot *s);
+
+size_t TermsSnapshot_MemUsage(const TermsSnapshot *s);
+
+/* Returns 1 if the exact term is in the snapshot */
+int TermsSnapshot_Contains(const TermsSnapshot *s, const char *str, size_t len);
+
+/* Call the callback for every term starting with prefix, in lexicographic order. Iteration stops
+ * if the callback returns REDISEARCH_ERR */
+void TermsSnapshot_IteratePrefix(const TermsSnapshot *s, const char *prefix, size_t len,
+                                 TrieSuffixCallback callback, void *ctx);
+
+/* Call the callback for every term within maxDist Levenshtein distance from str. Iteration stops
+ * if the callback returns REDISEARCH_ERR */
+void TermsSnapshot_IterateFuzzy(const TermsSnapshot *s, const rune *str, size_t len, int maxDist,
+                                TrieSuffixCallback callback, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -44,11 +44,10 @@ typedef struct {
 
 static void __trieNode_sortChildren(TrieNode *n);
 
+// maxChildScore is kept in both sort modes, so lexicographic tries can be searched by score too
 #define updateScore(n, value)                             \
 do {                                                      \
-  if (n->sortMode == Trie_Sort_Score) {                   \
-    n->maxChildScore = MAX(n->maxChildScore, value);      \
-  }                                                       \
+  n->maxChildScore = MAX(n->maxChildScore, value);        \
 } while(0)
 
 size_t __trieNode_Sizeof(t_len numChildren, t_len slen) {
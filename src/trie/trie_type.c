@@ -6,8 +6,10 @@
 #include "util/misc.h"
 #include "rune_util.h"
 #include "trie_type.h"
+#include "search_cache.h"
 #include "rmalloc.h"
 #include "rdb.h"
+#include "util/timeout.h"
 
 #include <math.h>
 #include <sys/param.h>
@@ -22,6 +24,7 @@ Trie *NewTrie(TrieFreeCallback freecb, TrieSortMode sortMode) {
   tree->size = 0;
   tree->freecb = freecb;
   tree->sortMode = sortMode;
+  tree->searchCache = NULL;
   rm_free(rs);
   return tree;
 }
@@ -51,6 +54,15 @@ int Trie_InsertRune(Trie *t, const rune *runes, size_t len, double score, int in
   if (runes && len && len < TRIE_INITIAL_STRING_LEN) {
     rc = TrieNode_Add(&t->root, runes, len, payload, (float)score, incr ? ADD_INCR : ADD_REPLACE, t->freecb);
     t->size += rc;
+    if (t->searchCache) {
+      // the cached results need the entry's resulting score and payload
+      TrieNode *n = TrieNode_Get(t->root, runes, len, 1, NULL);
+      if (n) {
+        TrieSearchCache_OnInsert(t->searchCache, runes, len, n->score,
+                                 n->payload ? n->payload->data : NULL,
+                                 n->payload ? n->payload->len : 0);
+      }
+    }
   }
   return rc;
 }
@@ -84,9 +96,18 @@ int Trie_Delete(Trie *t, const char *s, size_t len) {
 int Trie_DeleteRunes(Trie *t, const rune *runes, size_t len) {
   int rc = TrieNode_Delete(t->root, runes, len, t->freecb);
   t->size -= rc;
+  if (rc && t->searchCache) {
+    TrieSearchCache_OnDelete(t->searchCache, runes, len);
+  }
   return rc;
 }
 
+void Trie_EnableSearchCache(Trie *t) {
+  if (!t->searchCache) {
+    t->searchCache = NewTrieSearchCache();
+  }
+}
+
 void TrieSearchResult_Free(TrieSearchResult *e) {
   if (e->str) {
     rm_free(e->str);
@@ -125,6 +146,21 @@ TrieIterator *Trie_Iterate(Trie *t, const char *prefix, size_t len, int maxDist,
   return it;
 }
 
+float Trie_SearchScore(const rune *query, size_t rlen, size_t len, const rune *str, t_len slen,
+                       float score, int maxDist, int dist, int prefixMode) {
+  float ret = slen > 0 && slen == rlen && memcmp(query, str, slen) == 0 ? (float)INT_MAX : score;
+
+  if (maxDist > 0) {
+    // factor the distance into the score
+    ret *= exp((double)-(2 * dist));
+  }
+  // in prefix mode we also factor in the total length of the suffix
+  if (prefixMode) {
+    ret /= sqrt(1 + (slen >= len ? slen - len : len - slen));
+  }
+  return ret;
+}
+
 Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDist, int prefixMode,
                     int trim, int optimize) {
 
@@ -139,6 +175,14 @@ Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDi
     return NULL;
   }
 
+  if (tree->searchCache) {
+    Vector *cached = TrieSearchCache_Get(tree->searchCache, s, len, num, maxDist, prefixMode, trim);
+    if (cached) {
+      rm_free(runes);
+      return cached;
+    }
+  }
+
   heap_t *pq = rm_malloc(heap_sizeof(num));
   heap_init(pq, cmpEntries, NULL, num);
 
@@ -162,16 +206,7 @@ Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDi
     }
     TrieSearchResult *ent = pooledEntry;
 
-    ent->score = slen > 0 && slen == rlen && memcmp(runes, rstr, slen) == 0 ? (float)INT_MAX : score;
-
-    if (maxDist > 0) {
-      // factor the distance into the score
-      ent->score *= exp((double)-(2 * dist));
-    }
-    // in prefix mode we also factor in the total length of the suffix
-    if (prefixMode) {
-      ent->score /= sqrt(1 + (slen >= len ? slen - len : len - slen));
-    }
+    ent->score = Trie_SearchScore(runes, rlen, len, rstr, slen, score, maxDist, dist, prefixMode);
 
     if (heap_count(pq) < heap_size(pq)) {
       ent->str = runesToStr(rstr, slen, &ent->len);
@@ -249,6 +284,10 @@ Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDi
     }
   }
 
+  if (tree->searchCache) {
+    TrieSearchCache_Put(tree->searchCache, s, len, runes, rlen, num, maxDist, prefixMode, trim, ret);
+  }
+
   rm_free(runes);
   TrieIterator_Free(it);
   heap_free(pq);
@@ -256,6 +295,80 @@ Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDi
   return ret;
 }
 
+typedef struct {
+  rune *str;
+  t_len len;
+  float score;
+} topPrefixEntry;
+
+static int cmpTopPrefixEntries(const void *p1, const void *p2, const void *udata) {
+  const topPrefixEntry *e1 = p1, *e2 = p2;
+  return (e1->score < e2->score) - (e1->score > e2->score);
+}
+
+void Trie_IterateTopPrefix(Trie *t, const rune *prefix, size_t len, size_t num,
+                           TrieRangeCallback callback, void *ctx, struct timespec *timeout) {
+  if (!num || len >= TRIE_MAX_PREFIX) {
+    return;
+  }
+  struct timespec deadline = timeout ? *timeout : (struct timespec){0};
+  size_t timeoutCounter = timeout ? 0 : REDISEARCH_UNINITIALIZED;
+
+  heap_t *pq = rm_malloc(heap_sizeof(num));
+  heap_init(pq, cmpTopPrefixEntries, NULL, num);
+
+  DFAFilter *fc = NewDFAFilter((rune *)prefix, len, 0, 1);
+  TrieIterator *it = TrieNode_Iterate(t->root, FilterFunc, StackPop, fc);
+  rune *rstr;
+  t_len slen;
+  float score;
+  int dist;
+  while (TrieIterator_Next(it, &rstr, &slen, NULL, &score, &dist)) {
+    // on timeout, the entries collected so far are passed on
+    if (TimedOut_WithCounter(&deadline, &timeoutCounter)) {
+      break;
+    }
+    topPrefixEntry *ent;
+    if (heap_count(pq) < heap_size(pq)) {
+      ent = rm_malloc(sizeof(*ent));
+    } else if (score > it->minScore) {
+      ent = heap_poll(pq);
+      rm_free(ent->str);
+    } else {
+      continue;
+    }
+    ent->str = rm_malloc(slen * sizeof(rune));
+    memcpy(ent->str, rstr, slen * sizeof(rune));
+    ent->len = slen;
+    ent->score = score;
+    heap_offerx(pq, ent);
+
+    // once the heap is full, skip the subtrees that cannot beat its lowest score
+    if (heap_count(pq) == heap_size(pq)) {
+      topPrefixEntry *min = heap_peek(pq);
+      it->minScore = min->score;
+    }
+  }
+  TrieIterator_Free(it);
+
+  size_t n = heap_count(pq);
+  topPrefixEntry **ents = rm_malloc(MAX(n, 1) * sizeof(*ents));
+  for (size_t ii = 0; ii < n; ++ii) {
+    ents[n - ii - 1] = heap_poll(pq);
+  }
+  heap_free(pq);
+
+  int stop = 0;
+  for (size_t ii = 0; ii < n; ++ii) {
+    if (!stop && callback(ents[ii]->str, ents[ii]->len, ctx, NULL) == REDISEARCH_ERR) {
+      stop = 1;
+    }
+    rm_free(ents[ii]->str);
+    rm_free(ents[ii]);
+  }
+  rm_free(ents);
+}
+
 int Trie_RandomKey(Trie *t, char **str, t_len *len, double *score) {
   if (t->size == 0) {
     return 0;
@@ -292,7 +405,11 @@ void *TrieType_RdbLoad(RedisModuleIO *rdb, int encver) {
   if (encver > TRIE_ENCVER_CURRENT) {
     return NULL;
   }
-  return TrieType_GenericLoad(rdb, encver > TRIE_ENCVER_NOPAYLOADS);
+  Trie *tree = TrieType_GenericLoad(rdb, encver > TRIE_ENCVER_NOPAYLOADS);
+  if (tree) {
+    Trie_EnableSearchCache(tree);
+  }
+  return tree;
 }
 
 void *TrieType_GenericLoad(RedisModuleIO *rdb, int loadPayloads) {
@@ -381,6 +498,9 @@ void TrieType_Free(void *value) {
   if (tree->root) {
     TrieNode_Free(tree->root, tree->freecb);
   }
+  if (tree->searchCache) {
+    TrieSearchCache_Free(tree->searchCache);
+  }
 
   rm_free(tree);
 }
@@ -390,7 +510,8 @@ size_t TrieType_MemUsage(const void *value) {
   return t->size * (sizeof(TrieNode) +    // size of struct
                     sizeof(TrieNode *) +  // size of ptr to struct in parent node
                     sizeof(rune) +        // rune key to children in parent node
-                    2 * sizeof(rune));    // each node contains some runes as str[]
+                    2 * sizeof(rune)) +   // each node contains some runes as str[]
+         (t->searchCache ? TrieSearchCache_MemUsage(t->searchCache) : 0);
 }
 
 int TrieType_Register(RedisModuleCtx *ctx) {
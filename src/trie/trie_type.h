@@ -15,11 +15,14 @@ extern RedisModuleType *TrieType;
 #define TRIE_ENCVER_CURRENT 1
 #define TRIE_ENCVER_NOPAYLOADS 0
 
+struct TrieSearchCache;
+
 typedef struct {
   TrieNode *root;
   size_t size;
   TrieFreeCallback freecb;
   TrieSortMode sortMode;
+  struct TrieSearchCache *searchCache;  // results of recent searches, if enabled
 } Trie;
 
 typedef struct {
@@ -52,7 +55,14 @@ void *Trie_GetValueRune(Trie *t, const rune *runes, size_t len, bool exact);
 int Trie_Delete(Trie *t, const char *s, size_t len);
 int Trie_DeleteRunes(Trie *t, const rune *runes, size_t len);
 
+/* Keep the results of recent searches on the trie, updating them as the trie changes */
+void Trie_EnableSearchCache(Trie *t);
+
 void TrieSearchResult_Free(TrieSearchResult *e);
+/* The score Trie_Search ranks an entry by, given its score in the trie and its distance from the
+ * (folded) search string */
+float Trie_SearchScore(const rune *query, size_t rlen, size_t len, const rune *str, t_len slen,
+                       float score, int maxDist, int dist, int prefixMode);
 Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDist, int prefixMode,
                     int trim, int optimize);
 
@@ -61,6 +71,14 @@ Vector *Trie_Search(Trie *tree, const char *s, size_t len, size_t num, int maxDi
  * Otherwise we return an iterator to all strings within maxDist Levenshtein distance */
 TrieIterator *Trie_Iterate(Trie *t, const char *prefix, size_t len, int maxDist, int prefixMode);
 
+/* Call the callback for the (at most) num entries starting with prefix that have the highest
+ * scores, highest first. When no more than num entries start with the prefix, all of them are
+ * passed. Subtrees whose maximal score cannot make it into the top entries are not visited.
+ * Iteration stops if the callback returns REDISEARCH_ERR. If timeout is given and reached, only the
+ * entries found so far are considered */
+void Trie_IterateTopPrefix(Trie *t, const rune *prefix, size_t len, size_t num,
+                           TrieRangeCallback callback, void *ctx, struct timespec *timeout);
+
 /* Get a random key from the trie, and put the node's score in the score pointer. Returns 0 if the
  * trie is empty and we cannot do that */
 int Trie_RandomKey(Trie *t, char **str, t_len *len, double *score);
@@ -1,6 +1,7 @@
 #include "block_alloc.h"
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include "rmalloc.h"
 
 static void freeCommon(BlkAlloc *blocks, BlkAllocCleaner cleaner, void *arg, size_t elemSize,
@@ -90,7 +91,7 @@ void *BlkAlloc_Alloc(BlkAlloc *blocks, size_t elemSize, size_t blockSize) {
   if (!blocks->root) {
     blocks->root = blocks->last = getNewBlock(blocks, blockSize);
 
-  } else if (blocks->last->numUsed + elemSize > blockSize) {
+  } else if (blocks->last->numUsed + elemSize > blocks->last->capacity) {
     // Allocate a new element
     BlkAllocBlock *newBlock = getNewBlock(blocks, blockSize);
     blocks->last->next = newBlock;
@@ -107,3 +108,10 @@ void *BlkAlloc_Alloc(BlkAlloc *blocks, size_t elemSize, size_t blockSize) {
   blocks->last->numUsed += elemSize;
   return p;
 }
+
+char *BlkAlloc_Strndup(BlkAlloc *blocks, const char *s, size_t n, size_t minBlockSize) {
+  char *dst = BlkAlloc_Alloc(blocks, n + 1, n + 1 > minBlockSize ? n + 1 : minBlockSize);
+  memcpy(dst, s, n);
+  dst[n] = '\0';
+  return dst;
+}
@@ -39,6 +39,12 @@ static inline void BlkAlloc_Init(BlkAlloc *alloc) {
  */
 void *BlkAlloc_Alloc(BlkAlloc *alloc, size_t elemSize, size_t blockSize);
 
+/**
+ * Copy a string into the allocator, adding a terminating NUL. Blocks are at least
+ * minBlockSize bytes, larger strings get a block of their own.
+ */
+char *BlkAlloc_Strndup(BlkAlloc *alloc, const char *s, size_t n, size_t minBlockSize);
+
 typedef void (*BlkAllocCleaner)(void *ptr, void *arg);
 
 /**
@@ -0,0 +1,70 @@
+#include "dist_heap.h"
+#include "rmalloc.h"
+
+#include <math.h>
+
+#define DIST_HEAP_INITIAL_CAP 64
+
+void DistHeap_Init(DistHeap *h, size_t k) {
+  h->entries = NULL;
+  h->size = 0;
+  h->cap = 0;
+  h->k = k;
+}
+
+void DistHeap_Free(DistHeap *h) {
+  rm_free(h->entries);
+  DistHeap_Init(h, h->k);
+}
+
+double DistHeap_Bound(const DistHeap *h) {
+  if (h->size < h->k) {
+    return INFINITY;
+  }
+  return h->size ? h->entries[0].distance : -INFINITY;
+}
+
+static void siftDown(DistHeapEntry *e, size_t n, size_t i) {
+  for (;;) {
+    size_t l = 2 * i + 1, r = l + 1, top = i;
+    if (l < n && e[l].distance > e[top].distance) top = l;
+    if (r < n && e[r].distance > e[top].distance) top = r;
+    if (top == i) return;
+    DistHeapEntry tmp = e[i];
+    e[i] = e[top];
+    e[top] = tmp;
+    i = top;
+  }
+}
+
+int DistHeap_Offer(DistHeap *h, uint64_t id, double distance) {
+  if (h->size < h->k) {
+    if (h->size == h->cap) {
+      h->cap = h->cap ? h->cap * 2 : DIST_HEAP_INITIAL_CAP;
+      if (h->cap > h->k) h->cap = h->k;
+      h->entries = rm_realloc(h->entries, h->cap * sizeof(*h->entries));
+    }
+    size_t i = h->size++;
+    while (i > 0 && h->entries[(i - 1) / 2].distance < distance) {
+      h->entries[i] = h->entries[(i - 1) / 2];
+      i = (i - 1) / 2;
+    }
+    h->entries[i] = (DistHeapEntry){.distance = distance, .id = id};
+    return 1;
+  }
+  if (h->size && distance < h->entries[0].distance) {
+    h->entries[0] = (DistHeapEntry){.distance = distance, .id = id};
+    siftDown(h->entries, h->size, 0);
+    return 1;
+  }
+  return 0;
+}
+
+static int cmpById(const void *p1, const void *p2) {
+  const DistHeapEntry *e1 = p1, *e2 = p2;
+  return e1->id < e2->id ? -1 : e1->id > e2->id;
+}
+
+void DistHeap_SortById(DistHeap *h) {
+  qsort(h->entries, h->size, sizeof(*h->entries), cmpById);
+}
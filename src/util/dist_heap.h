@@ -0,0 +1,50 @@
+#ifndef RS_DIST_HEAP_H_
+#define RS_DIST_HEAP_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// DistHeap - keeps the k entries with the smallest distance out of a stream of (distance, id)
+// pairs.
+//
+// Entries are plain structs stored inline in a max heap, so the root is the farthest of the k
+// kept ones and offering a worse entry is a single comparison. The storage grows on demand up
+// to k entries, so a large k that is never reached costs nothing.
+
+typedef struct {
+  double distance;
+  uint64_t id;
+} DistHeapEntry;
+
+typedef struct {
+  DistHeapEntry *entries;
+  size_t size;
+  size_t cap;
+  size_t k;
+} DistHeap;
+
+void DistHeap_Init(DistHeap *h, size_t k);
+void DistHeap_Free(DistHeap *h);
+
+/* Drop all the entries, keeping the storage */
+static inline void DistHeap_Clear(DistHeap *h) {
+  h->size = 0;
+}
+
+/* The distance an entry must be below to be kept, or INFINITY while the heap is not full */
+double DistHeap_Bound(const DistHeap *h);
+
+/* Offer an entry. Returns 1 if it was kept, 0 if it is not among the k nearest */
+int DistHeap_Offer(DistHeap *h, uint64_t id, double distance);
+
+/* Sort the entries by ascending id. The heap must be cleared before offering again */
+void DistHeap_SortById(DistHeap *h);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
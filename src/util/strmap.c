@@ -0,0 +1,143 @@
+#include "strmap.h"
+#include "fnv.h"
+#include "rmalloc.h"
+
+#include <string.h>
+
+#define STRMAP_INITIAL_CAP 8
+
+// Grow when the table is 3/4 full
+#define STRMAP_SHOULD_GROW(m) ((m)->size + 1 > ((m)->cap >> 1) + ((m)->cap >> 2))
+
+static inline uint32_t strmapHash(const char *s, size_t len) {
+  return rs_fnv_32a_buf(s, len, 0);
+}
+
+void StrMap_Init(StrMap *m) {
+  m->entries = NULL;
+  m->cap = 0;
+  m->size = 0;
+}
+
+void StrMap_Free(StrMap *m, void (*freeCB)(void *)) {
+  for (uint32_t ii = 0; ii < m->cap; ++ii) {
+    StrMapEntry *e = m->entries + ii;
+    if (!e->key) continue;
+    if (freeCB) {
+      freeCB(e->value);
+    }
+    rm_free(e->key);
+  }
+  rm_free(m->entries);
+  StrMap_Init(m);
+}
+
+static StrMapEntry *strmapLookup(const StrMap *m, const char *s, size_t len, uint32_t hash) {
+  if (!m->size) {
+    return NULL;
+  }
+  uint32_t mask = m->cap - 1;
+  for (uint32_t pos = hash & mask;; pos = (pos + 1) & mask) {
+    StrMapEntry *e = m->entries + pos;
+    if (!e->key) {
+      return NULL;
+    }
+    if (e->hash == hash && e->len == len && !memcmp(e->key, s, len)) {
+      return e;
+    }
+  }
+}
+
+// Place an entry we know is not in the table yet
+static void strmapPlace(StrMapEntry *entries, uint32_t cap, const StrMapEntry *src) {
+  uint32_t mask = cap - 1;
+  uint32_t pos = src->hash & mask;
+  while (entries[pos].key) {
+    pos = (pos + 1) & mask;
+  }
+  entries[pos] = *src;
+}
+
+static void strmapResize(StrMap *m, uint32_t newCap) {
+  StrMapEntry *entries = rm_calloc(newCap, sizeof(*entries));
+  for (uint32_t ii = 0; ii < m->cap; ++ii) {
+    if (m->entries[ii].key) {
+      strmapPlace(entries, newCap, m->entries + ii);
+    }
+  }
+  rm_free(m->entries);
+  m->entries = entries;
+  m->cap = newCap;
+}
+
+StrMapEntry *StrMap_FindEntry(const StrMap *m, const char *s, size_t len) {
+  return strmapLookup(m, s, len, strmapHash(s, len));
+}
+
+void *StrMap_Find(const StrMap *m, const char *s, size_t len) {
+  StrMapEntry *e = StrMap_FindEntry(m, s, len);
+  return e ? e->value : NULL;
+}
+
+int StrMap_Add(StrMap *m, const char *s, size_t len, void *value) {
+  uint32_t hash = strmapHash(s, len);
+  if (strmapLookup(m, s, len, hash)) {
+    return 0;
+  }
+  if (!m->cap) {
+    strmapResize(m, STRMAP_INITIAL_CAP);
+  } else if (STRMAP_SHOULD_GROW(m)) {
+    strmapResize(m, m->cap << 1);
+  }
+
+  StrMapEntry e = {.key = rm_malloc(len + 1), .len = len, .hash = hash, .value = value};
+  memcpy(e.key, s, len);
+  e.key[len] = '\0';
+  strmapPlace(m->entries, m->cap, &e);
+  m->size++;
+  return 1;
+}
+
+void *StrMap_Delete(StrMap *m, const char *s, size_t len) {
+  StrMapEntry *e = StrMap_FindEntry(m, s, len);
+  if (!e) {
+    return NULL;
+  }
+  void *value = e->value;
+  rm_free(e->key);
+
+  // Backward-shift deletion: pull back any following entry of the cluster whose home slot
+  // is not between the hole and its current position, so no probe chain is broken.
+  uint32_t mask = m->cap - 1;
+  uint32_t hole = e - m->entries;
+  for (uint32_t pos = (hole + 1) & mask; m->entries[pos].key; pos = (pos + 1) & mask) {
+    uint32_t home = m->entries[pos].hash & mask;
+    if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+      m->entries[hole] = m->entries[pos];
+      hole = pos;
+    }
+  }
+  memset(m->entries + hole, 0, sizeof(*m->entries));
+  m->size--;
+  return value;
+}
+
+size_t StrMap_MemUsage(const StrMap *m) {
+  size_t sz = sizeof(*m) + m->cap * sizeof(*m->entries);
+  for (uint32_t ii = 0; ii < m->cap; ++ii) {
+    if (m->entries[ii].key) {
+      sz += m->entries[ii].len + 1;
+    }
+  }
+  return sz;
+}
+
+StrMapEntry *StrMapIterator_Next(StrMapIterator *it) {
+  while (it->pos < it->m->cap) {
+    StrMapEntry *e = it->m->entries + it->pos++;
+    if (e->key) {
+      return e;
+    }
+  }
+  return NULL;
+}
@@ -0,0 +1,75 @@
+#ifndef RS_STRMAP_H_
+#define RS_STRMAP_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// StrMap - a compact string keyed hash map using open addressing with linear probing.
+//
+// Keys are copied into the map (and are always NUL terminated), values are opaque pointers
+// owned by the caller. Deletion uses backward-shift, so the table never holds tombstones
+// and lookups stay short even under heavy add/delete churn.
+//
+// Unlike a trie, the map keeps no ordering; callers that need sorted or prefix access should
+// maintain a side structure.
+
+typedef struct {
+  char *key;       // NULL marks an empty slot
+  uint32_t len;
+  uint32_t hash;
+  void *value;
+} StrMapEntry;
+
+typedef struct {
+  StrMapEntry *entries;
+  uint32_t cap;    // always a power of 2, or 0 before the first insertion
+  uint32_t size;
+} StrMap;
+
+/* Initialize an empty map. No memory is allocated until the first insertion */
+void StrMap_Init(StrMap *m);
+
+/* Free the map's storage, calling freeCB (if not NULL) on every value */
+void StrMap_Free(StrMap *m, void (*freeCB)(void *));
+
+/* Find the value stored for a key. Returns NULL if the key is not in the map */
+void *StrMap_Find(const StrMap *m, const char *s, size_t len);
+
+/* Find the entry stored for a key. Returns NULL if the key is not in the map. The entry is
+ * only valid until the next modification of the map */
+StrMapEntry *StrMap_FindEntry(const StrMap *m, const char *s, size_t len);
+
+/* Add a key to the map. If the key already exists its value is left untouched and 0 is
+ * returned, otherwise the key is copied, the value is stored and 1 is returned */
+int StrMap_Add(StrMap *m, const char *s, size_t len, void *value);
+
+/* Remove a key from the map, returning its value, or NULL if the key was not found */
+void *StrMap_Delete(StrMap *m, const char *s, size_t len);
+
+/* The number of bytes used by the map itself, including the key copies */
+size_t StrMap_MemUsage(const StrMap *m);
+
+typedef struct {
+  const StrMap *m;
+  uint32_t pos;
+} StrMapIterator;
+
+static inline StrMapIterator StrMap_Iterate(const StrMap *m) {
+  StrMapIterator it;
+  it.m = m;
+  it.pos = 0;
+  return it;
+}
+
+/* Advance the iterator, returning the next entry or NULL when done. The iteration order is
+ * arbitrary, and the map must not be modified while iterating */
+StrMapEntry *StrMapIterator_Next(StrMapIterator *it);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
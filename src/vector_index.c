@@ -2,6 +2,8 @@
 #include "hybrid_reader.h"
 #include "query_param.h"
 #include "rdb.h"
+#include "util/dist_heap.h"
+#include "index.h"
 
 static VecSimIndex *openVectorKeysDict(RedisSearchCtx *ctx, RedisModuleString *keyName,
                                              int write) {
@@ -52,6 +54,146 @@ VecSimIndex *OpenVectorIndex(RedisSearchCtx *ctx,
   return openVectorKeysDict(ctx, keyName, 1);
 }
 
+typedef struct {
+  IndexIterator base;
+  DistHeapEntry *results;   // sorted by id
+  size_t numResults;
+  size_t offset;
+  t_docId lastDocId;
+  char *scoreField;
+} VectorListIterator;
+
+static inline void vliSetCurrent(VectorListIterator *it, RSIndexResult **hit) {
+  const DistHeapEntry *res = it->results + it->offset++;
+  it->lastDocId = res->id;
+  it->base.current->docId = res->id;
+  it->base.current->dist.distance = res->distance;
+  it->base.current->dist.scoreField = it->scoreField;
+  *hit = it->base.current;
+}
+
+static int VLI_Read(void *ctx, RSIndexResult **hit) {
+  VectorListIterator *it = ctx;
+  if (!it->base.isValid || it->offset >= it->numResults) {
+    it->base.isValid = 0;
+    return INDEXREAD_EOF;
+  }
+  vliSetCurrent(it, hit);
+  return INDEXREAD_OK;
+}
+
+static int VLI_SkipTo(void *ctx, t_docId docId, RSIndexResult **hit) {
+  VectorListIterator *it = ctx;
+  if (!it->base.isValid) {
+    return INDEXREAD_EOF;
+  }
+  // Find the first result not below docId
+  size_t lo = it->offset, hi = it->numResults;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (it->results[mid].id < docId) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  it->offset = lo;
+  if (it->offset >= it->numResults) {
+    it->base.isValid = 0;
+    return INDEXREAD_EOF;
+  }
+  vliSetCurrent(it, hit);
+  return it->lastDocId == docId ? INDEXREAD_OK : INDEXREAD_NOTFOUND;
+}
+
+static t_docId VLI_LastDocId(void *ctx) {
+  return ((VectorListIterator *)ctx)->lastDocId;
+}
+
+static size_t VLI_NumEstimated(void *ctx) {
+  return ((VectorListIterator *)ctx)->numResults;
+}
+
+static void VLI_Abort(void *ctx) {
+  ((VectorListIterator *)ctx)->base.isValid = 0;
+}
+
+static void VLI_Rewind(void *ctx) {
+  VectorListIterator *it = ctx;
+  it->base.isValid = 1;
+  it->offset = 0;
+  it->lastDocId = 0;
+  it->base.current->docId = 0;
+}
+
+static void VLI_Free(IndexIterator *self) {
+  VectorListIterator *it = self->ctx;
+  IndexResult_Free(it->base.current);
+  rm_free(it->results);
+  rm_free(it);
+}
+
+// Keep only the (id, distance) pairs of a VecSim result list ordered by id, so the iterator can
+// stream them into intersections and unions like any other sorted iterator, and skip ahead with
+// a binary search.
+static IndexIterator *newVectorListIterator(VecSimQueryResult_List list, char *scoreField,
+                                            enum iteratorType type) {
+  VectorListIterator *it = rm_calloc(1, sizeof(*it));
+  it->numResults = VecSimQueryResult_Len(list);
+  if (it->numResults) {
+    it->results = rm_malloc(it->numResults * sizeof(*it->results));
+    VecSimQueryResult_Iterator *iter = VecSimQueryResult_List_GetIterator(list);
+    for (size_t i = 0; VecSimQueryResult_IteratorHasNext(iter); i++) {
+      VecSimQueryResult *res = VecSimQueryResult_IteratorNext(iter);
+      it->results[i].id = VecSimQueryResult_GetId(res);
+      it->results[i].distance = VecSimQueryResult_GetScore(res);
+    }
+    VecSimQueryResult_IteratorFree(iter);
+  }
+  it->scoreField = scoreField;
+
+  IndexIterator *ret = &it->base;
+  ret->ctx = it;
+  ret->isValid = 1;
+  ret->current = NewDistanceResult();
+  ret->type = type;
+  ret->mode = MODE_SORTED;
+  ret->NumEstimated = VLI_NumEstimated;
+  ret->GetCriteriaTester = NULL;
+  ret->Read = VLI_Read;
+  ret->SkipTo = VLI_SkipTo;
+  ret->LastDocId = VLI_LastDocId;
+  ret->HasNext = NULL;
+  ret->Free = VLI_Free;
+  ret->Len = VLI_NumEstimated;
+  ret->Abort = VLI_Abort;
+  ret->Rewind = VLI_Rewind;
+  return ret;
+}
+
+// Run a range query, or a KNN query whose results are fused with its filter's results rather
+// than filtered by them, up front and return its results ordered by id.
+static IndexIterator *newVectorIteratorById(VecSimIndex *index, VectorQuery *vq,
+                                            VecSimQueryParams *qParams, QueryError *status) {
+  VecSimQueryResult_List list;
+  enum iteratorType type;
+  if (vq->type == VECSIM_QT_RANGE) {
+    list = VecSimIndex_RangeQuery(index, vq->range.vector, vq->range.radius, qParams, BY_ID);
+    type = VECTOR_RANGE_ITERATOR;
+  } else {
+    list = VecSimIndex_TopKQuery(index, vq->knn.vector, vq->knn.k, qParams, BY_ID);
+    type = VECTOR_TOPK_ITERATOR;
+  }
+  if (list.code == VecSim_QueryResult_TimedOut) {
+    VecSimQueryResult_Free(list);
+    QueryError_SetError(status, QUERY_TIMEDOUT, NULL);
+    return NULL;
+  }
+  IndexIterator *ret = newVectorListIterator(list, vq->scoreField, type);
+  VecSimQueryResult_Free(list);
+  return ret;
+}
+
 IndexIterator *NewVectorIterator(QueryEvalCtx *q, VectorQuery *vq, IndexIterator *child_it) {
   RedisSearchCtx *ctx = q->sctx;
   RedisModuleString *key = RedisModule_CreateStringPrintf(ctx->redisCtx, "%s", vq->property);
@@ -60,37 +202,57 @@ IndexIterator *NewVectorIterator(QueryEvalCtx *q, VectorQuery *vq, IndexIterator
   if (!vecsim) {
     return NULL;
   }
+
+  VecSimIndexInfo info = VecSimIndex_Info(vecsim);
+  size_t dim = 0;
+  VecSimType type = (VecSimType)0;
+  VecSimMetric metric = (VecSimMetric)0;
+  switch (info.algo) {
+    case VecSimAlgo_HNSWLIB:
+      dim = info.hnswInfo.dim;
+      type = info.hnswInfo.type;
+      metric = info.hnswInfo.metric;
+      break;
+    case VecSimAlgo_BF:
+      dim = info.bfInfo.dim;
+      type = info.bfInfo.type;
+      metric = info.bfInfo.metric;
+      break;
+  }
+  size_t vecLen = vq->type == VECSIM_QT_RANGE ? vq->range.vecLen : vq->knn.vecLen;
+  if ((dim * VecSimType_sizeof(type)) != vecLen) {
+    QueryError_SetErrorFmt(q->status, QUERY_EINVAL,
+                           "Error parsing vector similarity query: query vector blob size (%zu) does not match index's expected size (%zu).",
+                           vecLen, (dim * VecSimType_sizeof(type)));
+    return NULL;
+  }
+
   switch (vq->type) {
     case VECSIM_QT_KNN: {
       VecSimQueryParams qParams = {0};
+      if (q->opts->fusion.method != FusionMethod_None) {
+        // Fusion ranks the KNN results and the filter's results side by side, so rather than
+        // filtering the KNN results by the child we take the union of both, each ordered by id.
+        if (VecSim_ResolveQueryParams(vecsim, vq->params.params, array_len(vq->params.params),
+                                      &qParams, QUERY_TYPE_KNN, q->status) != VecSim_OK)  {
+          return NULL;
+        }
+        TimeoutCtx timeoutCtx = {.timeout = q->sctx->timeout, .counter = 0};
+        qParams.timeoutCtx = &timeoutCtx;
+        IndexIterator *knn_it = newVectorIteratorById(vecsim, vq, &qParams, q->status);
+        if (!knn_it || !child_it) {
+          return knn_it;
+        }
+        IndexIterator **its = rm_calloc(2, sizeof(*its));
+        its[0] = child_it;
+        its[1] = knn_it;
+        return NewUnionIterator(its, 2, q->docTable, 0, 1, QN_UNION, NULL);
+      }
       VecsimQueryType query_type = child_it ? QUERY_TYPE_HYBRID : QUERY_TYPE_KNN;
       if (VecSim_ResolveQueryParams(vecsim, vq->params.params, array_len(vq->params.params),
                                     &qParams, query_type, q->status) != VecSim_OK)  {
         return NULL;
       }
-
-      VecSimIndexInfo info = VecSimIndex_Info(vecsim);
-      size_t dim = 0;
-      VecSimType type = (VecSimType)0;
-      VecSimMetric metric = (VecSimMetric)0;
-      switch (info.algo) {
-        case VecSimAlgo_HNSWLIB:
-          dim = info.hnswInfo.dim;
-          type = info.hnswInfo.type;
-          metric = info.hnswInfo.metric;
-          break;
-        case VecSimAlgo_BF:
-          dim = info.bfInfo.dim;
-          type = info.bfInfo.type;
-          metric = info.bfInfo.metric;
-          break;
-      }
-      if ((dim * VecSimType_sizeof(type)) != vq->knn.vecLen) {
-        QueryError_SetErrorFmt(q->status, QUERY_EINVAL,
-                               "Error parsing vector similarity query: query vector blob size (%zu) does not match index's expected size (%zu).",
-                               vq->knn.vecLen, (dim * VecSimType_sizeof(type)));
-        return NULL;
-      }
       HybridIteratorParams hParams = {.index = vecsim,
                                       .dim = dim,
                                       .elementType = type,
@@ -104,6 +266,16 @@ IndexIterator *NewVectorIterator(QueryEvalCtx *q, VectorQuery *vq, IndexIterator
       };
       return NewHybridVectorIterator(hParams);
     }
+    case VECSIM_QT_RANGE: {
+      VecSimQueryParams qParams = {0};
+      if (VecSim_ResolveQueryParams(vecsim, vq->params.params, array_len(vq->params.params),
+                                    &qParams, QUERY_TYPE_RANGE, q->status) != VecSim_OK)  {
+        return NULL;
+      }
+      TimeoutCtx timeoutCtx = {.timeout = q->sctx->timeout, .counter = 0};
+      qParams.timeoutCtx = &timeoutCtx;
+      return newVectorIteratorById(vecsim, vq, &qParams, q->status);
+    }
   }
   return NULL;
 }
@@ -24,6 +24,7 @@
 #define VECSIM_EFRUNTIME "EF_RUNTIME"
 #define VECSIM_HYBRID_POLICY "HYBRID_POLICY"
 #define VECSIM_BATCH_SIZE "BATCH_SIZE"
+#define VECSIM_EPSILON "EPSILON"
 #define VECSIM_TYPE "TYPE"
 #define VECSIM_DIM "DIM"
 #define VECSIM_DISTANCE_METRIC "DISTANCE_METRIC"
@@ -33,6 +34,7 @@
 
 typedef enum {
   VECSIM_QT_KNN,
+  VECSIM_QT_RANGE,
 } VectorQueryType;
 
 // This struct holds VecSimRawParam array and bool array.
@@ -55,11 +57,18 @@ typedef struct {
   VecSimQueryResult_Order order;  // specify the result order.
 } KNNVectorQuery;
 
+typedef struct {
+  void *vector;                   // query vector data
+  size_t vecLen;                  // vector length
+  double radius;                  // the maximal distance of the returned vectors
+} RangeVectorQuery;
+
 typedef struct VectorQuery {
   char *property;                     // name of field
   char *scoreField;                   // name of score field
   union {
     KNNVectorQuery knn;
+    RangeVectorQuery range;
   };
   VectorQueryType type;               // vector similarity query type
   VectorQueryParams params;           // generic query params array, for the vecsim library to check
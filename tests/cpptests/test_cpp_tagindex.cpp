@@ -25,7 +25,7 @@ TEST_F(TagIndexTest, testCreate) {
     ASSERT_EQ(0, sz);
   }
 
-  ASSERT_EQ(v.size(), idx->values->cardinality);
+  ASSERT_EQ(v.size(), idx->values.size);
   ASSERT_EQ(300000, totalSZ);
 
   IndexIterator *it = TagIndex_OpenReader(idx, NULL, "hello", 5, 1);
@@ -90,3 +90,112 @@ TEST_F(TagIndexTest, testSepString) {
 
   TEST_MY_SEP(' ', "   foo    bar   ")
 }
+
+TEST_F(TagIndexTest, testDocValues) {
+  TagIndex *idx = NewTagIndex();
+  std::vector<const char *> v{"foo", "bar"};
+  for (t_docId d = 1; d <= 2000; d++) {
+    TagIndex_Index(idx, &v[d % 2], 1, d);
+    if (d % 3) {
+      TagIndex_SetDocValue(idx, d, v[d % 2], strlen(v[d % 2]));
+    }
+  }
+  ASSERT_EQ(2, idx->values.size);
+
+  for (t_docId d = 1; d <= 2000; d++) {
+    const TagDictEntry *e = TagIndex_GetDocValue(idx, d);
+    if (d % 3) {
+      ASSERT_TRUE(e != NULL);
+      ASSERT_STREQ(v[d % 2], e->value);
+    } else {
+      ASSERT_TRUE(e == NULL);
+    }
+  }
+  ASSERT_TRUE(TagIndex_GetDocValue(idx, 100000) == NULL);
+
+  // values removed by the GC are no longer reported
+  TagIndex_DeleteValue(idx, "foo", 3);
+  ASSERT_EQ(1, idx->values.size);
+  ASSERT_TRUE(TagIndex_GetDocValue(idx, 2) == NULL);
+  ASSERT_STREQ("bar", TagIndex_GetDocValue(idx, 1)->value);
+  TagIndex_Free(idx);
+}
+
+TEST_F(TagIndexTest, testDocValuesCompaction) {
+  TagIndex *idx = NewTagIndex();
+  const char *v = "foo";
+  const t_docId n = 10 * TAG_DOCVALUES_PAGE_SIZE;
+  for (t_docId d = 1; d <= n; d++) {
+    TagIndex_Index(idx, &v, 1, d);
+    TagIndex_SetDocValue(idx, d, v, 3);
+  }
+  ASSERT_EQ(n / TAG_DOCVALUES_PAGE_SIZE + 1, array_len(idx->docValues));
+
+  // clearing the oldest documents frees their pages, and the column starts after them
+  std::vector<t_docId> deleted;
+  for (t_docId d = 1; d <= n - 100; d++) {
+    deleted.push_back(d);
+  }
+  TagIndex_ClearDocValues(idx, &deleted[0], deleted.size());
+  ASSERT_EQ(2, array_len(idx->docValues));
+  ASSERT_EQ(n / TAG_DOCVALUES_PAGE_SIZE - 1, idx->docValuesBase);
+  ASSERT_TRUE(TagIndex_GetDocValue(idx, 1) == NULL);
+  ASSERT_TRUE(TagIndex_GetDocValue(idx, n - 100) == NULL);
+  ASSERT_STREQ("foo", TagIndex_GetDocValue(idx, n - 99)->value);
+  ASSERT_STREQ("foo", TagIndex_GetDocValue(idx, n)->value);
+
+  // an older document can still be recorded in front of the column
+  TagIndex_SetDocValue(idx, 5, v, 3);
+  ASSERT_EQ(0, idx->docValuesBase);
+  ASSERT_STREQ("foo", TagIndex_GetDocValue(idx, 5)->value);
+  ASSERT_STREQ("foo", TagIndex_GetDocValue(idx, n)->value);
+
+  deleted.clear();
+  deleted.push_back(5);
+  for (t_docId d = n - 99; d <= n; d++) {
+    deleted.push_back(d);
+  }
+  TagIndex_ClearDocValues(idx, &deleted[0], deleted.size());
+  ASSERT_TRUE(idx->docValues == NULL);
+  TagIndex_Free(idx);
+}
+
+TEST_F(TagIndexTest, testDictionaryReuse) {
+  TagIndex *idx = NewTagIndex();
+  const char *foo = "foo", *bar = "bar", *baz = "baz";
+  TagIndex_Index(idx, &foo, 1, 1);
+  TagIndex_Index(idx, &bar, 1, 2);
+  TagIndex_SetDocValue(idx, 2, bar, 3);
+  ASSERT_EQ(3, array_len(idx->dict));
+  uint32_t barId = TagIndex_GetDocValueId(idx, 2);
+
+  // the id of a removed value is taken by the next new value, and the revision tells readers
+  uint32_t revision = idx->dictRevision;
+  TagIndex_DeleteValue(idx, "bar", 3);
+  ASSERT_NE(revision, idx->dictRevision);
+  ASSERT_EQ(0, TagIndex_GetDocValueId(idx, 2));
+  TagIndex_Index(idx, &baz, 1, 3);
+  TagIndex_SetDocValue(idx, 3, baz, 3);
+  ASSERT_EQ(3, array_len(idx->dict));
+  ASSERT_EQ(barId, TagIndex_GetDocValueId(idx, 3));
+  ASSERT_STREQ("baz", TagIndex_GetDocValue(idx, 3)->value);
+  ASSERT_EQ(2, idx->values.size);
+  TagIndex_Free(idx);
+}
+
+TEST_F(TagIndexTest, testSortedValuesDelete) {
+  TagIndex *idx = NewTagIndex();
+  const char *foo = "foo", *bar = "bar";
+  TagIndex_Index(idx, &foo, 1, 1);
+  TagIndex_Index(idx, &bar, 1, 2);
+
+  // the sorted view shares the inverted indexes, removing a value or freeing the index frees them
+  // only once
+  TrieMap *sorted = TagIndex_GetSortedValues(idx);
+  ASSERT_EQ(2, sorted->cardinality);
+  TagIndex_DeleteValue(idx, "bar", 3);
+  ASSERT_EQ(1, sorted->cardinality);
+  ASSERT_EQ(TRIEMAP_NOTFOUND, TrieMap_Find(sorted, (char *)"bar", 3));
+  ASSERT_EQ(1, idx->values.size);
+  TagIndex_Free(idx);
+}
@@ -34,6 +34,29 @@ TEST_F(TokenizerTest, testTokenize) {
   tk->Free(tk);
 }
 
+TEST_F(TokenizerTest, testNormalizeLongTokens) {
+  // Long tokens are normalized a word at a time up to their first upper case letter or escape
+  RSTokenizer *tk = GetSimpleTokenizer(NULL, DefaultStopWordList());
+  char *txt = strdup(
+      "lowercaseonlytokenlongerthanaword abcdefghIJKLmnopqrstuvwxyz0123456789 ABCDEFGHIJKLMNOP "
+      "mixed\\-escaped\\-longer\\-token abcdefg\x7fh");
+  const char *expected[] = {"lowercaseonlytokenlongerthanaword",
+                            "abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnop",
+                            "mixed-escaped-longer-token", "abcdefgh"};
+  tk->Start(tk, txt, strlen(txt), TOKENIZE_DEFAULT_OPTIONS);
+  Token tok = {0};
+  size_t i = 0;
+  while (tk->Next(tk, &tok)) {
+    ASSERT_LT(i, sizeof(expected) / sizeof(*expected));
+    std::string got(tok.tok, tok.tokLen);
+    ASSERT_STREQ(got.c_str(), expected[i]);
+    i++;
+  }
+  ASSERT_EQ(i, sizeof(expected) / sizeof(*expected));
+  free(txt);
+  tk->Free(tk);
+}
+
 struct MyToken {
   std::string token;
   std::string stem;
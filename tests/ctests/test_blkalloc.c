@@ -3,6 +3,7 @@
 #include "test_util.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #include "rmutil/alloc.h"
 
@@ -82,7 +83,41 @@ static int testFreeFunc() {
   return 0;
 }
 
+static int testStrndup() {
+  BlkAlloc alloc;
+  BlkAlloc_Init(&alloc);
+
+  char *s1 = BlkAlloc_Strndup(&alloc, "hello world", 5, 16);
+  ASSERT(!strcmp(s1, "hello"));
+  char *s2 = BlkAlloc_Strndup(&alloc, "foo", 3, 16);
+  ASSERT(!strcmp(s2, "foo"));
+  ASSERT(s2 == s1 + 6);
+  ASSERT(alloc.root == alloc.last);
+
+  // a string larger than the minimal block size gets a block of its own
+  char big[64];
+  memset(big, 'x', sizeof(big));
+  char *s3 = BlkAlloc_Strndup(&alloc, big, sizeof(big), 16);
+  ASSERT(alloc.root != alloc.last);
+  ASSERT(alloc.last->capacity == sizeof(big) + 1);
+  ASSERT(strlen(s3) == sizeof(big));
+
+  // after clearing, the big block is reused for small strings until it is full
+  BlkAlloc_Clear(&alloc, NULL, NULL, 0);
+  for (int i = 0; i < 10; i++) {
+    char *s = BlkAlloc_Strndup(&alloc, "abcde", 5, 16);
+    ASSERT(!strcmp(s, "abcde"));
+  }
+  for (BlkAllocBlock *blk = alloc.root; blk; blk = blk->next) {
+    ASSERT(blk->numUsed <= blk->capacity);
+  }
+
+  BlkAlloc_FreeAll(&alloc, NULL, NULL, 0);
+  return 0;
+}
+
 TEST_MAIN({
   TESTFUNC(testBlockAlloc);
   TESTFUNC(testFreeFunc);
+  TESTFUNC(testStrndup);
 })
@@ -0,0 +1,52 @@
+#include "test_util.h"
+#include "src/util/dist_heap.h"
+
+#include <stdlib.h>
+#include <math.h>
+#include "rmutil/alloc.h"
+
+int testDistHeapTopK() {
+  const size_t N = 10000, K = 100;
+  DistHeap h;
+  DistHeap_Init(&h, K);
+  ASSERT(isinf(DistHeap_Bound(&h)));
+
+  // Offer the ids in a scrambled order, the distance of id i is i
+  for (size_t ii = 0; ii < N; ++ii) {
+    uint64_t id = (ii * 7919) % N;
+    DistHeap_Offer(&h, id, (double)id);
+  }
+  ASSERT_EQUAL(K, h.size);
+  ASSERT_EQUAL(K - 1, DistHeap_Bound(&h));
+  ASSERT(!DistHeap_Offer(&h, N, (double)N));
+
+  DistHeap_SortById(&h);
+  for (size_t ii = 0; ii < K; ++ii) {
+    ASSERT_EQUAL(ii, h.entries[ii].id);
+    ASSERT_EQUAL(ii, h.entries[ii].distance);
+  }
+
+  DistHeap_Clear(&h);
+  ASSERT_EQUAL(0, h.size);
+  ASSERT(DistHeap_Offer(&h, 1, 1.5));
+  ASSERT(isinf(DistHeap_Bound(&h)));
+
+  DistHeap_Free(&h);
+  return 0;
+}
+
+int testDistHeapEmpty() {
+  DistHeap h;
+  DistHeap_Init(&h, 0);
+  ASSERT(!DistHeap_Offer(&h, 1, 1));
+  ASSERT_EQUAL(0, h.size);
+  ASSERT(DistHeap_Bound(&h) < 0);
+  DistHeap_Free(&h);
+  return 0;
+}
+
+TEST_MAIN({
+  RMUTil_InitAlloc();
+  TESTFUNC(testDistHeapTopK);
+  TESTFUNC(testDistHeapEmpty);
+})
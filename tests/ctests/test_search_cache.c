@@ -0,0 +1,134 @@
+#include "src/trie/trie_type.h"
+#include "src/trie/search_cache.h"
+#include "rmutil/alloc.h"
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static const char *prefixes[] = {"", "a", "ab", "abc", "b", "ba", "bab", "c", "cab", "zz"};
+#define NUM_PREFIXES (sizeof(prefixes) / sizeof(*prefixes))
+
+static void randomTerm(char *buf) {
+  int len = 1 + rand() % 6;
+  for (int ii = 0; ii < len; ++ii) {
+    buf[ii] = "abc"[rand() % 3];
+  }
+  buf[len] = '\0';
+}
+
+static float randomScore() {
+  // distinct scores, so both tries break no ties
+  return 1 + (float)rand() / RAND_MAX * 1000;
+}
+
+static void searchResultsFree(Vector *v) {
+  for (size_t ii = 0; ii < Vector_Size(v); ++ii) {
+    TrieSearchResult *r;
+    Vector_Get(v, ii, &r);
+    TrieSearchResult_Free(r);
+  }
+  Vector_Free(v);
+}
+
+/* Returns 1 if searching both tries yields the same results */
+static int sameSearch(Trie *cached, Trie *plain, const char *prefix, size_t num, int maxDist,
+                      int withPayloads) {
+  Vector *v1 = Trie_Search(cached, prefix, strlen(prefix), num, maxDist, 1, 0, 0);
+  Vector *v2 = Trie_Search(plain, prefix, strlen(prefix), num, maxDist, 1, 0, 0);
+  int same = Vector_Size(v1) == Vector_Size(v2);
+  for (size_t ii = 0; ii < Vector_Size(v1); ++ii) {
+    TrieSearchResult *r1, *r2;
+    Vector_Get(v1, ii, &r1);
+    if (same) {
+      Vector_Get(v2, ii, &r2);
+      same = r1->len == r2->len && !memcmp(r1->str, r2->str, r1->len) && r1->score == r2->score &&
+             (!withPayloads || (r1->plen == r2->plen && (!r1->plen || !memcmp(r1->payload, r2->payload, r1->plen))));
+    }
+  }
+  searchResultsFree(v1);
+  searchResultsFree(v2);
+  return same;
+}
+
+int testSearchCacheHits() {
+  Trie *t = NewTrie(NULL, Trie_Sort_Score);
+  Trie_EnableSearchCache(t);
+  Trie_InsertStringBuffer(t, "hello", 5, 1, 0, NULL);
+  Trie_InsertStringBuffer(t, "help", 4, 2, 0, NULL);
+
+  for (int ii = 0; ii < 3; ++ii) {
+    Vector *v = Trie_Search(t, "he", 2, 5, 0, 1, 0, 0);
+    ASSERT_EQUAL(2, Vector_Size(v));
+    TrieSearchResult *r;
+    Vector_Get(v, 0, &r);
+    ASSERT_STRING_EQ("help", r->str);
+    searchResultsFree(v);
+  }
+  TrieSearchCacheStats stats;
+  TrieSearchCache_GetStats(t->searchCache, &stats);
+  ASSERT_EQUAL(3, stats.lookups);
+  ASSERT_EQUAL(2, stats.hits);
+  ASSERT_EQUAL(1, stats.size);
+
+  // an unrelated insert keeps the search, a fuzzy search is dropped by any insert
+  searchResultsFree(Trie_Search(t, "he", 2, 5, 1, 1, 0, 0));
+  TrieSearchCache_GetStats(t->searchCache, &stats);
+  ASSERT_EQUAL(2, stats.size);
+  Trie_InsertStringBuffer(t, "world", 5, 3, 0, NULL);
+  TrieSearchCache_GetStats(t->searchCache, &stats);
+  ASSERT_EQUAL(1, stats.size);
+
+  ASSERT(TrieType_MemUsage(t) > 0);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSearchCacheConsistency() {
+  Trie *cached = NewTrie(NULL, Trie_Sort_Score);
+  Trie *plain = NewTrie(NULL, Trie_Sort_Score);
+  Trie_EnableSearchCache(cached);
+  srand(1);
+
+  char buf[16], payload[16];
+  for (int round = 0; round < 2000; ++round) {
+    randomTerm(buf);
+    int op = rand() % 10;
+    if (op < 6) {
+      float score = randomScore();
+      int incr = op == 5;
+      RSPayload pl = {0};
+      if (rand() % 2) {
+        sprintf(payload, "p%d", round);
+        pl = (RSPayload){.data = payload, .len = strlen(payload)};
+      }
+      Trie_InsertStringBuffer(cached, buf, strlen(buf), score, incr, pl.len ? &pl : NULL);
+      Trie_InsertStringBuffer(plain, buf, strlen(buf), score, incr, pl.len ? &pl : NULL);
+    } else if (op < 8) {
+      ASSERT_EQUAL(Trie_Delete(plain, buf, strlen(buf)), Trie_Delete(cached, buf, strlen(buf)));
+    }
+
+    // searches fill the cache, and must match the trie without one after every change
+    const char *prefix = prefixes[rand() % NUM_PREFIXES];
+    size_t num = 1 + rand() % 10;
+    ASSERT(sameSearch(cached, plain, prefix, num, 0, 1));
+    ASSERT(sameSearch(cached, plain, prefix, num, 0, 1));
+    ASSERT(sameSearch(cached, plain, prefix, num, rand() % 2, 1));
+  }
+
+  TrieSearchCacheStats stats;
+  TrieSearchCache_GetStats(cached->searchCache, &stats);
+  ASSERT(stats.hits > stats.lookups / 3);
+  ASSERT(stats.size <= TRIE_SEARCH_CACHE_SIZE);
+
+  TrieType_Free(cached);
+  TrieType_Free(plain);
+  return 0;
+}
+
+TEST_MAIN({
+  RMUTil_InitAlloc();
+  TESTFUNC(testSearchCacheHits);
+  TESTFUNC(testSearchCacheConsistency);
+});
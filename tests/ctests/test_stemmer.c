@@ -5,6 +5,7 @@
 #include "test_util.h"
 
 #include <string.h>
+#include <pthread.h>
 
 int testStemmer() {
 
@@ -23,6 +24,73 @@ int testStemmer() {
   return 0;
 }
 
+int testStemmerCache() {
+  Stemmer *s = NewStemmer(SnowballStemmer, RS_LANG_ENGLISH);
+  ASSERT(s != NULL)
+
+  const char *words[] = {"running", "worlds", "world", "arbitrary", "going"};
+  const char *stems[] = {"+run", "+world", NULL, "+arbitrari", "+go"};
+  // the second round is served from the cache and must give the same results
+  for (int round = 0; round < 2; round++) {
+    for (int ii = 0; ii < sizeof(words) / sizeof(*words); ii++) {
+      size_t sl;
+      const char *stem = s->Stem(s->ctx, words[ii], strlen(words[ii]), &sl);
+      if (stems[ii]) {
+        ASSERT(stem != NULL);
+        ASSERT_EQUAL(strlen(stems[ii]), sl);
+        ASSERT(!strncmp(stem, stems[ii], sl));
+      } else {
+        ASSERT(stem == NULL);
+      }
+    }
+  }
+
+  // numbers and very short words are never stemmed
+  size_t sl;
+  ASSERT(s->Stem(s->ctx, "123456", 6, &sl) == NULL);
+  ASSERT(s->Stem(s->ctx, "is", 2, &sl) == NULL);
+
+  // the counters are reported to the global stats when the stemmer is freed
+  StemmerCacheStats before;
+  Stemmer_GetCacheStats(&before);
+  s->Free(s);
+  StemmerCacheStats after;
+  Stemmer_GetCacheStats(&after);
+  ASSERT_EQUAL(10, after.lookups - before.lookups);
+  ASSERT_EQUAL(5, after.hits - before.hits);
+  ASSERT_EQUAL(2, after.skipped - before.skipped);
+  return 0;
+}
+
+static void *threadStemmerWorker(void *p) {
+  Stemmer *s = GetThreadLocalStemmer(RS_LANG_ENGLISH);
+  size_t sl;
+  *(int *)p = s && s->Stem(s->ctx, "running", 7, &sl) != NULL;
+  return NULL;
+}
+
+int testThreadLocalStemmer() {
+  Stemmer *s = GetThreadLocalStemmer(RS_LANG_ENGLISH);
+  ASSERT(s != NULL);
+  ASSERT(s == GetThreadLocalStemmer(RS_LANG_ENGLISH));
+  ASSERT(GetThreadLocalStemmer(RS_LANG_UNSUPPORTED) == NULL);
+
+  // the stemmers of a thread are freed when it exits
+  int ok = 0;
+  pthread_t thread;
+  pthread_create(&thread, NULL, threadStemmerWorker, &ok);
+  pthread_join(thread, NULL);
+  ASSERT(ok);
+
+  // the stemmers of the threads still running are freed on shutdown, and new ones are created
+  // on the next use
+  Stemmer_FreeThreadLocal();
+  s = GetThreadLocalStemmer(RS_LANG_FRENCH);
+  ASSERT(s != NULL);
+  Stemmer_FreeThreadLocal();
+  return 0;
+}
+
 typedef struct {
   int num;
   const char **expectedTokens;
@@ -83,6 +151,8 @@ int testTokenize() {
 TEST_MAIN({
   RMUTil_InitAlloc();
   TESTFUNC(testStemmer);
+  TESTFUNC(testStemmerCache);
+  TESTFUNC(testThreadLocalStemmer);
   TESTFUNC(testTokenize);
   StopWordList_FreeGlobals();
 });
\ No newline at end of file
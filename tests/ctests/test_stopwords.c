@@ -43,9 +43,41 @@ int testDefaultStopwords() {
   return 0;
 }
 
+int testLargeStopwordList() {
+  // a list of the maximal size, to exercise the perfect hash placement
+  const size_t N = 1024;
+  char **terms = malloc(N * sizeof(*terms));
+  for (size_t i = 0; i < N; i++) {
+    terms[i] = malloc(16);
+    sprintf(terms[i], "Word%zu", i);
+  }
+  StopWordList *sl = NewStopWordListCStr((const char **)terms, N);
+  ASSERT(sl != NULL);
+
+  char buf[16];
+  for (size_t i = 0; i < N; i++) {
+    ASSERT(StopWordList_Contains(sl, terms[i], strlen(terms[i])));
+    sprintf(buf, "word%zu", i);
+    ASSERT(StopWordList_Contains(sl, buf, strlen(buf)));
+    sprintf(buf, "word%zu", i + N);
+    ASSERT(!StopWordList_Contains(sl, buf, strlen(buf)));
+  }
+  // a prefix of a stopword is not a stopword
+  ASSERT(!StopWordList_Contains(sl, "word", 4));
+  ASSERT(!StopWordList_Contains(sl, "", 0));
+
+  StopWordList_Free(sl);
+  for (size_t i = 0; i < N; i++) {
+    free(terms[i]);
+  }
+  free(terms);
+  return 0;
+}
+
 TEST_MAIN({
   RMUTil_InitAlloc();
   TESTFUNC(testStopwordList);
   TESTFUNC(testDefaultStopwords);
+  TESTFUNC(testLargeStopwordList);
   StopWordList_FreeGlobals();
 });
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "test_util.h"
+#include "src/util/strmap.h"
+
+#include <string.h>
+#include "rmutil/alloc.h"
+
+int testStrMapBasic() {
+  StrMap m;
+  StrMap_Init(&m);
+  ASSERT(StrMap_Find(&m, "foo", 3) == NULL);
+  ASSERT(StrMap_Delete(&m, "foo", 3) == NULL);
+
+  ASSERT(StrMap_Add(&m, "foo", 3, (void *)1) == 1);
+  ASSERT(StrMap_Add(&m, "foo", 3, (void *)2) == 0);
+  ASSERT(StrMap_Find(&m, "foo", 3) == (void *)1);
+  ASSERT(StrMap_Find(&m, "fo", 2) == NULL);
+  ASSERT(StrMap_Find(&m, "fooo", 4) == NULL);
+  ASSERT_EQUAL(1, m.size);
+
+  ASSERT(StrMap_Delete(&m, "foo", 3) == (void *)1);
+  ASSERT(StrMap_Find(&m, "foo", 3) == NULL);
+  ASSERT_EQUAL(0, m.size);
+
+  StrMap_Free(&m, NULL);
+  return 0;
+}
+
+int testStrMapMany() {
+  const size_t N = 50000;
+  char buf[32];
+  StrMap m;
+  StrMap_Init(&m);
+  for (size_t ii = 1; ii <= N; ++ii) {
+    size_t n = sprintf(buf, "key%zu", ii);
+    ASSERT(StrMap_Add(&m, buf, n, (void *)ii));
+  }
+  ASSERT_EQUAL(N, m.size);
+
+  // Remove every other key, the rest must stay reachable after the backward shifts
+  for (size_t ii = 1; ii <= N; ii += 2) {
+    size_t n = sprintf(buf, "key%zu", ii);
+    ASSERT(StrMap_Delete(&m, buf, n) == (void *)ii);
+  }
+  ASSERT_EQUAL(N / 2, m.size);
+  for (size_t ii = 1; ii <= N; ++ii) {
+    size_t n = sprintf(buf, "key%zu", ii);
+    void *expected = ii % 2 ? NULL : (void *)ii;
+    ASSERT(StrMap_Find(&m, buf, n) == expected);
+  }
+
+  size_t count = 0;
+  StrMapIterator it = StrMap_Iterate(&m);
+  StrMapEntry *e;
+  while ((e = StrMapIterator_Next(&it))) {
+    ASSERT(StrMap_Find(&m, e->key, e->len) == e->value);
+    ASSERT(strlen(e->key) == e->len);
+    count++;
+  }
+  ASSERT_EQUAL(N / 2, count);
+
+  StrMap_Free(&m, NULL);
+  return 0;
+}
+
+TEST_MAIN({
+  RMUTil_InitAlloc();
+  TESTFUNC(testStrMapBasic);
+  TESTFUNC(testStrMapMany);
+})
@@ -0,0 +1,227 @@
+#include "src/trie/trie_type.h"
+#include "src/trie/terms_snapshot.h"
+#include "src/trie/suffix_array.h"
+#include "src/trie/rune_util.h"
+#include "wildcard/wildcard.h"
+#include "rmutil/alloc.h"
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+typedef struct {
+  char **terms;
+  size_t n;
+  size_t cap;
+  size_t stopAfter;
+} collected;
+
+static int collectCb(const char *s, size_t n, void *p, void *payload) {
+  collected *c = p;
+  if (c->n == c->cap) {
+    c->cap = c->cap ? c->cap * 2 : 16;
+    c->terms = realloc(c->terms, c->cap * sizeof(*c->terms));
+  }
+  c->terms[c->n++] = strndup(s, n);
+  return c->stopAfter && c->n == c->stopAfter ? REDISEARCH_ERR : REDISEARCH_OK;
+}
+
+static int collectRuneCb(const rune *r, size_t n, void *p, void *payload) {
+  size_t len;
+  char *s = runesToStr(r, n, &len);
+  int rc = collectCb(s, len, p, payload);
+  rm_free(s);
+  return rc;
+}
+
+static int cmpStrs(const void *p1, const void *p2) {
+  return strcmp(*(char **)p1, *(char **)p2);
+}
+
+static int sameTerms(collected *c1, collected *c2) {
+  if (c1->n != c2->n) {
+    return 0;
+  } else if (!c1->n) {
+    return 1;
+  }
+  qsort(c1->terms, c1->n, sizeof(char *), cmpStrs);
+  qsort(c2->terms, c2->n, sizeof(char *), cmpStrs);
+  for (size_t ii = 0; ii < c1->n; ++ii) {
+    if (strcmp(c1->terms[ii], c2->terms[ii])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// the trie reports a term once for every occurrence of the pattern
+static void uniqTerms(collected *c) {
+  if (!c->n) {
+    return;
+  }
+  qsort(c->terms, c->n, sizeof(char *), cmpStrs);
+  size_t uniq = 1;
+  for (size_t ii = 1; ii < c->n; ++ii) {
+    if (strcmp(c->terms[uniq - 1], c->terms[ii])) {
+      c->terms[uniq++] = c->terms[ii];
+    } else {
+      free(c->terms[ii]);
+    }
+  }
+  c->n = uniq;
+}
+
+static void collectedFree(collected *c) {
+  for (size_t ii = 0; ii < c->n; ++ii) {
+    free(c->terms[ii]);
+  }
+  free(c->terms);
+  memset(c, 0, sizeof(*c));
+}
+
+static Trie *buildTrie(size_t n) {
+  static const char *syllables[] = {"ba", "be", "co", "da", "el", "fo", "ga", "hi", "ka", "lo"};
+  char buf[64];
+  Trie *t = NewTrie(NULL, Trie_Sort_Lex);
+  srand(1);
+  for (size_t ii = 0; ii < n; ++ii) {
+    buf[0] = '\0';
+    int nsyl = 1 + rand() % 5;
+    for (int jj = 0; jj < nsyl; ++jj) {
+      strcat(buf, syllables[rand() % 10]);
+    }
+    Trie_InsertStringBuffer(t, buf, strlen(buf), 1, 1, NULL);
+  }
+  Trie_InsertStringBuffer(t, "héllo", strlen("héllo"), 1, 1, NULL);
+  Trie_InsertStringBuffer(t, "hello", strlen("hello"), 1, 1, NULL);
+  return t;
+}
+
+int testSuffixArrayContains() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  SuffixArray *sa = NewSuffixArray(s);
+  ASSERT(SuffixArray_MemUsage(sa) > 0);
+
+  const char *patterns[] = {"ba", "baba", "elfo", "oco", "ll", "él", "éllo", "lo", "zz", "kalohi"};
+  for (size_t ii = 0; ii < sizeof(patterns) / sizeof(*patterns); ++ii) {
+    for (int suffixOnly = 0; suffixOnly <= 1; ++suffixOnly) {
+      collected expected = {0}, got = {0};
+      size_t rlen;
+      rune *runes = strToFoldedRunes(patterns[ii], &rlen);
+      TrieNode_IterateContains(t->root, runes, rlen, !suffixOnly, 1, collectRuneCb, &expected,
+                               NULL);
+      rm_free(runes);
+      uniqTerms(&expected);
+      ASSERT(SuffixArray_IterateContains(sa, patterns[ii], strlen(patterns[ii]), suffixOnly,
+                                         collectCb, &got, NULL));
+      ASSERT(sameTerms(&expected, &got));
+      collectedFree(&expected);
+      collectedFree(&got);
+    }
+  }
+
+  // too short to be looked up
+  collected got = {0};
+  ASSERT(!SuffixArray_IterateContains(sa, "b", 1, 0, collectCb, &got, NULL));
+  ASSERT_EQUAL(0, got.n);
+
+  // the callback can stop the iteration
+  got.stopAfter = 3;
+  SuffixArray_IterateContains(sa, "ba", 2, 0, collectCb, &got, NULL);
+  ASSERT_EQUAL(3, got.n);
+  collectedFree(&got);
+
+  SuffixArray_Free(sa);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSuffixArrayWildcard() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  SuffixArray *sa = NewSuffixArray(s);
+
+  const char *patterns[] = {"*ba*", "ba*co", "*el?o", "hel?o", "*loka*ga*", "da??fo*", "*zz*"};
+  for (size_t ii = 0; ii < sizeof(patterns) / sizeof(*patterns); ++ii) {
+    collected expected = {0}, got = {0};
+    size_t rlen;
+    rune *runes = strToFoldedRunes(patterns[ii], &rlen);
+    TrieNode_IterateWildcard(t->root, runes, rlen, collectRuneCb, &expected, NULL);
+    rm_free(runes);
+    uniqTerms(&expected);
+    ASSERT(SuffixArray_IterateWildcard(sa, patterns[ii], strlen(patterns[ii]), collectCb, &got, NULL));
+    ASSERT(sameTerms(&expected, &got));
+    collectedFree(&expected);
+    collectedFree(&got);
+  }
+
+  // no literal part long enough, the caller has to scan the terms
+  collected got = {0};
+  ASSERT(!SuffixArray_IterateWildcard(sa, "*a?b*", 5, collectCb, &got, NULL));
+  ASSERT_EQUAL(0, got.n);
+
+  SuffixArray_Free(sa);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSuffixArrayWildcardEscape() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  SuffixArray *sa = NewSuffixArray(s);
+
+  // the query unescapes the pattern for the trie, the array gets it as typed
+  const char *patterns[] = {"\\b\\a*", "*\\lo\\ka*", "\\h\\e\\l?o", "ba\\*co", "h\\?llo"};
+  for (size_t ii = 0; ii < sizeof(patterns) / sizeof(*patterns); ++ii) {
+    collected expected = {0}, got = {0};
+    char *unescaped = strdup(patterns[ii]);
+    Wildcard_RemoveEscape(unescaped, strlen(unescaped));
+    size_t rlen;
+    rune *runes = strToFoldedRunes(unescaped, &rlen);
+    TrieNode_IterateWildcard(t->root, runes, rlen, collectRuneCb, &expected, NULL);
+    rm_free(runes);
+    free(unescaped);
+    uniqTerms(&expected);
+    ASSERT(SuffixArray_IterateWildcard(sa, patterns[ii], strlen(patterns[ii]), collectCb, &got,
+                                       NULL));
+    ASSERT(sameTerms(&expected, &got));
+    collectedFree(&expected);
+    collectedFree(&got);
+  }
+
+  // the escape is not part of the literal run, which is too short to be looked up
+  collected got = {0};
+  ASSERT(!SuffixArray_IterateWildcard(sa, "*\\b*", 4, collectCb, &got, NULL));
+  ASSERT_EQUAL(0, got.n);
+
+  SuffixArray_Free(sa);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSuffixArrayEmpty() {
+  Trie *t = NewTrie(NULL, Trie_Sort_Lex);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  SuffixArray *sa = NewSuffixArray(s);
+  ASSERT_EQUAL(0, sa->numSuffixes);
+  collected got = {0};
+  ASSERT(SuffixArray_IterateContains(sa, "foo", 3, 0, collectCb, &got, NULL));
+  ASSERT_EQUAL(0, got.n);
+  SuffixArray_Free(sa);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+TEST_MAIN({
+  RMUTil_InitAlloc();
+  TESTFUNC(testSuffixArrayContains);
+  TESTFUNC(testSuffixArrayWildcard);
+  TESTFUNC(testSuffixArrayWildcardEscape);
+  TESTFUNC(testSuffixArrayEmpty);
+});
@@ -0,0 +1,205 @@
+#include "src/trie/trie_type.h"
+#include "src/trie/terms_snapshot.h"
+#include "src/trie/rune_util.h"
+#include "rmutil/alloc.h"
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sys/param.h>
+
+typedef struct {
+  char **terms;
+  size_t n;
+  size_t cap;
+  size_t stopAfter;
+} collected;
+
+static int collectCb(const char *s, size_t n, void *p, void *payload) {
+  collected *c = p;
+  if (c->n == c->cap) {
+    c->cap = c->cap ? c->cap * 2 : 16;
+    c->terms = realloc(c->terms, c->cap * sizeof(*c->terms));
+  }
+  c->terms[c->n++] = strndup(s, n);
+  return c->stopAfter && c->n == c->stopAfter ? REDISEARCH_ERR : REDISEARCH_OK;
+}
+
+static void collectTrie(Trie *t, const char *str, int maxDist, int prefixMode, collected *c) {
+  TrieIterator *it = Trie_Iterate(t, str, strlen(str), maxDist, prefixMode);
+  rune *rstr;
+  t_len slen;
+  float score;
+  int dist;
+  while (it && TrieIterator_Next(it, &rstr, &slen, NULL, &score, &dist)) {
+    size_t len;
+    char *s = runesToStr(rstr, slen, &len);
+    collectCb(s, len, c, NULL);
+    rm_free(s);
+  }
+  if (it) {
+    TrieIterator_Free(it);
+  }
+}
+
+static int cmpStrs(const void *p1, const void *p2) {
+  return strcmp(*(char **)p1, *(char **)p2);
+}
+
+static int sameTerms(collected *c1, collected *c2) {
+  if (c1->n != c2->n) {
+    return 0;
+  } else if (!c1->n) {
+    return 1;
+  }
+  qsort(c1->terms, c1->n, sizeof(char *), cmpStrs);
+  qsort(c2->terms, c2->n, sizeof(char *), cmpStrs);
+  for (size_t ii = 0; ii < c1->n; ++ii) {
+    if (strcmp(c1->terms[ii], c2->terms[ii])) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static void collectedFree(collected *c) {
+  for (size_t ii = 0; ii < c->n; ++ii) {
+    free(c->terms[ii]);
+  }
+  free(c->terms);
+  memset(c, 0, sizeof(*c));
+}
+
+static int levenshtein(const char *s1, const char *s2) {
+  size_t n1, n2;
+  rune *r1 = strToRunes(s1, &n1), *r2 = strToRunes(s2, &n2);
+  int prev[64], row[64];
+  for (size_t jj = 0; jj <= n2; ++jj) {
+    prev[jj] = jj;
+  }
+  for (size_t ii = 0; ii < n1; ++ii) {
+    row[0] = ii + 1;
+    for (size_t jj = 1; jj <= n2; ++jj) {
+      row[jj] = MIN(prev[jj - 1] + (r1[ii] != r2[jj - 1]), MIN(prev[jj], row[jj - 1]) + 1);
+    }
+    memcpy(prev, row, sizeof(row));
+  }
+  rm_free(r1);
+  rm_free(r2);
+  return prev[n2];
+}
+
+static Trie *buildTrie(size_t n) {
+  static const char *syllables[] = {"ba", "be", "co", "da", "el", "fo", "ga", "hi", "ka", "lo"};
+  char buf[64];
+  Trie *t = NewTrie(NULL, Trie_Sort_Lex);
+  srand(1);
+  for (size_t ii = 0; ii < n; ++ii) {
+    buf[0] = '\0';
+    int nsyl = 1 + rand() % 5;
+    for (int jj = 0; jj < nsyl; ++jj) {
+      strcat(buf, syllables[rand() % 10]);
+    }
+    Trie_InsertStringBuffer(t, buf, strlen(buf), 1, 1, NULL);
+  }
+  Trie_InsertStringBuffer(t, "héllo", strlen("héllo"), 1, 1, NULL);
+  Trie_InsertStringBuffer(t, "hello", strlen("hello"), 1, 1, NULL);
+  return t;
+}
+
+int testSnapshotContains() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  ASSERT_EQUAL(t->size, s->numTerms);
+
+  collected all = {0};
+  collectTrie(t, "", 0, 1, &all);
+  for (size_t ii = 0; ii < all.n; ++ii) {
+    ASSERT(TermsSnapshot_Contains(s, all.terms[ii], strlen(all.terms[ii])));
+  }
+  ASSERT(!TermsSnapshot_Contains(s, "", 0));
+  ASSERT(!TermsSnapshot_Contains(s, "zzz", 3));
+  ASSERT(!TermsSnapshot_Contains(s, "aaa", 3));
+  ASSERT(!TermsSnapshot_Contains(s, "hell", 4));
+  ASSERT(TermsSnapshot_MemUsage(s) > 0);
+
+  collectedFree(&all);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSnapshotPrefix() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+
+  const char *prefixes[] = {"", "b", "ba", "baba", "co", "kalo", "lolo", "h", "hé", "z", "bx"};
+  for (size_t ii = 0; ii < sizeof(prefixes) / sizeof(*prefixes); ++ii) {
+    collected expected = {0}, got = {0};
+    collectTrie(t, prefixes[ii], 0, 1, &expected);
+    TermsSnapshot_IteratePrefix(s, prefixes[ii], strlen(prefixes[ii]), collectCb, &got);
+    ASSERT(sameTerms(&expected, &got));
+    collectedFree(&expected);
+    collectedFree(&got);
+  }
+
+  // the callback can stop the iteration
+  collected got = {.stopAfter = 3};
+  TermsSnapshot_IteratePrefix(s, "b", 1, collectCb, &got);
+  ASSERT_EQUAL(3, got.n);
+  collectedFree(&got);
+
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSnapshotFuzzy() {
+  Trie *t = buildTrie(5000);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+
+  const char *words[] = {"baba", "cofo", "hallo", "hillo", "dagaka", "x", "lobeco"};
+  for (size_t ii = 0; ii < sizeof(words) / sizeof(*words); ++ii) {
+    for (int dist = 1; dist <= 2; ++dist) {
+      collected expected = {0}, got = {0};
+      collectTrie(t, words[ii], dist, 0, &expected);
+      // both the trie's automaton and the snapshot yield exactly the terms within the distance
+      for (size_t jj = 0; jj < expected.n; ++jj) {
+        ASSERT(levenshtein(words[ii], expected.terms[jj]) <= dist);
+      }
+      size_t len;
+      rune *runes = strToFoldedRunes(words[ii], &len);
+      TermsSnapshot_IterateFuzzy(s, runes, len, dist, collectCb, &got);
+      rm_free(runes);
+      ASSERT(sameTerms(&expected, &got));
+      collectedFree(&expected);
+      collectedFree(&got);
+    }
+  }
+
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+int testSnapshotEmpty() {
+  Trie *t = NewTrie(NULL, Trie_Sort_Lex);
+  TermsSnapshot *s = NewTermsSnapshot(t);
+  ASSERT_EQUAL(0, s->numTerms);
+  ASSERT(!TermsSnapshot_Contains(s, "foo", 3));
+  collected got = {0};
+  TermsSnapshot_IteratePrefix(s, "", 0, collectCb, &got);
+  ASSERT_EQUAL(0, got.n);
+  TermsSnapshot_Free(s);
+  TrieType_Free(t);
+  return 0;
+}
+
+TEST_MAIN({
+  RMUTil_InitAlloc();
+  TESTFUNC(testSnapshotContains);
+  TESTFUNC(testSnapshotPrefix);
+  TESTFUNC(testSnapshotFuzzy);
+  TESTFUNC(testSnapshotEmpty);
+});
@@ -1,5 +1,6 @@
 
 #include "src/trie/trie.h"
+#include "src/trie/trie_type.h"
 #include "src/trie/levenshtein.h"
 #include "src/trie/rune_util.h"
 #include "libnu/libnu.h"
@@ -324,11 +325,127 @@ int testDFAFilter() {
   return 0;
 }
 
+int testDFACache() {
+  size_t rlen;
+  rune *runes = strToFoldedRunes("hello", &rlen);
+  LevenshteinDFACacheStats before, after;
+  LevenshteinDFA_GetCacheStats(&before);
+
+  LevenshteinDFA *d1 = LevenshteinDFA_Get(runes, rlen, 1);
+  LevenshteinDFA *d2 = LevenshteinDFA_Get(runes, rlen, 1);
+  LevenshteinDFA *d3 = LevenshteinDFA_Get(runes, rlen, 2);
+  ASSERT(d1 == d2);
+  ASSERT(d1 != d3);
+  LevenshteinDFA_GetCacheStats(&after);
+  ASSERT_EQUAL(before.lookups + 3, after.lookups);
+  ASSERT_EQUAL(before.hits + 1, after.hits);
+
+  // filters for the same term share the DFA
+  DFAFilter *fc = NewDFAFilter(runes, rlen, 1, 0);
+  ASSERT(fc->dfa == d1);
+  DFAFilter_Free(fc);
+  rm_free(fc);
+  LevenshteinDFA_Release(d2);
+
+  // evict everything while d1 is still referenced, it must remain usable
+  char buf[32];
+  for (int i = 0; i < 1000; i++) {
+    sprintf(buf, "term%d", i);
+    size_t n;
+    rune *r = strToFoldedRunes(buf, &n);
+    LevenshteinDFA_Release(LevenshteinDFA_Get(r, n, 1));
+    rm_free(r);
+  }
+  LevenshteinDFA_GetCacheStats(&after);
+  ASSERT(after.size < 1000);
+  dfaNode *root;
+  Vector_Get(d1->nodes, 0, &root);
+  ASSERT(root->distance == 0);
+  ASSERT_EQUAL(1, d1->maxDist);
+  LevenshteinDFA_Release(d1);
+  LevenshteinDFA_Release(d3);
+
+  LevenshteinDFA_ClearCache();
+  LevenshteinDFA_GetCacheStats(&after);
+  ASSERT_EQUAL(0, after.size);
+  rm_free(runes);
+  return 0;
+}
+
+typedef struct {
+  char terms[8][16];
+  int n;
+} topTerms;
+
+static int topTermsCb(const rune *r, size_t n, void *p, void *payload) {
+  topTerms *top = p;
+  size_t len;
+  char *s = runesToStr(r, n, &len);
+  strcpy(top->terms[top->n++], s);
+  rm_free(s);
+  return top->n == 8 ? REDISEARCH_ERR : REDISEARCH_OK;
+}
+
+static int countTermsCb(const rune *r, size_t n, void *p, void *payload) {
+  ++*(size_t *)p;
+  return REDISEARCH_OK;
+}
+
+int testTopPrefix() {
+  Trie *t = NewTrie(NULL, Trie_Sort_Lex);
+  char buf[16];
+  for (int i = 0; i < 1000; i++) {
+    sprintf(buf, "term%d", i);
+    Trie_InsertStringBuffer(t, buf, strlen(buf), 1, 0, NULL);
+  }
+  // raise some scores after the insertion, the way document frequencies grow
+  Trie_InsertStringBuffer(t, "term999", 7, 50, 0, NULL);
+  Trie_InsertStringBuffer(t, "term12", 6, 40, 0, NULL);
+  Trie_InsertStringBuffer(t, "term500", 7, 30, 0, NULL);
+  Trie_InsertStringBuffer(t, "other", 5, 100, 0, NULL);
+
+  size_t rlen;
+  rune *prefix = strToFoldedRunes("term", &rlen);
+  topTerms top = {0};
+  Trie_IterateTopPrefix(t, prefix, rlen, 3, topTermsCb, &top, NULL);
+  ASSERT_EQUAL(3, top.n);
+  ASSERT_STRING_EQ("term999", top.terms[0]);
+  ASSERT_STRING_EQ("term12", top.terms[1]);
+  ASSERT_STRING_EQ("term500", top.terms[2]);
+
+  // the callback can stop the iteration
+  memset(&top, 0, sizeof(top));
+  Trie_IterateTopPrefix(t, prefix, rlen, 100, topTermsCb, &top, NULL);
+  ASSERT_EQUAL(8, top.n);
+  rm_free(prefix);
+
+  // when fewer terms than asked for start with the prefix, all of them are passed
+  prefix = strToFoldedRunes("term99", &rlen);
+  size_t count = 0;
+  Trie_IterateTopPrefix(t, prefix, rlen, 100, countTermsCb, &count, NULL);
+  ASSERT_EQUAL(11, count);
+  rm_free(prefix);
+
+  // deleted terms no longer count, and the bounds are recomputed
+  Trie_Delete(t, "term999", 7);
+  prefix = strToFoldedRunes("term9", &rlen);
+  memset(&top, 0, sizeof(top));
+  Trie_IterateTopPrefix(t, prefix, rlen, 1, topTermsCb, &top, NULL);
+  ASSERT_EQUAL(1, top.n);
+  ASSERT(strcmp("term999", top.terms[0]));
+  rm_free(prefix);
+
+  TrieType_Free(t);
+  return 0;
+}
+
 TEST_MAIN({
   RMUTil_InitAlloc();
   TESTFUNC(testRuneUtil);
   TESTFUNC(testDFAFilter);
+  TESTFUNC(testDFACache);
   TESTFUNC(testTrie);
   TESTFUNC(testPayload);
   TESTFUNC(testUnicode);
+  TESTFUNC(testTopPrefix);
 });
@@ -2399,6 +2399,25 @@ def testPrefixDeletedExpansions(env):
     r = env.cmd('ft.search', 'idx', '@txt1:term* @tag1:{tag*}')
     env.assertEqual(toSortedFlatList([1, 'doc_XXX', ['txt1', 'termZZZ', 'tag1', 'tagZZZ']]), toSortedFlatList(r))
 
+def testPrefixExpansionPrefersFrequentTerms(env):
+    env.skipOnCluster()
+    conn = getConnectionByEnv(env)
+    env.cmd('ft.config', 'set', 'MAXPREFIXEXPANSIONS', 10)
+    env.expect('ft.create', 'idx', 'ON', 'HASH', 'schema', 't', 'text').ok()
+
+    for i in range(100):
+        conn.execute_command('hset', 'doc%d' % i, 't', 'term%02d' % i)
+    for i in range(20):
+        conn.execute_command('hset', 'freq%d' % i, 't', 'term99')
+
+    # the frequent term is expanded along with 9 of the others, instead of the first 10 terms
+    env.expect('ft.search', 'idx', 'term*', 'nocontent', 'limit', 0, 0).equal([30])
+    env.expect('ft.search', 'idx', 'term9*', 'nocontent', 'limit', 0, 0).equal([30])
+    # under the cap, all the terms are expanded
+    env.expect('ft.search', 'idx', 'term1*', 'nocontent', 'limit', 0, 0).equal([10])
+
+    env.cmd('ft.config', 'set', 'MAXPREFIXEXPANSIONS', 200)
+
 
 def testOptionalFilter(env):
     env.cmd('ft.create', 'idx', 'ON', 'HASH', 'schema', 't1', 'text')
@@ -21,6 +21,16 @@ def testInfo(env):
     env.assertGreater(float(idx_info['key_table_size_mb']), 0)
     env.assertGreater(float(idx_info['vector_index_sz_mb']), 0)
 
+    # The vector index stats of every shard are merged per vector field
+    stats = idx_info['vector_index_stats']
+    env.assertEqual(len(stats), 1)
+    stats = to_dict(stats[0])
+    env.assertEqual(stats['attribute'], 'v')
+    env.assertEqual(stats['algorithm'], 'HNSW')
+    env.assertEqual(stats['num_vectors'], 100)
+    env.assertGreater(float(stats['memory_sz_mb']), 0)
+    env.assertGreater(float(stats['bytes_per_vector_avg']), 0)
+
 def test_required_fields(env):
     # Testing coordinator<-> shard `_REQUIRED_FIELDS` protocol
     env.skipOnCluster()
@@ -596,6 +596,40 @@ def testWrongFieldType(env):
     res_actual = {res_actual[i]: res_actual[i + 1] for i in range(0, len(res_actual), 2)}
     env.assertEqual(str(res_actual['hash_indexing_failures']), '1')
 
+def runInitialScanBatches(env):
+    # the initial scan indexes documents in batches, check that every document and every
+    # failure is accounted for, with more documents than a single batch
+    conn = getConnectionByEnv(env)
+    num_docs = 1000
+    for i in range(num_docs):
+        n = 'bad' if i % 100 == 0 else str(i)
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'hello world%d' % i, 'tag', 'tag%d' % (i % 10), 'n', n)
+
+    env.expect('FT.CREATE idx SCHEMA t TEXT tag TAG n NUMERIC').ok()
+    waitForIndex(env, 'idx')
+
+    res_actual = env.cmd('FT.INFO idx')
+    res_actual = {res_actual[i]: res_actual[i + 1] for i in range(0, len(res_actual), 2)}
+    env.assertEqual(str(res_actual['num_docs']), '990')
+    env.assertEqual(str(res_actual['hash_indexing_failures']), '10')
+
+    env.assertEqual(env.cmd('FT.SEARCH idx hello LIMIT 0 0'), [990])
+    env.assertEqual(env.cmd('FT.SEARCH idx @tag:{tag1} LIMIT 0 0'), [100])
+    env.assertEqual(env.cmd('FT.SEARCH idx @n:[0 99] LIMIT 0 0'), [99])
+    for i in (1, 123, 777, 999):
+        env.assertEqual(toSortedFlatList(env.cmd('FT.SEARCH idx world%d' % i)),
+                        toSortedFlatList([1, 'doc%d' % i, ['t', 'hello world%d' % i, 'tag', 'tag%d' % (i % 10), 'n', str(i)]]))
+
+def testInitialScanBatches(env):
+    runInitialScanBatches(env)
+
+def testInitialScanBatchesConcurrent():
+    # with worker threads, the documents of each batch are preprocessed in parallel
+    env = Env(moduleArgs='CONCURRENT_WRITE_MODE')
+    if not env.isCluster():
+        env.assertEqual(env.cmd('FT.CONFIG', 'GET', 'CONCURRENT_WRITE_MODE'), [['CONCURRENT_WRITE_MODE', 'true']])
+    runInitialScanBatches(env)
+
 def testDocIndexedInTwoIndexes():
     env = Env(moduleArgs='MAXDOCTABLESIZE 50')
     env.skipOnCluster()
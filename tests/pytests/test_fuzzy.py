@@ -30,6 +30,18 @@ def testLdLimit(env):
     env.assertEqual([0], env.cmd('ft.search', 'idx', r'%sword%'))  # should return nothing
     env.assertEqual([1, 'doc1', ['title', 'hello world']], env.cmd('ft.search', 'idx', r'%%sword%%'))
 
+def testLdExact(env):
+    # 'helo' is within one edit of 'hello', but 'helol' is two edits away
+    env.cmd('FT.CREATE', 'idx', 'ON', 'HASH', 'SCHEMA', 't', 'TEXT', 'NOSTEM')
+    env.cmd('HSET', 'doc1', 't', 'hello')
+    env.cmd('HSET', 'doc2', 't', 'helo')
+    env.cmd('HSET', 'doc3', 't', 'helol')
+    res = env.cmd('FT.SEARCH', 'idx', '%hello%', 'NOCONTENT')
+    env.assertEqual(res[0], 2)
+    env.assertEqual(sorted(res[1:]), ['doc1', 'doc2'])
+    res = env.cmd('FT.SEARCH', 'idx', '%%hello%%', 'NOCONTENT')
+    env.assertEqual(res[0], 3)
+
 def testStopwords(env):
     env.cmd('ft.create', 'idx', 'ON', 'HASH', 'schema', 't1', 'text')
     for t in ('iwth', 'ta', 'foo', 'rof', 'whhch', 'witha'):
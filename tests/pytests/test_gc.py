@@ -287,3 +287,94 @@ def testAutoMemory_MOD_3951():
     env.expect('FT.ALTER', 'idx', 'SCHEMA', 'ADD', '2nd', 'TEXT').equal('OK')
 
     # This test should catch some leaks on the sanitizer
+
+def testGCTermsSnapshot(env):
+    if env.env == 'existing-env' or env.env == 'enterprise' or env.isCluster():
+        env.skip()
+
+    env = Env(moduleArgs='GC_POLICY FORK TERMS_SNAPSHOT true')
+    conn = getConnectionByEnv(env)
+    env.expect('FT.CREATE', 'idx', 'ON', 'HASH', 'SCHEMA', 't', 'TEXT').ok()
+
+    for i in range(2000):
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'term%d' % i)
+    env.assertEqual(float(index_info(env, 'idx')['terms_snapshot_size_mb']), 0)
+
+    prefix_res = env.cmd('FT.SEARCH', 'idx', 'term12*', 'NOCONTENT', 'LIMIT', 0, 0)
+    env.assertEqual(prefix_res, [111])
+
+    # the GC builds the snapshot once the index has enough terms
+    forceInvokeGC(env, 'idx')
+    env.assertGreater(float(index_info(env, 'idx')['terms_snapshot_size_mb']), 0)
+    env.expect('FT.SEARCH', 'idx', 'term12*', 'NOCONTENT', 'LIMIT', 0, 0).equal(prefix_res)
+    env.expect('FT.SEARCH', 'idx', '%term1999x%', 'NOCONTENT').equal([1, 'doc1999'])
+
+    # terms added after the snapshot was built are still expanded, exactly once
+    conn.execute_command('HSET', 'new', 't', 'term12x')
+    env.expect('FT.SEARCH', 'idx', 'term12*', 'NOCONTENT', 'LIMIT', 0, 0).equal([112])
+    env.expect('FT.SEARCH', 'idx', '%%term12xyz%%', 'NOCONTENT').equal([1, 'new'])
+
+def testGCTermsSnapshotDisabled(env):
+    if env.env == 'existing-env' or env.env == 'enterprise' or env.isCluster():
+        env.skip()
+
+    # without TERMS_SNAPSHOT the terms are only kept in the trie
+    env = Env(moduleArgs='GC_POLICY FORK')
+    conn = getConnectionByEnv(env)
+    env.expect('FT.CREATE', 'idx', 'ON', 'HASH', 'SCHEMA', 't', 'TEXT').ok()
+    for i in range(2000):
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'term%d' % i)
+    forceInvokeGC(env, 'idx')
+    env.assertEqual(float(index_info(env, 'idx')['terms_snapshot_size_mb']), 0)
+    env.expect('FT.SEARCH', 'idx', 'term12*', 'NOCONTENT', 'LIMIT', 0, 0).equal([111])
+
+def testGCSuffixArray(env):
+    if env.env == 'existing-env' or env.env == 'enterprise' or env.isCluster():
+        env.skip()
+
+    env = Env(moduleArgs='GC_POLICY FORK SUFFIX_ARRAY true')
+    conn = getConnectionByEnv(env)
+    env.expect('FT.CREATE', 'idx', 'ON', 'HASH', 'SCHEMA', 't', 'TEXT', 'WITHSUFFIXTRIE').ok()
+
+    for i in range(2000):
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'term%d' % i)
+
+    queries = ['*99*', '*99', "w'term1?99'", "w'*9?9'", "w'te\\rm1?99'"]
+    # before the GC builds the suffix array, the suffix trie serves the queries
+    env.assertGreater(len(env.cmd('FT.DEBUG', 'DUMP_SUFFIX_TRIE', 'idx')), 0)
+    expected = [env.cmd('FT.SEARCH', 'idx', q, 'NOCONTENT', 'LIMIT', 0, 0) for q in queries]
+    env.assertEqual(expected[0], [len([i for i in range(2000) if '99' in str(i)])])
+    env.assertEqual(expected[1], [20])
+    env.assertEqual(expected[2], [10])
+    # an escaped character is a literal
+    env.assertEqual(expected[4], expected[2])
+    env.assertEqual(float(index_info(env, 'idx')['suffix_array_size_mb']), 0)
+
+    forceInvokeGC(env, 'idx')
+    env.assertGreater(float(index_info(env, 'idx')['suffix_array_size_mb']), 0)
+    env.expect('FT.DEBUG', 'DUMP_SUFFIX_TRIE', 'idx').error().contains('Index does not have suffix trie')
+    for q, res in zip(queries, expected):
+        env.expect('FT.SEARCH', 'idx', q, 'NOCONTENT', 'LIMIT', 0, 0).equal(res)
+
+    # terms added after the suffix array was built are still found, exactly once
+    conn.execute_command('HSET', 'new', 't', 'term99new')
+    conn.execute_command('HSET', 'doc99', 't', 'term99 term99new')
+    res = env.cmd('FT.SEARCH', 'idx', '*99ne*', 'NOCONTENT')
+    env.assertEqual(res[0], 2)
+    env.assertEqual(sorted(res[1:]), ['doc99', 'new'])
+    env.expect('FT.SEARCH', 'idx', '*99*', 'NOCONTENT', 'LIMIT', 0, 0).equal([expected[0][0] + 1])
+
+def testGCSuffixArraySmallIndex(env):
+    if env.env == 'existing-env' or env.env == 'enterprise' or env.isCluster():
+        env.skip()
+
+    # too few terms for the suffix array, the suffix trie keeps serving contains queries
+    env = Env(moduleArgs='GC_POLICY FORK SUFFIX_ARRAY true')
+    conn = getConnectionByEnv(env)
+    env.expect('FT.CREATE', 'idx', 'ON', 'HASH', 'SCHEMA', 't', 'TEXT', 'WITHSUFFIXTRIE').ok()
+    for i in range(100):
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'term%d' % i)
+    forceInvokeGC(env, 'idx')
+    env.assertEqual(float(index_info(env, 'idx')['suffix_array_size_mb']), 0)
+    env.assertGreater(len(env.cmd('FT.DEBUG', 'DUMP_SUFFIX_TRIE', 'idx')), 0)
+    env.expect('FT.SEARCH', 'idx', '*m9*', 'NOCONTENT', 'LIMIT', 0, 0).equal([11])
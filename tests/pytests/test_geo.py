@@ -127,3 +127,89 @@ def testGeoDistanceFile(env):
               'APPLY', 'geodistance(@location,-0.15036,51.50566)', 'AS', 'distance',
               'GROUPBY', '1', '@distance',
               'SORTBY', 2, '@distance', 'ASC').equal(res)
+
+def testGeoFilterShapes(env):
+  conn = getConnectionByEnv(env)
+  env.expect('FT.CREATE idx SCHEMA g GEO').ok()
+  conn.execute_command('HSET', 'a', 'g', '1,1')
+  conn.execute_command('HSET', 'b', 'g', '2,2')
+  conn.execute_command('HSET', 'c', 'g', '2,1')
+  conn.execute_command('HSET', 'd', 'g', '10,10')
+
+  def search(*args):
+    res = env.cmd('FT.SEARCH', 'idx', '*', 'NOCONTENT', 'GEOFILTER', 'g', *args)
+    return sorted(res[1:])
+
+  env.assertEqual(search('BBOX', 0, 0, 3, 3), ['a', 'b', 'c'])
+  env.assertEqual(search('BBOX', 1.5, 0, 3, 3), ['b', 'c'])
+  env.assertEqual(search('BBOX', 5, 5, 6, 6), [])
+  env.assertEqual(search('BBOX', -180, -80, 180, 80), ['a', 'b', 'c', 'd'])
+
+  # a triangle whose bounding box holds 'b', but the triangle does not
+  env.assertEqual(search('POLYGON', 3, 0, 0, 3, 0, 0.5, 3), ['a', 'c'])
+  # a concave polygon whose notch holds 'b'
+  env.assertEqual(search('POLYGON', 5, 0, 0, 3, 0, 3, 3, 1.5, 1.2, 0, 3), ['a', 'c'])
+  env.assertEqual(search('POLYGON', 4, 9, 9, 11, 9, 11, 11, 9, 11), ['d'])
+
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'BBOX', 0, 0, 3).error() \
+     .contains('GEOFILTER BBOX requires 4 arguments')
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'BBOX', 3, 3, 0, 0).error() \
+     .contains('Invalid GeoFilter bounding box')
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'POLYGON', 2, 0, 0, 1, 1).error() \
+     .contains('at least 3 vertices')
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'POLYGON', 3, 0, 0, 1, 1).error() \
+     .contains('expects 6 coordinates')
+
+def testGeoFilterNearest(env):
+  conn = getConnectionByEnv(env)
+  env.expect('FT.CREATE idx SCHEMA g GEO t TAG').ok()
+  # points spread along the equator, one degree is about 111 km
+  for i in range(1, 21):
+    conn.execute_command('HSET', 'doc%d' % i, 'g', '%d,0' % i, 't', 'even' if i % 2 == 0 else 'odd')
+
+  res = env.cmd('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'NEAREST', 3, 0, 0,
+                'SORTBY', '__g_distance', 'RETURN', 1, '__g_distance')
+  env.assertEqual(res[0], 3)
+  env.assertEqual(res[1::2], ['doc1', 'doc2', 'doc3'])
+  env.assertAlmostEqual(float(res[2][1]), 111195, delta=1)
+
+  # the nearest documents are searched among the query's results
+  res = env.cmd('FT.SEARCH', 'idx', '@t:{even}', 'GEOFILTER', 'g', 'NEAREST', 2, 11.1, 0, 'AS', 'dist',
+                'SORTBY', 'dist', 'NOCONTENT')
+  env.assertEqual(res, [2, 'doc12', 'doc10'])
+
+  # asking for more documents than there are returns all of them
+  res = env.cmd('FT.SEARCH', 'idx', '@t:{odd}', 'GEOFILTER', 'g', 'NEAREST', 100, 0, 0, 'NOCONTENT', 'LIMIT', 0, 0)
+  env.assertEqual(res, [10])
+
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'NEAREST', 0, 0, 0).error()
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'NEAREST', 2, 0, 100).error() \
+     .contains('Invalid GeoFilter lat/lon')
+
+def testGeoFilterNearestKnn(env):
+  conn = getConnectionByEnv(env)
+  env.expect('FT.CREATE idx SCHEMA g GEO v VECTOR FLAT 6 TYPE FLOAT32 DIM 2 DISTANCE_METRIC L2').ok()
+  conn.execute_command('HSET', 'doc1', 'g', '1,0', 'v', np.array([1, 0], dtype=np.float32).tobytes())
+
+  # a KNN query orders its own results, so it cannot be narrowed to the nearest documents
+  env.expect('FT.SEARCH', 'idx', '*=>[KNN 1 @v $b]', 'PARAMS', 2, 'b', np.array([0, 0], dtype=np.float32).tobytes(),
+             'GEOFILTER', 'g', 'NEAREST', 1, 0, 0, 'DIALECT', 2).error() \
+     .contains('GEOFILTER NEAREST cannot be combined with a KNN query')
+
+def testGeoFilterNearestTimeout(env):
+  env.skipOnCluster()
+  conn = getConnectionByEnv(env)
+  env.expect('FT.CREATE idx SCHEMA g GEO').ok()
+  # more documents than asked for are never found, so every radius up to the whole earth is scanned
+  n = 50000
+  pl = conn.pipeline(transaction=False)
+  for i in range(n):
+    pl.execute_command('HSET', 'doc%d' % i, 'g', '%f,%f' % ((i % 250) / 1000.0, (i // 250) / 1000.0))
+  pl.execute()
+
+  res = env.cmd('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'NEAREST', 2 * n, 0, 0, 'LIMIT', 0, 0, 'TIMEOUT', 0)
+  env.assertEqual(res, [n])
+
+  env.expect('FT.CONFIG', 'SET', 'ON_TIMEOUT', 'FAIL').ok()
+  env.expect('FT.SEARCH', 'idx', '*', 'GEOFILTER', 'g', 'NEAREST', 2 * n, 0, 0, 'LIMIT', 0, 0, 'TIMEOUT', 1).error() \
+     .contains('Timeout limit was reached')
@@ -125,3 +125,31 @@ def testInfoModulesAfterReload(env):
     env.assertEqual(fieldsInfo['search_fields_numeric'], 'Numeric=1,Sortable=1')
     env.assertEqual(fieldsInfo['search_fields_geo'], 'Geo=1,Sortable=1,NoIndex=1')
     env.assertEqual(fieldsInfo['search_fields_tag'], 'Tag=1,NoIndex=1')
+
+
+def testInfoModulesStemmerCache(env):
+  conn = env.getConnection()
+  env.expect('FT.CREATE', 'idx', 'SCHEMA', 'body', 'TEXT').ok()
+  conn.execute_command('HSET', 'doc1', 'body', 'running worlds going')
+
+  info = info_modules_to_dict(conn)
+  stemInfo = info['search_stemmer_cache']
+  for field in ['lookups', 'hits', 'skipped', 'hit_rate']:
+    env.assertTrue('search_' + field in stemInfo)
+  env.assertLessEqual(int(stemInfo['search_hits']), int(stemInfo['search_lookups']))
+
+
+def testInfoModulesFuzzyDFACache(env):
+  conn = env.getConnection()
+  env.expect('FT.CREATE', 'idx', 'SCHEMA', 'body', 'TEXT').ok()
+  conn.execute_command('HSET', 'doc1', 'body', 'hello world')
+
+  before = info_modules_to_dict(conn)['search_fuzzy_dfa_cache']
+  for _ in range(3):
+    env.expect('FT.SEARCH', 'idx', '%hallo%', 'NOCONTENT').equal([1, 'doc1'])
+  after = info_modules_to_dict(conn)['search_fuzzy_dfa_cache']
+
+  # only the first query builds the DFA, the others reuse it
+  env.assertGreaterEqual(int(after['search_lookups']) - int(before['search_lookups']), 3)
+  env.assertGreaterEqual(int(after['search_hits']) - int(before['search_hits']), 2)
+  env.assertGreater(int(after['search_cached_dfas']), 0)
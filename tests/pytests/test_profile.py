@@ -315,6 +315,48 @@ def testProfileVector(env):
   env.assertEqual(env.cmd("FT.DEBUG", "VECSIM_INFO", "idx", "v")[-1], 'HYBRID_BATCHES_TO_ADHOC_BF')
 
 
+def testProfileVectorVerbose(env):
+  env.skipOnCluster()
+  conn = getConnectionByEnv(env)
+  env.cmd('FT.CONFIG', 'SET', '_PRINT_PROFILE_CLOCK', 'true')
+  env.cmd('FT.CONFIG', 'SET', 'DEFAULT_DIALECT', '2')
+
+  env.expect('FT.CREATE idx SCHEMA v VECTOR FLAT 6 TYPE FLOAT32 DIM 2 DISTANCE_METRIC L2 t TEXT').ok()
+  conn.execute_command('hset', '1', 'v', 'bababaca', 't', "hello")
+  conn.execute_command('hset', '2', 'v', 'babababa', 't', "hello")
+  conn.execute_command('hset', '3', 'v', 'aabbaabb', 't', "hello")
+  conn.execute_command('hset', '4', 'v', 'bbaabbaa', 't', "hello world")
+  conn.execute_command('hset', '5', 'v', 'aaaabbbb', 't', "hello world")
+
+  actual_res = conn.execute_command('ft.profile', 'idx', 'search', 'query', '*=>[KNN 3 @v $vec]',
+                                    'SORTBY', '__v_score', 'PARAMS', '2', 'vec', 'aaaaaaaa', 'nocontent')
+  vector_res = to_dict(actual_res[1][3][1])
+  env.assertEqual(vector_res['Search mode'], 'STANDARD_KNN')
+  env.assertEqual(vector_res['Vectors fetched'], 3)
+  env.assertFalse('Child rewinds' in vector_res)
+
+  # Ad-hoc BF computes the distance of every child result, reading the child once
+  actual_res = conn.execute_command('ft.profile', 'idx', 'search', 'query', '(@t:hello world)=>[KNN 3 @v $vec]',
+                                    'SORTBY', '__v_score', 'PARAMS', '2', 'vec', 'aaaaaaaa', 'nocontent')
+  vector_res = to_dict(actual_res[1][3][1])
+  env.assertEqual(vector_res['Search mode'], 'HYBRID_ADHOC_BF')
+  env.assertEqual(vector_res['Vectors fetched'], 0)
+  env.assertEqual(vector_res['Distance computations'], 2)
+  env.assertEqual(vector_res['Heap insertions'], 2)
+  env.assertEqual(vector_res['Child rewinds'], 0)
+  env.assertTrue('Ad-hoc BF time' in vector_res)
+  env.assertFalse('Batches time' in vector_res)
+
+  # FT.INFO reports the vector index of every vector field
+  stats = to_dict(env.cmd('FT.INFO', 'idx'))['vector_index_stats']
+  env.assertEqual(len(stats), 1)
+  stats = to_dict(stats[0])
+  env.assertEqual(stats['attribute'], 'v')
+  env.assertEqual(stats['algorithm'], 'FLAT')
+  env.assertEqual(stats['num_vectors'], 5)
+  env.assertGreater(float(stats['bytes_per_vector_avg']), 0)
+
+
 def testResultProcessorCounter(env):
   env.skipOnCluster()
   conn = getConnectionByEnv(env)
@@ -68,6 +68,18 @@ def testBasicSpellCheck():
         env.expect('ft.spellcheck', 'idx', '@body:name').equal([['TERM', 'name', [['0.66666666666666663', 'name2']]]])
 
 
+def testSpellCheckDistanceExact():
+    env = Env()
+    env.cmd('ft.create', 'idx', 'ON', 'HASH', 'SCHEMA', 'body', 'TEXT', 'NOSTEM')
+    waitForIndex(env, 'idx')
+    # 'help' is within one edit of 'hellp', but 'helpl' is two edits away
+    env.cmd('HSET', 'doc1', 'body', 'help')
+    env.cmd('HSET', 'doc2', 'body', 'helpl')
+    env.expect('ft.spellcheck', 'idx', 'hellp').equal([['TERM', 'hellp', [['0.5', 'help']]]])
+    res = env.cmd('ft.spellcheck', 'idx', 'hellp', 'DISTANCE', 2)
+    env.assertEqual(sorted(s[1] for s in res[0][2]), ['help', 'helpl'])
+
+
 def testBasicSpellCheckWithNoResult():
     env = Env()
     env.cmd('ft.create', 'idx', 'ON', 'HASH', 'SCHEMA', 'name', 'TEXT', 'body', 'TEXT')
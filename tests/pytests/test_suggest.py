@@ -49,6 +49,14 @@ def testSuggestions(env):
 
     r.expect('ft.SUGGET', 'ac', 'hello').equal(['hello werld'])
 
+def testSuggestFuzzyPrefix(env):
+    skipOnCrdtEnv(env)
+    # FUZZY matches prefixes of the suggestions, so 'helol' is kept through its prefix 'helo',
+    # one edit away from 'hello', even though the whole string is two edits away
+    for sug in ['hello world', 'helol', 'help me']:
+        env.expect('ft.SUGADD', 'ac', sug, 1).noError()
+    env.assertEqual(sorted(env.cmd('ft.SUGGET', 'ac', 'hello', 'FUZZY')), ['hello world', 'helol'])
+
 def testSuggestErrors(env):
     skipOnCrdtEnv(env)
     env.expect('ft.SUGADD ac olah 1').equal(1)
@@ -128,3 +136,28 @@ def testIssue_490(env):
     env.expect('ft.sugget', 'sug', 'Redis', 'WITHPAYLOADS').equal(['RediSearch', 'RediSearch, an awesome search engine'])
     env.expect('ft.sugadd', 'sug', 'RediSearch', '1', 'INCR', 'PAYLOAD', 'RediSearch 2.0, next gen search engine').equal(1)
     env.expect('ft.sugget', 'sug', 'Redis', 'WITHPAYLOADS').equal(['RediSearch', 'RediSearch 2.0, next gen search engine'])
+
+def testSuggestRepeatedPrefix(env):
+    # the results of a repeated prefix are cached, and must follow every change to the dictionary
+    skipOnCrdtEnv(env)
+    for i in range(5):
+        env.expect('ft.sugadd', 'sug', 'hello%d' % i, i + 1).equal(i + 1)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3).equal(['hello4', 'hello3', 'hello2'])
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3).equal(['hello4', 'hello3', 'hello2'])
+
+    env.expect('ft.sugadd', 'sug', 'hello0', 10, 'INCR').equal(5)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3).equal(['hello0', 'hello4', 'hello3'])
+
+    env.expect('ft.sugadd', 'sug', 'help', 20, 'PAYLOAD', 'foo').equal(6)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3, 'WITHPAYLOADS').equal(
+        ['help', 'foo', 'hello0', None, 'hello4', None])
+    env.expect('ft.sugadd', 'sug', 'help', 20, 'PAYLOAD', 'bar').equal(6)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3, 'WITHPAYLOADS').equal(
+        ['help', 'bar', 'hello0', None, 'hello4', None])
+
+    env.expect('ft.sugdel', 'sug', 'help').equal(1)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3).equal(['hello0', 'hello4', 'hello3'])
+    env.expect('ft.sugadd', 'sug', 'hello4', 1).equal(5)
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 3).equal(['hello0', 'hello3', 'hello2'])
+    env.expect('ft.sugget', 'sug', 'hel', 'MAX', 10).equal(['hello0', 'hello3', 'hello2', 'hello1', 'hello4'])
+    env.expect('ft.sugget', 'sug', 'helo', 'FUZZY', 'MAX', 3).equal(['hello0', 'hello3', 'hello2'])
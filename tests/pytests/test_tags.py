@@ -279,6 +279,28 @@ def testTagGCClearEmpty(env):
     env.expect('FT.SEARCH', 'idx', '@t:{foo}')  \
         .equal([2, 'doc4', ['t', 'foo'], 'doc5', ['t', 'foo']])
 
+def testTagGCClearEmptyAfterPrefix(env):
+    env.skipOnCluster()
+
+    conn = getConnectionByEnv(env)
+    conn.execute_command('FT.CONFIG', 'SET', 'FORK_GC_CLEAN_THRESHOLD', '0')
+    conn.execute_command('FT.CREATE', 'idx', 'SCHEMA', 't', 'TAG')
+    conn.execute_command('HSET', 'doc1', 't', 'foo')
+    conn.execute_command('HSET', 'doc2', 't', 'foobar')
+    conn.execute_command('HSET', 'doc3', 't', 'bar')
+
+    # a prefix query builds the sorted view of the values, which shares their inverted indexes
+    res = env.cmd('FT.SEARCH', 'idx', '@t:{foo*}', 'NOCONTENT')
+    env.assertEqual(res[0], 2)
+    env.assertEqual(sorted(res[1:]), ['doc1', 'doc2'])
+
+    # the GC removes the emptied value from both, and the drop frees the rest once
+    conn.execute_command('DEL', 'doc2')
+    forceInvokeGC(env, 'idx')
+    env.expect('FT.DEBUG', 'DUMP_TAGIDX', 'idx', 't').equal([['bar', [3]], ['foo', [1]]])
+    env.expect('FT.SEARCH', 'idx', '@t:{foo*}', 'NOCONTENT').equal([1, 'doc1'])
+    env.expect('FT.DROPINDEX', 'idx').ok()
+
 def testTagGCClearEmptyWithCursor(env):
     env.skipOnCluster()
 
@@ -364,3 +386,50 @@ def testEmptyTagLeak(env):
         pl.execute()
     forceInvokeGC(env, 'idx')
     env.expect('FT.DEBUG', 'DUMP_TAGIDX', 'idx', 't').equal([])
+
+def testTagGroupByColumn(env):
+    conn = getConnectionByEnv(env)
+    env.expect('FT.CREATE', 'idx', 'SCHEMA', 't', 'TAG', 'n', 'NUMERIC').ok()
+    # 'Foo' and ' bar' are not identical to their indexed tags, and 'x,y' holds two tags,
+    # so those documents must still be loaded and grouped by their raw value
+    values = ['foo', 'foo', 'bar', 'Foo', ' bar', 'x,y', 'foo']
+    for i, v in enumerate(values):
+        conn.execute_command('HSET', 'doc%d' % i, 't', v, 'n', i)
+
+    res = env.cmd('FT.AGGREGATE', 'idx', '*', 'GROUPBY', '1', '@t',
+                  'REDUCE', 'COUNT', '0', 'AS', 'count', 'SORTBY', '2', '@t', 'ASC')
+    env.assertEqual(res[1:], [['t', ' bar', 'count', '1'], ['t', 'Foo', 'count', '1'],
+                              ['t', 'bar', 'count', '1'], ['t', 'foo', 'count', '3'],
+                              ['t', 'x,y', 'count', '1']])
+
+    res = env.cmd('FT.AGGREGATE', 'idx', '*', 'LOAD', '1', '@t', 'FILTER', '@t=="foo"',
+                  'GROUPBY', '0', 'REDUCE', 'COUNT', '0', 'AS', 'count')
+    env.assertEqual(res[1:], [['count', '3']])
+
+    # rows are grouped by the value they hold, even when a step replaced the document's value
+    res = env.cmd('FT.AGGREGATE', 'idx', '*', 'LOAD', '1', '@t', 'APPLY', 'upper(@t)', 'AS', 't',
+                  'GROUPBY', '1', '@t', 'REDUCE', 'COUNT', '0', 'AS', 'count', 'SORTBY', '2', '@t', 'ASC')
+    env.assertEqual(res[1:], [['t', ' BAR', 'count', '1'], ['t', 'BAR', 'count', '1'],
+                              ['t', 'FOO', 'count', '4'], ['t', 'X,Y', 'count', '1']])
+
+def testTagGroupByColumnAfterGC(env):
+    env.skipOnCluster()
+    conn = getConnectionByEnv(env)
+    conn.execute_command('FT.CONFIG', 'SET', 'FORK_GC_CLEAN_THRESHOLD', '0')
+    env.expect('FT.CREATE', 'idx', 'SCHEMA', 't', 'TAG').ok()
+    for i in range(100):
+        conn.execute_command('HSET', 'doc%d' % i, 't', 'old%d' % (i % 10))
+    conn.execute_command('HSET', 'keep', 't', 'keep')
+
+    # the GC removes the values left without documents, and their ids are taken by new values
+    for i in range(100):
+        conn.execute_command('DEL', 'doc%d' % i)
+    forceInvokeGC(env, 'idx')
+    env.expect('FT.DEBUG', 'DUMP_TAGIDX', 'idx', 't').equal([['keep', [101]]])
+    for i in range(30):
+        conn.execute_command('HSET', 'new%d' % i, 't', 'new%d' % (i % 3))
+
+    res = env.cmd('FT.AGGREGATE', 'idx', '*', 'GROUPBY', '1', '@t',
+                  'REDUCE', 'COUNT', '0', 'AS', 'count', 'SORTBY', '2', '@t', 'ASC')
+    env.assertEqual(res[1:], [['t', 'keep', 'count', '1'], ['t', 'new0', 'count', '10'],
+                              ['t', 'new1', 'count', '10'], ['t', 'new2', 'count', '10']])
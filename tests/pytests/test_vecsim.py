@@ -1172,6 +1172,45 @@ def test_hybrid_query_with_global_filters():
                'NOCONTENT', 'PARAMS', 2, 'vec_param', query_data.tobytes()).equal(expected_res)
 
 
+def test_hybrid_query_filtered_batches():
+    env = Env(moduleArgs='DEFAULT_DIALECT 2')
+    conn = getConnectionByEnv(env)
+    dim = 2
+    index_size = 1000
+    env.expect('FT.CREATE', 'idx', 'SCHEMA', 'v', 'VECTOR', 'FLAT', '6', 'TYPE', 'FLOAT32',
+               'DIM', dim, 'DISTANCE_METRIC', 'L2', 't', 'TEXT').ok()
+
+    p = conn.pipeline(transaction=False)
+    for i in range(1, index_size+1):
+        vector = np.full(dim, i, dtype='float32')
+        p.execute_command('HSET', i, 'v', vector.tobytes(), 't', 'hybrid')
+    p.execute()
+    query_data = np.full(dim, index_size, dtype='float32')
+
+    # The id list and the optional node can both test ids directly, so batches are filtered
+    # by the child's criteria tester instead of being intersected with it.
+    inkeys = [i for i in range(1, index_size+1) if i % 37 == 0]
+    def search(policy):
+        return conn.execute_command('FT.SEARCH', 'idx', '(~dummy)=>[KNN 10 @v $vec_param HYBRID_POLICY %s]' % policy,
+                                    'INKEYS', len(inkeys), *inkeys, 'SORTBY', '__v_score',
+                                    'RETURN', 1, '__v_score', 'PARAMS', 2, 'vec_param', query_data.tobytes())
+
+    res = search('BATCHES')
+    if not env.isCluster():
+        env.assertEqual(to_dict(env.cmd("FT.DEBUG", "VECSIM_INFO", "idx", "v"))['LAST_SEARCH_MODE'],
+                        'HYBRID_BATCHES_FILTERED')
+    expected_ids = [str(i) for i in sorted(inkeys, reverse=True)[:10]]
+    env.assertEqual(res[0], 10)
+    env.assertEqual(res[1::2], expected_ids)
+    env.assertEqual(res, search('ADHOC_BF'))
+
+    # Fewer matching ids than k
+    inkeys = [1, 500, 999]
+    res = search('BATCHES')
+    env.assertEqual(res[1::2], ['999', '500', '1'])
+    env.assertEqual(res, search('ADHOC_BF'))
+
+
 def test_hybrid_query_change_policy():
     env = Env(moduleArgs='DEFAULT_DIALECT 2')
     conn = getConnectionByEnv(env)
@@ -1639,3 +1678,125 @@ def test_bad_index_multi_value_json():
     conn.json().set(46, '.', {'vecs': [np.ones(dim).tolist(), vec]})
     failures += 1
     env.assertEqual(conn.ft('idx').info()['hash_indexing_failures'], info_type(failures))
+
+
+def test_range_query():
+    env = Env(moduleArgs='DEFAULT_DIALECT 2')
+    conn = getConnectionByEnv(env)
+    dim = 2
+    n = 100
+
+    for data_type in VECSIM_DATA_TYPES:
+        env.expect('FT.CREATE', 'idx', 'SCHEMA', 'v', 'VECTOR', 'FLAT', '6', 'TYPE', data_type,
+                   'DIM', dim, 'DISTANCE_METRIC', 'L2', 'num', 'NUMERIC').ok()
+        for i in range(1, n+1):
+            conn.execute_command('HSET', i, 'v', create_np_array_typed([i]*dim, data_type).tobytes(), 'num', i)
+        query_data = create_np_array_typed([0]*dim, data_type).tobytes()
+
+        def ids(query, *args):
+            res = env.cmd('FT.SEARCH', 'idx', query, 'NOCONTENT', 'LIMIT', 0, n, 'PARAMS', 4,
+                          'vec_param', query_data, 'r', 51, *args)
+            return sorted(int(d) for d in res[1:])
+
+        # The squared L2 distance of doc i from the origin is 2*i^2
+        env.assertEqual(ids('@v:[VECTOR_RANGE 51 $vec_param]'), [1, 2, 3, 4, 5])
+        env.assertEqual(ids('@v:[VECTOR_RANGE $r $vec_param]'), [1, 2, 3, 4, 5])
+        env.assertEqual(ids('@v:[VECTOR_RANGE 0.5 $vec_param]'), [])
+
+        # Range queries compose with other filters
+        env.assertEqual(ids('@v:[VECTOR_RANGE 51 $vec_param] @num:[3 10]'), [3, 4, 5])
+        env.assertEqual(ids('@v:[VECTOR_RANGE 3 $vec_param] | @num:[99 100]'), [1, 99, 100])
+        env.assertEqual(ids('@v:[VECTOR_RANGE 51 $vec_param] -@num:[2 4]'), [1, 5])
+
+        # The distance is returned only when asked for
+        res = env.cmd('FT.SEARCH', 'idx', '@v:[VECTOR_RANGE 20 $vec_param]=>{$YIELD_DISTANCE_AS: dist}',
+                      'SORTBY', 'dist', 'RETURN', 1, 'dist', 'PARAMS', 4, 'vec_param', query_data, 'r', 51)
+        env.assertEqual(res, [3, '1', ['dist', '2'], '2', ['dist', '8'], '3', ['dist', '18']])
+
+        env.expect('FT.SEARCH', 'idx', '@v:[VECTOR_RANGE 20 $vec_param]=>{$YIELD_DISTANCE_AS: d1}=>[KNN 3 @v $vec_param]',
+                   'PARAMS', 2, 'vec_param', query_data).error().contains('Only one vector distance field')
+        env.expect('FT.SEARCH', 'idx', '@v:[VECTOR_RANGEX 20 $vec_param]',
+                   'PARAMS', 2, 'vec_param', query_data).error().contains('Expecting Vector Similarity command')
+
+        conn.execute_command('FT.DROPINDEX', 'idx', 'DD')
+
+
+def test_fusion():
+    env = Env(moduleArgs='DEFAULT_DIALECT 2')
+    conn = getConnectionByEnv(env)
+    dim = 2
+    n = 20
+
+    env.expect('FT.CREATE', 'idx', 'SCHEMA', 'v', 'VECTOR', 'FLAT', '6', 'TYPE', 'FLOAT32',
+               'DIM', dim, 'DISTANCE_METRIC', 'L2', 't', 'TEXT').ok()
+    # The documents share a hash slot, so in a cluster they are all fused by the same shard
+    for i in range(1, n+1):
+        conn.execute_command('HSET', '{fuse}%d' % i, 'v', create_np_array_typed([i]*dim).tobytes(),
+                             't', 'hello' if i % 5 == 0 else 'world')
+    query_data = create_np_array_typed([0]*dim).tobytes()
+
+    def search(*args):
+        res = env.cmd('FT.SEARCH', 'idx', '(hello)=>[KNN 3 @v $vec_param]', 'NOCONTENT', *args,
+                      'PARAMS', 2, 'vec_param', query_data)
+        return res[:1] + [d[len('{fuse}'):] for d in res[1:]]
+
+    # With fusion the text results and the nearest neighbors are returned together
+    env.assertEqual(search()[0], 3)
+    res = search('FUSE', 'RRF', 'LIMIT', 0, n)
+    env.assertEqual(res[0], 7)
+    env.assertEqual(sorted(int(d) for d in res[1:]), [1, 2, 3, 5, 10, 15, 20])
+
+    # The weight moves the ranking between the vector and the text results
+    env.assertEqual(search('FUSE', 'RRF', 'WEIGHT', 0)[1:4], ['1', '2', '3'])
+    env.assertEqual(search('FUSE', 'LINEAR', 'WEIGHT', 0)[1:4], ['1', '2', '3'])
+    env.assertEqual(sorted(search('FUSE', 'LINEAR', 'WEIGHT', 1)[1:5]), ['10', '15', '20', '5'])
+
+    # Results outside of both windows are dropped
+    res = search('FUSE', 'RRF', 'WINDOW', 2)
+    env.assertEqual(res[0], 4)
+    env.assertEqual(len(res), 5)
+
+    env.expect('FT.SEARCH', 'idx', 'hello', 'FUSE', 'RRF').error().contains('FUSE requires a KNN vector query')
+    env.expect('FT.SEARCH', 'idx', '(hello)=>[KNN 3 @v $vec_param]', 'FUSE', 'RRF', 'SORTBY', '__v_score',
+               'PARAMS', 2, 'vec_param', query_data).error().contains('FUSE cannot be combined with SORTBY')
+    env.expect('FT.SEARCH', 'idx', 'hello', 'FUSE', 'MAX').error().contains('FUSE method must be RRF or LINEAR')
+    env.expect('FT.SEARCH', 'idx', 'hello', 'FUSE', 'RRF', 'WEIGHT', 2).error().contains('FUSE WEIGHT must be between 0 and 1')
+    env.expect('FT.AGGREGATE', 'idx', 'hello', 'FUSE', 'RRF').error().contains('FUSE is not supported on FT.AGGREGATE')
+
+
+def test_fusion_cluster():
+    env = Env(moduleArgs='DEFAULT_DIALECT 2')
+    SkipOnNonCluster(env)
+    conn = getConnectionByEnv(env)
+    dim = 2
+    n = 60
+
+    env.expect('FT.CREATE', 'idx', 'SCHEMA', 'v', 'VECTOR', 'FLAT', '6', 'TYPE', 'FLOAT32',
+               'DIM', dim, 'DISTANCE_METRIC', 'L2', 't', 'TEXT').ok()
+    for i in range(1, n+1):
+        conn.execute_command('HSET', i, 'v', create_np_array_typed([i]*dim).tobytes(),
+                             't', 'hello' if i % 5 == 0 else 'world')
+    query_data = create_np_array_typed([0]*dim).tobytes()
+    text_ids = set(str(i) for i in range(5, n+1, 5))
+
+    # Without fusion the coordinator keeps the k nearest neighbors of all the shards
+    res = env.cmd('FT.SEARCH', 'idx', '(hello)=>[KNN 3 @v $vec_param]', 'NOCONTENT', 'LIMIT', 0, n,
+                  'PARAMS', 2, 'vec_param', query_data)
+    env.assertEqual(res[0], 3)
+
+    # With fusion the text results are kept alongside the nearest neighbors of every shard, and
+    # the shards' results are merged by their fused score
+    for method in ['RRF', 'LINEAR']:
+        res = env.cmd('FT.SEARCH', 'idx', '(hello)=>[KNN 3 @v $vec_param]', 'FUSE', method,
+                      'WITHSCORES', 'NOCONTENT', 'LIMIT', 0, n, 'PARAMS', 2, 'vec_param', query_data)
+        ids, scores = res[1::2], [float(s) for s in res[2::2]]
+        env.assertEqual(res[0], len(ids))
+        env.assertGreaterEqual(len(ids), len(text_ids) + 3)
+        env.assertTrue(text_ids.issubset(ids), message=method)
+        env.assertTrue('1' in ids, message=method)
+        env.assertEqual(scores, sorted(scores, reverse=True), message=method)
+
+    # The limit is applied after the merge
+    res = env.cmd('FT.SEARCH', 'idx', '(hello)=>[KNN 3 @v $vec_param]', 'FUSE', 'RRF',
+                  'WITHSCORES', 'NOCONTENT', 'LIMIT', 0, 5, 'PARAMS', 2, 'vec_param', query_data)
+    env.assertEqual(len(res[1::2]), 5)